@@ -217,6 +217,7 @@ def main(root, defines, files, ver):
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <pthread.h>
 
 #include "wrapper.h"
 #include "emu/x86emu_private.h"
@@ -317,6 +318,9 @@ typedef void (*wrapper_t)(x86emu_t* emu, uintptr_t fnc);
 	}
 	files_guards = {"wrapper.c": """""",
 		"wrapper.h": """
+// get the signature of a wrapper (like "iFpi"), NULL if not found
+const char* GetWrapperSignature(wrapper_t w);
+
 #endif //__WRAPPER_H_
 """
 	}
@@ -487,6 +491,26 @@ typedef void (*wrapper_t)(x86emu_t* emu, uintptr_t fnc);
 				function_writer(file, v[0], v[1] + "_t", v[0][0], v[0][2:])
 			file.write("#endif\n")
 		
+		# Last part: signature of the wrappers, for the dynarec
+		file.write("\ntypedef struct wrappersig_s {\n\twrapper_t\tw;\n\tconst char*\tsig;\n} wrappersig_t;\n\n")
+		file.write("static wrappersig_t wrappersigs[] = {\n")
+		for v in gbl["()"]:
+			file.write("\t{" + v + ", \"" + v + "\"},\n")
+		for k in gbl_idxs:
+			file.write("#if " + k + "\n")
+			for v in gbl[k]:
+				file.write("\t{" + v + ", \"" + v + "\"},\n")
+			file.write("#endif\n")
+		for v in redirects["()"]:
+			file.write("\t{" + v[0] + ", \"" + v[0] + "\"},\n")
+		for k in redirects_idxs:
+			file.write("#if " + k + "\n")
+			for v in redirects[k]:
+				file.write("\t{" + v[0] + ", \"" + v[0] + "\"},\n")
+			file.write("#endif\n")
+		file.write("\t{NULL, NULL}\n};\n\n")
+		file.write("static int wrappersigs_sz = 0;\nstatic pthread_once_t wrappersigs_once = PTHREAD_ONCE_INIT;\n\nstatic int cmpWrapperSig(const void* a, const void* b)\n{\n\tuintptr_t wa = (uintptr_t)((const wrappersig_t*)a)->w;\n\tuintptr_t wb = (uintptr_t)((const wrappersig_t*)b)->w;\n\treturn (wa<wb)?-1:((wa>wb)?1:0);\n}\n\n// the addresses of the wrappers are only known at runtime, so the table is sorted on first use\nstatic void sortWrapperSigs()\n{\n\tint n = 0;\n\twhile(wrappersigs[n].w)\n\t\t++n;\n\tqsort(wrappersigs, n, sizeof(wrappersig_t), cmpWrapperSig);\n\twrappersigs_sz = n;\n}\n\nconst char* GetWrapperSignature(wrapper_t w)\n{\n\tpthread_once(&wrappersigs_once, sortWrapperSigs);\n\twrappersig_t key = {w, NULL};\n\tconst wrappersig_t* r = (const wrappersig_t*)bsearch(&key, wrappersigs, wrappersigs_sz, sizeof(wrappersig_t), cmpWrapperSig);\n\treturn r?r->sig:NULL;\n}\n")
+		
 		file.write(files_guards["wrapper.c"])
 	
 	# Save the string for the next iteration, writing was successful
@@ -500,6 +524,6 @@ if __name__ == '__main__':
 	for i, v in enumerate(sys.argv):
 		if v == "--":
 			limit.append(i)
-	if main(sys.argv[1], sys.argv[2:limit[0]], sys.argv[limit[0]+1:], "1.2.0.09") != 0:
+	if main(sys.argv[1], sys.argv[2:limit[0]], sys.argv[limit[0]+1:], "1.2.0.10") != 0:
 		exit(2)
 	exit(0)
@@ -14,6 +14,10 @@ endif( NOT TEST_REFERENCE )
 
 set(ENV{BOX86_LOG} 0)
 set(ENV{BOX86_NOBANNER} 1)
+if( DEFINED TEST_DYNAREC )
+  # 0 runs the test on the interpreter of a dynarec build
+  set(ENV{BOX86_DYNAREC} ${TEST_DYNAREC})
+endif( DEFINED TEST_DYNAREC )
 if( EXISTS ${CMAKE_SOURCE_DIR}/x86lib )
   # we are inside box86 folder
   set(ENV{LD_LIBRARY_PATH} ${CMAKE_SOURCE_DIR}/x86lib)
@@ -10,6 +10,7 @@
 #include "debug.h"
 #include "x86trace.h"
 #include "x86emu.h"
+#include "x86run.h"
 #include "librarian.h"
 #include "bridge.h"
 #include "library.h"
@@ -22,6 +23,15 @@
 #ifdef DYNAREC
 #include <sys/mman.h>
 #include "dynablock.h"
+#include "dynarec.h"
+#include "dynaasync.h"
+#include "dynaevict.h"
+#include "dynathunk.h"
+#include "dynaperf.h"
+#include "dynarec_arm.h"
+#ifdef ARM
+#include "dynarec/arm_lock_helper.h"
+#endif
 
 #define MMAPSIZE (4*1024*1024)      // allocate 4Mo sized blocks
 #define MMAPBLOCK   256             // minimum size of a block
@@ -29,46 +39,251 @@
 
 typedef struct mmaplist_s {
     void*         block;
-    uint8_t       map[MMAPSIZE/(8*MMAPBLOCK)];  // map of allocated sub-block
 } mmaplist_t;
 
-// get first subblock free in map, stating at start. return -1 if no block, else first subblock free, filling size (in subblock unit)
-static int getFirstBlock(mmaplist_t *map, int start, int maxsize, int* size)
-{
-    #define ISFREE(A) (((map->map[(A)>>3]>>((A)&7))&1)?0:1)
-    if(start<0) start = 0;
-    while(start<MMAPSIZE/(8*MMAPBLOCK)) {   // still a chance...
-        if(ISFREE(start)) {
-            // free, now get size...
-            int end = start+1;
-            while(end<MMAPSIZE/(8*MMAPBLOCK)) {
-                if(!ISFREE(end) || (end-start==maxsize)) {
-                    if(size) *size = end-start;
-                    return start;
-                }
-                ++end;
+// Index of the native memory used by the dynarec, sorted by address, to find the dynablock owning a native PC.
+// It's never modified once published (a new copy is made on change), so it can be read from a signal handler without lock.
+typedef struct nativechunk_s {
+    uintptr_t       start;
+    uintptr_t       end;
+    dynablock_t**   owner;      // owner of each MMAPBLOCK sub-block (only 1 entry for big blocks)
+} nativechunk_t;
+
+typedef struct nativeindex_s {
+    struct nativeindex_s* old;  // previous version, freed only at exit
+    int             size;
+    nativechunk_t   chunks[0];
+} nativeindex_t;
+
+// add a chunk to the native index, mutex_mmap must be locked
+static void addNativeChunk(uintptr_t start, uintptr_t size)
+{
+    nativeindex_t* cur = my_context->nativeindex;
+    int n = cur?cur->size:0;
+    nativeindex_t* idx = (nativeindex_t*)malloc(sizeof(nativeindex_t)+(n+1)*sizeof(nativechunk_t));
+    idx->old = cur;
+    idx->size = n+1;
+    int j = 0;
+    while(j<n && cur->chunks[j].start<start) {
+        idx->chunks[j] = cur->chunks[j];
+        ++j;
+    }
+    idx->chunks[j].start = start;
+    idx->chunks[j].end = start+size;
+    idx->chunks[j].owner = (dynablock_t**)calloc((size>MMAPSIZE)?1:(size/MMAPBLOCK), sizeof(dynablock_t*));
+    for(; j<n; ++j)
+        idx->chunks[j+1] = cur->chunks[j];
+    __sync_synchronize();
+    my_context->nativeindex = idx;
+}
+
+// remove a (big block) chunk from the native index, mutex_mmap must be locked
+static void removeNativeChunk(uintptr_t start)
+{
+    nativeindex_t* cur = my_context->nativeindex;
+    if(!cur)
+        return;
+    nativeindex_t* idx = (nativeindex_t*)malloc(sizeof(nativeindex_t)+cur->size*sizeof(nativechunk_t));
+    idx->old = cur;
+    idx->size = 0;
+    for(int j=0; j<cur->size; ++j)
+        if(cur->chunks[j].start!=start)
+            idx->chunks[idx->size++] = cur->chunks[j];
+        // owner array is left to the old index, a reader may still use it
+    __sync_synchronize();
+    my_context->nativeindex = idx;
+}
+
+static nativechunk_t* findNativeChunk(nativeindex_t* idx, uintptr_t addr)
+{
+    if(!idx)
+        return NULL;
+    int lo = 0, hi = idx->size;
+    while(lo<hi) {
+        int mid = (lo+hi)/2;
+        if(addr<idx->chunks[mid].start)
+            hi = mid;
+        else if(addr>=idx->chunks[mid].end)
+            lo = mid+1;
+        else
+            return &idx->chunks[mid];
+    }
+    return NULL;
+}
+
+static void freeNativeIndex(nativeindex_t* idx)
+{
+    // owner arrays are shared between versions, collect them from the newest one and the removed chunks
+    while(idx) {
+        nativeindex_t* old = idx->old;
+        for(int j=0; j<idx->size; ++j)
+            if(idx->chunks[j].owner) {
+                dynablock_t** owner = idx->chunks[j].owner;
+                // clear all the references in older versions so it's freed only once
+                for(nativeindex_t* o = old; o; o=o->old)
+                    for(int k=0; k<o->size; ++k)
+                        if(o->chunks[k].owner==owner)
+                            o->chunks[k].owner = NULL;
+                free(owner);
             }
-            if(size) *size = end-start;
-            return start;
-        }
-        ++start;
+        free(idx);
+        idx = old;
     }
-    return -1;
 }
 
-static void allocBlock(mmaplist_t *map, int start, int size)
+void setDynarecMapOwner(uintptr_t addr, uint32_t size, dynablock_t* db)
 {
-    for(int i=0; i<size; ++i) {
-        map->map[start/8]|=(1<<(start&7));
-        ++start;
+    nativechunk_t* chunk = findNativeChunk(my_context->nativeindex, addr);
+    if(!chunk)
+        return;
+    if(chunk->end-chunk->start>MMAPSIZE) {
+        chunk->owner[0] = db;
+        return;
     }
+    int start = (addr-chunk->start)/MMAPBLOCK;
+    int bsize = (size+MMAPBLOCK-1)/MMAPBLOCK;
+    for(int i=0; i<bsize; ++i)
+        chunk->owner[start+i] = db;
+}
+
+dynablock_t* getDynarecMapOwner(uintptr_t addr)
+{
+    nativechunk_t* chunk = findNativeChunk(my_context->nativeindex, addr);
+    if(!chunk)
+        return NULL;
+    if(chunk->end-chunk->start>MMAPSIZE)
+        return chunk->owner[0];
+    return chunk->owner[(addr-chunk->start)/MMAPBLOCK];
 }
-static void freeBlock(mmaplist_t *map, int start, int size)
+
+// Dynarec blocks are allocated from per-thread bump regions, carved in the 4Mo chunks.
+// Freed blocks go in size class free lists (lock-free stacks, the memory of the block itself is used for the link),
+// and are split when a bigger one is used. Blocks are never merged back, fragmentation can be seen with BOX86_DYNAREC_STATS
+#define MMAPREGION  (64*1024)       // size of the per-thread bump region
+#define MMAPSMALL   16              // size classes with exact size (in MMAPBLOCK unit)
+#define MMAPCLASSES (MMAPSMALL+11)  // then one class per power of 2, up to MMAPSIZE
+
+typedef struct freeblock_s {
+    struct freeblock_s* next;
+    uint32_t            size;       // in MMAPBLOCK unit
+} freeblock_t;
+
+typedef struct bumpregion_s {
+    uintptr_t   cur;
+    uintptr_t   end;
+    int         gen;                // generation of the allocator, the region is invalid if it changed
+} bumpregion_t;
+
+static freeblock_t*     mmapfree[MMAPCLASSES];
+static uintptr_t        mmapcur = 0, mmapend = 0;  // what is left of the last chunk (mutex_mmap)
+static int              mmapgen = 0;
+static pthread_key_t    mmapregion_key;
+static pthread_once_t   mmapregion_once = PTHREAD_ONCE_INIT;
+// stats
+static uint32_t         mmapstat_used = 0;      // in MMAPBLOCK unit
+static uint32_t         mmapstat_free = 0;      // in MMAPBLOCK unit, in the free lists
+static uint32_t         mmapstat_classes[MMAPCLASSES];
+static uint32_t         mmapstat_alloc = 0, mmapstat_freed = 0, mmapstat_split = 0;
+static uint32_t         mmapstat_big = 0, mmapstat_bigsize = 0;
+
+static int getClass(uint32_t size)
+{
+    if(size<=MMAPSMALL)
+        return size-1;
+    return MMAPSMALL + (31-__builtin_clz(size)) - 4;   // 16..31 => MMAPSMALL, 32..63 => MMAPSMALL+1...
+}
+
+static void pushFree(uintptr_t addr, uint32_t size)
 {
-    for(int i=0; i<size; ++i) {
-        map->map[start/8]&=~(1<<(start&7));
-        ++start;
+    if(!size)
+        return;
+    int c = getClass(size);
+    freeblock_t* b = (freeblock_t*)addr;
+    b->size = size;
+    do {
+        b->next = mmapfree[c];
+    } while(arm_lock_read_d(&mmapfree[c])!=(uintptr_t)b->next || arm_lock_write_d(&mmapfree[c], (uintptr_t)b));
+    __sync_fetch_and_add(&mmapstat_free, size);
+    __sync_fetch_and_add(&mmapstat_classes[c], 1);
+}
+
+static freeblock_t* popFree(int c)
+{
+    freeblock_t* b;
+    do {
+        b = (freeblock_t*)arm_lock_read_d(&mmapfree[c]);
+        if(!b)
+            return NULL;
+    } while(arm_lock_write_d(&mmapfree[c], (uintptr_t)b->next));
+    __sync_fetch_and_sub(&mmapstat_free, b->size);
+    __sync_fetch_and_sub(&mmapstat_classes[c], 1);
+    return b;
+}
+
+// get a free block of at least size from the free lists, splitting it if needed
+static uintptr_t getFree(uint32_t size)
+{
+    // start with the first class where all blocks are big enough
+    int c = getClass(size);
+    if(size>MMAPSMALL && (size&(size-1)))
+        ++c;
+    for(; c<MMAPCLASSES; ++c) {
+        freeblock_t* b = popFree(c);
+        if(b) {
+            if(b->size>size) {
+                pushFree((uintptr_t)b+size*MMAPBLOCK, b->size-size);
+                __sync_fetch_and_add(&mmapstat_split, 1);
+            }
+            return (uintptr_t)b;
+        }
     }
+    return 0;
+}
+
+// carve size bytes from the chunks, creating a new one if needed. mutex_mmap must be locked
+static uintptr_t carveChunk(uint32_t size)
+{
+    if(mmapcur+size>mmapend) {
+        int i = my_context->mmapsize;
+        dynarec_log(LOG_DEBUG, "Ask for DynaRec Block Alloc #%d\n", i+1);
+        #ifdef USE_MMAP
+        void* p = mmap(NULL, MMAPSIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(p==MAP_FAILED) {
+            dynarec_log(LOG_INFO, "Cannot create memory map of %d byte for dynarec block #%d\n", MMAPSIZE, i);
+            return 0;
+        }
+        #else
+        void *p = NULL;
+        if(posix_memalign(&p, box86_pagesize, MMAPSIZE)) {
+            dynarec_log(LOG_INFO, "Cannot create memory map of %d byte for dynarec block #%d\n", MMAPSIZE, i);
+            return 0;
+        }
+        mprotect(p, MMAPSIZE, PROT_READ | PROT_WRITE | PROT_EXEC);
+        #endif
+        my_context->mmaplist = (mmaplist_t*)realloc(my_context->mmaplist, (i+1)*sizeof(mmaplist_t));
+        my_context->mmaplist[i].block = p;
+        my_context->mmapsize = i+1;
+        addNativeChunk((uintptr_t)p, MMAPSIZE);
+        // what's left of the previous chunk is not lost
+        pushFree(mmapcur, (mmapend-mmapcur)/MMAPBLOCK);
+        mmapcur = (uintptr_t)p;
+        mmapend = mmapcur + MMAPSIZE;
+    }
+    uintptr_t ret = mmapcur;
+    mmapcur += size;
+    return ret;
+}
+
+static void freeRegion(void* p)
+{
+    bumpregion_t* r = (bumpregion_t*)p;
+    if(my_context && r->gen==mmapgen)
+        pushFree(r->cur, (r->end-r->cur)/MMAPBLOCK);
+    free(r);
+}
+static void allocRegionKey()
+{
+    pthread_key_create(&mmapregion_key, freeRegion);
 }
 
 uintptr_t AllocDynarecMap(int size, int nolinker)
@@ -88,76 +303,113 @@ uintptr_t AllocDynarecMap(int size, int nolinker)
         }
         mprotect(p, size, PROT_READ | PROT_WRITE | PROT_EXEC);
         #endif
+        pthread_mutex_lock(&my_context->mutex_mmap);
+        addNativeChunk((uintptr_t)p, size);
+        pthread_mutex_unlock(&my_context->mutex_mmap);
+        __sync_fetch_and_add(&mmapstat_big, 1);
+        __sync_fetch_and_add(&mmapstat_bigsize, size);
         return (uintptr_t)p;
     }
-    pthread_mutex_lock(&my_context->mutex_mmap);
-    int bsize = (size+MMAPBLOCK-1)/MMAPBLOCK;
-    // look for free space
-    for(int i=0; i<my_context->mmapsize; ++i) {
-        int rsize = 0;
-        int start = 0;
-        do {
-            start = getFirstBlock(my_context->mmaplist+i, start, bsize, &rsize);
-            if(start!=-1 && rsize>=bsize) {
-                allocBlock(my_context->mmaplist+i, start, bsize);
-                uintptr_t ret = (uintptr_t)my_context->mmaplist[i].block + start*MMAPBLOCK;
-                pthread_mutex_unlock(&my_context->mutex_mmap);
-                return ret;
-            }
-            if(start!=-1)
-                start += rsize;
-        } while (start!=-1);
-    }
-    // no luck, add a new one !
-    int i = my_context->mmapsize++;    // yeah, useful post incrementation
-    dynarec_log(LOG_DEBUG, "Ask for DynaRec Block Alloc #%d\n", my_context->mmapsize);
-    my_context->mmaplist = (mmaplist_t*)realloc(my_context->mmaplist, my_context->mmapsize*sizeof(mmaplist_t));
-    #ifdef USE_MMAP
-    void* p = mmap(NULL, MMAPSIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if(p==MAP_FAILED) {
-        dynarec_log(LOG_INFO, "Cannot create memory map of %d byte for dynarec block #%d\n", MMAPSIZE, i);
-        --my_context->mmapsize;
+    uint32_t bsize = (size+MMAPBLOCK-1)/MMAPBLOCK;
+    __sync_fetch_and_add(&mmapstat_alloc, 1);
+    __sync_fetch_and_add(&mmapstat_used, bsize);
+    // first, reuse a freed block
+    uintptr_t ret = getFree(bsize);
+    if(ret)
+        return ret;
+    size = bsize*MMAPBLOCK;
+    // big ones are carved directly from the chunks
+    if(size>MMAPREGION/4) {
+        pthread_mutex_lock(&my_context->mutex_mmap);
+        ret = carveChunk(size);
         pthread_mutex_unlock(&my_context->mutex_mmap);
-        return 0;
+    } else {
+        // then the bump region of the thread
+        pthread_once(&mmapregion_once, allocRegionKey);
+        bumpregion_t* r = (bumpregion_t*)pthread_getspecific(mmapregion_key);
+        if(!r) {
+            r = (bumpregion_t*)calloc(1, sizeof(bumpregion_t));
+            pthread_setspecific(mmapregion_key, r);
+        }
+        if(r->gen!=mmapgen)
+            r->cur = r->end = 0;
+        if(r->cur+size>r->end) {
+            pthread_mutex_lock(&my_context->mutex_mmap);
+            uintptr_t p = carveChunk(MMAPREGION);
+            pthread_mutex_unlock(&my_context->mutex_mmap);
+            if(p) {
+                pushFree(r->cur, (r->end-r->cur)/MMAPBLOCK);
+                r->cur = p;
+                r->end = p+MMAPREGION;
+                r->gen = mmapgen;
+            }
+        }
+        if(r->cur+size<=r->end) {
+            ret = r->cur;
+            r->cur += size;
+        }
     }
-    #else
-    void *p = NULL;
-    if(posix_memalign(&p, box86_pagesize, MMAPSIZE)) {
-        dynarec_log(LOG_INFO, "Cannot create memory map of %d byte for dynarec block #%d\n", MMAPSIZE, i);
-        --my_context->mmapsize;
-        pthread_mutex_unlock(&my_context->mutex_mmap);
-        return 0;
+    if(!ret) {
+        __sync_fetch_and_sub(&mmapstat_alloc, 1);
+        __sync_fetch_and_sub(&mmapstat_used, bsize);
     }
-    mprotect(p, MMAPSIZE, PROT_READ | PROT_WRITE | PROT_EXEC);
-    #endif
-    my_context->mmaplist[i].block = p;
-    memset(my_context->mmaplist[i].map, 0, sizeof(my_context->mmaplist[i].map));
-    allocBlock(my_context->mmaplist+i, 0, bsize);
-    pthread_mutex_unlock(&my_context->mutex_mmap);
-    return (uintptr_t)p;
+    return ret;
 }
 
 void FreeDynarecMap(uintptr_t addr, uint32_t size)
 {
     if(size>MMAPSIZE) {
+        pthread_mutex_lock(&my_context->mutex_mmap);
+        removeNativeChunk(addr);
+        pthread_mutex_unlock(&my_context->mutex_mmap);
+        #ifdef USE_MMAP
         munmap((void*)addr, size);
+        #else
+        free((void*)addr);
+        #endif
+        __sync_fetch_and_sub(&mmapstat_big, 1);
+        __sync_fetch_and_sub(&mmapstat_bigsize, size);
         return;
     }
-    pthread_mutex_lock(&my_context->mutex_mmap);
-    int bsize = (size+MMAPBLOCK-1)/MMAPBLOCK;
-    // look for free space
-    for(int i=0; i<my_context->mmapsize; ++i) {
-        if(addr>=(uintptr_t)my_context->mmaplist[i].block && ((uintptr_t)my_context->mmaplist[i].block+MMAPSIZE)>=addr+size) {
-            int start = (addr - (uintptr_t)my_context->mmaplist[i].block) / MMAPBLOCK;
-            freeBlock(my_context->mmaplist+i, start, bsize);
-            pthread_mutex_unlock(&my_context->mutex_mmap);
-            return;
+    if(!addr)
+        return;
+    uint32_t bsize = (size+MMAPBLOCK-1)/MMAPBLOCK;
+    __sync_fetch_and_add(&mmapstat_freed, 1);
+    __sync_fetch_and_sub(&mmapstat_used, bsize);
+    pushFree(addr, bsize);
+}
+
+void PrintDynarecMapStats()
+{
+    uint32_t total = my_context->mmapsize*(MMAPSIZE/MMAPBLOCK);
+    uint32_t used = mmapstat_used;
+    uint32_t freed = mmapstat_free;
+    printf_log(LOG_NONE, "Dynarec memory: %d chunk(s) of %dKB, %uKB used by blocks, %uKB in free lists (%u%% fragmentation), %uKB not used yet\n",
+        my_context->mmapsize, MMAPSIZE/1024, used*MMAPBLOCK/1024, freed*MMAPBLOCK/1024, (used+freed)?(freed*100/(used+freed)):0,
+        (total>used+freed)?((total-used-freed)*MMAPBLOCK/1024):0);
+    printf_log(LOG_NONE, "Dynarec memory: %u allocations, %u frees, %u splits, %u big block(s) of %uKB\n", mmapstat_alloc, mmapstat_freed, mmapstat_split, mmapstat_big, mmapstat_bigsize/1024);
+    printf_log(LOG_NONE, "Dynarec memory: free blocks by size class:");
+    for(int i=0; i<MMAPCLASSES; ++i)
+        if(mmapstat_classes[i]) {
+            if(i<MMAPSMALL)
+                printf_log(LOG_NONE, " %d:%u", (i+1)*MMAPBLOCK, mmapstat_classes[i]);
+            else
+                printf_log(LOG_NONE, " %d+:%u", (1<<(i-MMAPSMALL+4))*MMAPBLOCK, mmapstat_classes[i]);
         }
-    }
-    pthread_mutex_unlock(&my_context->mutex_mmap);
+    printf_log(LOG_NONE, "\n");
+}
+
+// reset the allocator, when all the chunks are freed
+static void resetDynarecMap()
+{
+    memset(mmapfree, 0, sizeof(mmapfree));
+    memset(mmapstat_classes, 0, sizeof(mmapstat_classes));
+    mmapcur = mmapend = 0;
+    mmapstat_used = mmapstat_free = mmapstat_alloc = mmapstat_freed = mmapstat_split = 0;
+    ++mmapgen;
 }
 
-// each dynmap is 64k of size
+// each dynmap is 4k of size
 
 void addDBFromAddressRange(box86context_t* context, uintptr_t addr, uintptr_t size, int nolinker)
 {
@@ -165,9 +417,18 @@ void addDBFromAddressRange(box86context_t* context, uintptr_t addr, uintptr_t si
     uintptr_t idx = (addr>>DYNAMAP_SHIFT);
     uintptr_t end = ((addr+size-1)>>DYNAMAP_SHIFT);
     for (uintptr_t i=idx; i<=end; ++i) {
-        if(!context->dynmap[i]) {
-            context->dynmap[i] = (dynmap_t*)calloc(1, sizeof(dynmap_t));
-            context->dynmap[i]->dynablocks = NewDynablockList(i<<DYNAMAP_SHIFT, i<<DYNAMAP_SHIFT, 1<<DYNAMAP_SHIFT, nolinker, 0);
+        dynmap_t** table = context->dynmap[i>>DYNAMAP_L2SHIFT];
+        if(!table) {
+            // tables are never freed (until exit), so getDynmap can be used without lock
+            dynmap_t** newtable = (dynmap_t**)calloc(DYNAMAP_L2SIZE, sizeof(dynmap_t*));
+            table = (dynmap_t**)arm_lock_storeifnull(&context->dynmap[i>>DYNAMAP_L2SHIFT], newtable);
+            if(table!=newtable)
+                free(newtable);
+        }
+        if(!table[i&(DYNAMAP_L2SIZE-1)]) {
+            dynmap_t* dynmap = (dynmap_t*)calloc(1, sizeof(dynmap_t));
+            dynmap->dynablocks = NewDynablockList(i<<DYNAMAP_SHIFT, i<<DYNAMAP_SHIFT, 1<<DYNAMAP_SHIFT, nolinker, 0);
+            table[i&(DYNAMAP_L2SIZE-1)] = dynmap;
         }
     }
 }
@@ -175,10 +436,16 @@ void addDBFromAddressRange(box86context_t* context, uintptr_t addr, uintptr_t si
 void cleanDBFromAddressRange(box86context_t* context, uintptr_t addr, uintptr_t size, int destroy)
 {
     dynarec_log(LOG_DEBUG, "cleanDBFromAddressRange %p -> %p %s\n", (void*)addr, (void*)(addr+size-1), destroy?"destroy":"mark");
-    uintptr_t idx = (addr>box86_dynarec_largest && !destroy)?((addr-box86_dynarec_largest)>>DYNAMAP_SHIFT):(addr>>DYNAMAP_SHIFT);
+    uintptr_t idx = (addr>box86_dynarec_largest)?((addr-box86_dynarec_largest)>>DYNAMAP_SHIFT):(addr>>DYNAMAP_SHIFT);
     uintptr_t end = ((addr+size-1)>>DYNAMAP_SHIFT);
     for (uintptr_t i=idx; i<=end; ++i) {
-        dynmap_t* dynmap = context->dynmap[i];
+        dynmap_t** table = context->dynmap[i>>DYNAMAP_L2SHIFT];
+        if(!table) {
+            // skip the whole empty table
+            i |= DYNAMAP_L2SIZE-1;
+            continue;
+        }
+        dynmap_t* dynmap = table[i&(DYNAMAP_L2SIZE-1)];
         if(dynmap) {
             uintptr_t startdb = StartDynablockList(dynmap->dynablocks);
             uintptr_t enddb = EndDynablockList(dynmap->dynablocks);
@@ -188,14 +455,14 @@ void cleanDBFromAddressRange(box86context_t* context, uintptr_t addr, uintptr_t
             if(endaddr>enddb) endaddr = enddb;
             if(startaddr==startdb && endaddr==enddb) {
                 if(destroy) {
-                    context->dynmap[i] = NULL;
+                    table[i&(DYNAMAP_L2SIZE-1)] = NULL;
                     FreeDynablockList(&dynmap->dynablocks);
                     free(dynmap);
                 } else
                     MarkDynablockList(&dynmap->dynablocks);
             } else
                 if(destroy)
-                    FreeRangeDynablock(dynmap->dynablocks, startaddr, endaddr-startaddr+1);
+                    FreeRangeDynablock(dynmap->dynablocks, addr, size);   // also the blocks reaching the range from before
                 else
                     MarkRangeDynablock(dynmap->dynablocks, startaddr, endaddr-startaddr+1);
 
@@ -203,14 +470,53 @@ void cleanDBFromAddressRange(box86context_t* context, uintptr_t addr, uintptr_t
     }
 }
 
+static uint32_t smc_gen = 0;
+
+// set the state of the dynmaps of a page, return 0 if the page is hot
+static int setPageWritable(uintptr_t page, int writable)
+{
+    int ret = 1;
+    for(uintptr_t i=page>>DYNAMAP_SHIFT; i<(page+box86_pagesize)>>DYNAMAP_SHIFT; ++i) {
+        dynmap_t* dynmap = getDynmap(my_context, i);
+        if(dynmap) {
+            if(writable)
+                dynmap->dirtygen = smc_gen;
+            else if(dynmap->hot)
+                ret = 0;
+            dynmap->writable = writable;
+        }
+    }
+    return ret;
+}
+
 // Remove the Write flag from an adress range, so DB can be executed
 // no log, as it can be executed inside a signal handler
-void protectDB(uintptr_t addr, uintptr_t size)
+int protectDB(uintptr_t addr, uintptr_t size)
 {
     uintptr_t start = (addr)&~(box86_pagesize-1);
     uintptr_t end = (addr+size+(box86_pagesize-1))&~(box86_pagesize-1);
     // should get "end" according to last block inside the window
-    mprotect((void*)start, end-start, PROT_READ|PROT_EXEC);
+    int ret = 1;
+    uintptr_t run = start;  // start of the current run of pages to protect
+    for(uintptr_t page=start; page<end; page+=box86_pagesize) {
+        int hot = 0;
+        for(uintptr_t i=page>>DYNAMAP_SHIFT; i<(page+box86_pagesize)>>DYNAMAP_SHIFT; ++i) {
+            dynmap_t* dynmap = getDynmap(my_context, i);
+            if(dynmap && dynmap->hot)
+                hot = 1;
+        }
+        if(hot) {
+            // hot page stays writable
+            if(page!=run)
+                mprotect((void*)run, page-run, PROT_READ|PROT_EXEC);
+            run = page+box86_pagesize;
+            ret = 0;
+        } else
+            setPageWritable(page, 0);
+    }
+    if(end!=run)
+        mprotect((void*)run, end-run, PROT_READ|PROT_EXEC);
+    return ret;
 }
 
 // Add the Write flag from an adress range, and mark all block as dirty
@@ -221,9 +527,41 @@ void unprotectDB(uintptr_t addr, uintptr_t size)
     uintptr_t end = (addr+size+(box86_pagesize-1))&~(box86_pagesize-1);
     // should get "end" according to last block inside the window
     mprotect((void*)start, end-start, PROT_READ|PROT_WRITE|PROT_EXEC);
+    __sync_add_and_fetch(&smc_gen, 1);
+    for(uintptr_t page=start; page<end; page+=box86_pagesize)
+        setPageWritable(page, 1);
     cleanDBFromAddressRange(my_context, start, end-start, 0);
 }
 
+// no log, executed inside a signal handler
+void faultDB(uintptr_t addr)
+{
+    uintptr_t page = addr&~(box86_pagesize-1);
+    dynmap_t* dynmap = getDynmap(my_context, addr>>DYNAMAP_SHIFT);
+    if(dynmap && !dynmap->hot && ++dynmap->faults>=SMC_HOTPAGE) {
+        // data and code are mixed on this page, stop protecting it, blocks there will be checked (by cache line) when used
+        for(uintptr_t i=page>>DYNAMAP_SHIFT; i<(page+box86_pagesize)>>DYNAMAP_SHIFT; ++i) {
+            dynmap_t* d = getDynmap(my_context, i);
+            if(d)
+                d->hot = 1;
+        }
+    }
+    unprotectDB(addr, 1);   // unprotect 1 byte... But then, the whole page will be unprotected
+}
+
+uint32_t getDBGeneration()
+{
+    return smc_gen;
+}
+
+int isDBDirty(uintptr_t addr, uint32_t gen)
+{
+    dynmap_t* dynmap = getDynmap(my_context, addr>>DYNAMAP_SHIFT);
+    if(!dynmap)
+        return 1;   // unknown, so unprotected
+    return (dynmap->writable || (int32_t)(dynmap->dirtygen-gen)>0)?1:0;
+}
+
 #endif
 
 EXPORTDYN
@@ -295,6 +633,11 @@ box86context_t *NewBox86Context(int argc)
     context->deferedInit = 1;
 #endif
     context->sel_serial = 1;
+    context->singlethread = box86_lockelision;
+#ifdef DYNAREC
+    if(box86_dynarec_async)
+        context->singlethread = 0;  // blocks compiled in the background could miss the switch to atomic LOCK'd operations
+#endif
     context->maplib = NewLibrarian(context, 1);
     context->local_maplib = NewLibrarian(context, 1);
     context->system = NewBridge();
@@ -314,7 +657,8 @@ box86context_t *NewBox86Context(int argc)
     pthread_mutex_init(&context->mutex_once2, NULL);
     pthread_mutex_init(&context->mutex_trace, NULL);
 #ifndef DYNAREC
-    pthread_mutex_init(&context->mutex_lock, NULL);
+    for(int i=0; i<LOCK_STRIPES; ++i)
+        pthread_mutex_init(&context->mutex_lock[i], NULL);
 #endif
     pthread_mutex_init(&context->mutex_tls, NULL);
     pthread_mutex_init(&context->mutex_thread, NULL);
@@ -353,6 +697,10 @@ void FreeBox86Context(box86context_t** context)
 
     box86context_t* ctx = *context;   // local copy to do the cleanning
 
+#ifdef DYNAREC
+    FiniDynaAsync();    // compiler threads must be stopped before anything is freed
+#endif
+
     for(int i=0; i<ctx->elfsize; ++i) {
         FreeElfHeader(&ctx->elfs[i]);
     }
@@ -383,7 +731,21 @@ void FreeBox86Context(box86context_t** context)
         free(ctx->envv[i]);
     free(ctx->envv);
 
+    if(box86_fusion>1)
+        PrintFusionStats();
 #ifdef DYNAREC
+    if(box86_dynarec_stats) {
+        PrintDynarecMapStats();
+        PrintDynaEvictStats();
+        PrintIBTCStats();
+        PrintFillBlockStats();
+    }
+    FiniDynaEvict();    // evicted blocks are not in the dynablocks lists anymore
+    FiniDynaThunk();
+    FiniDynaPerf();
+    // blocks first, as freeing them use the chunks memory
+    dynarec_log(LOG_DEBUG, "Free dynamic Dynarecblocks\n");
+    cleanDBFromAddressRange(ctx, 0, 0xffffffff, 1);
     dynarec_log(LOG_DEBUG, "Free global Dynarecblocks\n");
     for (int i=0; i<ctx->mmapsize; ++i)
         if(ctx->mmaplist[i].block)
@@ -392,11 +754,14 @@ void FreeBox86Context(box86context_t** context)
             #else
             free(ctx->mmaplist[i].block);
             #endif
-    dynarec_log(LOG_DEBUG, "Free dynamic Dynarecblocks\n");
-    cleanDBFromAddressRange(ctx, 0, 0xffffffff, 1);
+    resetDynarecMap();
+    for (int i=0; i<DYNAMAP_L1SIZE; ++i)
+        free(ctx->dynmap[i]);
     pthread_mutex_destroy(&ctx->mutex_blocks);
     pthread_mutex_destroy(&ctx->mutex_mmap);
     free(ctx->mmaplist);
+    freeNativeIndex(ctx->nativeindex);
+    ctx->nativeindex = NULL;
 #endif
     
     *context = NULL;                // bye bye my_context
@@ -441,7 +806,8 @@ void FreeBox86Context(box86context_t** context)
     pthread_mutex_destroy(&ctx->mutex_once2);
     pthread_mutex_destroy(&ctx->mutex_trace);
 #ifndef DYNAREC
-    pthread_mutex_destroy(&ctx->mutex_lock);
+    for(int i=0; i<LOCK_STRIPES; ++i)
+        pthread_mutex_destroy(&ctx->mutex_lock[i]);
 #endif
     pthread_mutex_destroy(&ctx->mutex_tls);
     pthread_mutex_destroy(&ctx->mutex_thread);
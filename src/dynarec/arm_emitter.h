@@ -66,6 +66,8 @@ Op is 20-27
 
 //  nop
 #define NOP     EMIT(0xe1a00000)
+// architectural nop (hint), can be changed into a B while running
+#define NOP_HINT    EMIT(0xe320f000)
 
 // mov dst, src
 #define MOV_REG(dst, src) EMIT(0xe1a00000 | ((dst) << 12) | (src) )
@@ -653,6 +655,8 @@ Op is 20-27
 #define VLD1Q_32_REG(Dd, Rn, Rm) EMIT(Vxx1gen(1, ((Dd)>>4)&1, Rn, ((Dd)&0x0f), 0b1010, 2, 0, Rm))
 // Load [Rn] => Dd/Dd+1. Align is 4
 #define VLD1Q_8(Dd, Rn) EMIT(Vxx1gen(1, ((Dd)>>4)&1, Rn, ((Dd)&0x0f), 0b1010, 0, 0, 15))
+// Load [Rn]! => Dd/Dd+1. No alignment needed
+#define VLD1Q_8_W(Dd, Rn) EMIT(Vxx1gen(1, ((Dd)>>4)&1, Rn, ((Dd)&0x0f), 0b1010, 0, 0, 13))
 // Load [Rn] => Dd/Dd+1. Align is 4
 #define VLD1Q_16(Dd, Rn) EMIT(Vxx1gen(1, ((Dd)>>4)&1, Rn, ((Dd)&0x0f), 0b1010, 1, 0, 15))
 // Load [Rn] => Dd/Dd+1. Align is 4
@@ -676,6 +680,8 @@ Op is 20-27
 #define VST1Q_32_REG(Dd, Rn, Rm) EMIT(Vxx1gen(0, ((Dd)>>4)&1, Rn, ((Dd)&0x0f), 0b1010, 2, 0, Rm))
 // Store [Rn] => Dd/Dd+1. Align is 4
 #define VST1Q_8(Dd, Rn) EMIT(Vxx1gen(0, ((Dd)>>4)&1, Rn, ((Dd)&0x0f), 0b1010, 0, 0, 15))
+// Store [Rn]! => Dd/Dd+1. No alignment needed
+#define VST1Q_8_W(Dd, Rn) EMIT(Vxx1gen(0, ((Dd)>>4)&1, Rn, ((Dd)&0x0f), 0b1010, 0, 0, 13))
 // Store [Rn] => Dd/Dd+1. Align is 4
 #define VST1Q_16(Dd, Rn) EMIT(Vxx1gen(0, ((Dd)>>4)&1, Rn, ((Dd)&0x0f), 0b1010, 1, 0, 15))
 // Store [Rn] => Dd/Dd+1. Align is 4
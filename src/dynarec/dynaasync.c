@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <signal.h>
+#include <errno.h>
+
+#include "debug.h"
+#include "box86context.h"
+#include "dynablock.h"
+#include "dynablock_private.h"
+#include "dynarec_arm.h"
+#include "dynacache.h"
+#include "dynaasync.h"
+
+// Blocks are compiled by a pool of box86_dynarec_async threads, while the thread that asked for it keeps using the interpreter.
+// A block is published by FillBlock setting done=1, so DynaCall / the linker will pick it up on the next try.
+// A dynablocklist is not freed while a compiler thread still uses it (see AsyncDrainList).
+typedef struct dynaasync_s {
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    pthread_cond_t  idle;       // signaled each time a compiler thread is done with a block
+    dynablock_t*    first;      // queue of blocks to compile
+    dynablock_t*    last;
+    int             started;
+    int             quit;
+    int             nthreads;
+    pthread_t*      threads;
+    dynablock_t**   compiling;  // block being compiled by each thread
+    dynablocklist_t** inuse;    // dynablocklist of the block each thread is compiling or freeing
+} dynaasync_t;
+
+static dynaasync_t async = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER};
+static int async_atfork = 0;
+
+static void pushBlock(dynablock_t* block)
+{
+    block->async_next = NULL;
+    if(async.last)
+        async.last->async_next = block;
+    else
+        async.first = block;
+    async.last = block;
+}
+
+static void* asyncThread(void* arg)
+{
+    int idx = (intptr_t)arg;
+    // signals are for the emulated threads, not for the compiler
+    sigset_t mask;
+    sigfillset(&mask);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+    pthread_mutex_lock(&async.mutex);
+    while(!async.quit) {
+        dynablock_t* block = async.first;
+        if(!block) {
+            pthread_cond_wait(&async.cond, &async.mutex);
+            continue;
+        }
+        async.first = block->async_next;
+        if(!async.first)
+            async.last = NULL;
+        block->async_next = NULL;
+        async.inuse[idx] = block->parent;
+        if(block->async!=ASYNC_CANCELED) {
+            block->async = ASYNC_COMPILING;
+            async.compiling[idx] = block;
+            pthread_mutex_unlock(&async.mutex);
+            uintptr_t addr = (uintptr_t)block->x86_addr;
+            if(box86_dynarec_dump)
+                pthread_mutex_lock(&my_context->mutex_dyndump);
+            if(!box86_dynarec_diskcache || !DynaCacheLoad(block, addr))
+                FillBlock(block, addr);
+            if(box86_dynarec_dump)
+                pthread_mutex_unlock(&my_context->mutex_dyndump);
+            dynarec_log(LOG_DEBUG, " --- DynaRec Block compiled asynchronously @%p:%p (%p, 0x%x bytes, with %d son(s))\n", (void*)addr, (void*)(addr+block->x86_size), block->block, block->size, block->sons_size);
+            pthread_mutex_lock(&async.mutex);
+            async.compiling[idx] = NULL;
+        }
+        if(block->async==ASYNC_CANCELED) {
+            // the block has been freed while in the queue / being compiled, it's our job to finish that
+            block->async = 0;
+            pthread_mutex_unlock(&async.mutex);
+            FreeDynablock(block);
+            pthread_mutex_lock(&async.mutex);
+        } else
+            block->async = 0;
+        async.inuse[idx] = NULL;
+        pthread_cond_broadcast(&async.idle);
+    }
+    pthread_mutex_unlock(&async.mutex);
+    return NULL;
+}
+
+static void asyncPrepare()
+{
+    pthread_mutex_lock(&async.mutex);
+}
+static void asyncParent()
+{
+    pthread_mutex_unlock(&async.mutex);
+}
+static void asyncChild()
+{
+    // compiler threads are gone, put back the blocks they were working on in the queue, new threads will be started when needed
+    for(int i=0; i<async.nthreads; ++i)
+        if(async.compiling[i]) {
+            dynablock_t* block = async.compiling[i];
+            async.compiling[i] = NULL;
+            if(block->async==ASYNC_COMPILING)
+                block->async = ASYNC_QUEUED;
+            pushBlock(block);
+        }
+    if(async.inuse)
+        memset(async.inuse, 0, async.nthreads*sizeof(dynablocklist_t*));
+    async.started = 0;
+    pthread_mutex_init(&async.mutex, NULL);
+    pthread_cond_init(&async.cond, NULL);
+    pthread_cond_init(&async.idle, NULL);
+}
+
+// start the threads, async.mutex must be locked
+static int startThreads()
+{
+    if(!async.threads) {
+        async.nthreads = box86_dynarec_async;
+        async.threads = (pthread_t*)calloc(async.nthreads, sizeof(pthread_t));
+        async.compiling = (dynablock_t**)calloc(async.nthreads, sizeof(dynablock_t*));
+        async.inuse = (dynablocklist_t**)calloc(async.nthreads, sizeof(dynablocklist_t*));
+    }
+    if(!async_atfork) {
+        pthread_atfork(asyncPrepare, asyncParent, asyncChild);
+        async_atfork = 1;
+    }
+    int n = 0;
+    for(int i=0; i<async.nthreads; ++i)
+        if(!pthread_create(&async.threads[i], NULL, asyncThread, (void*)(intptr_t)i))
+            ++n;
+        else
+            async.threads[i] = 0;
+    if(!n) {
+        dynarec_log(LOG_INFO, "Warning, cannot start DynaRec compiler threads, compiling synchronously\n");
+        box86_dynarec_async = 0;
+        return 0;
+    }
+    dynarec_log(LOG_DEBUG, "Started %d DynaRec compiler thread(s)\n", n);
+    async.started = 1;
+    return 1;
+}
+
+int AsyncFillBlock(dynablock_t* block)
+{
+    pthread_mutex_lock(&async.mutex);
+    if(async.quit || (!async.started && !startThreads())) {
+        pthread_mutex_unlock(&async.mutex);
+        return 0;
+    }
+    block->async = ASYNC_QUEUED;
+    pushBlock(block);
+    pthread_cond_signal(&async.cond);
+    pthread_mutex_unlock(&async.mutex);
+    return 1;
+}
+
+int AsyncCancelBlock(dynablock_t* block)
+{
+    int ret = 0;
+    pthread_mutex_lock(&async.mutex);
+    if(block->async) {
+        block->async = ASYNC_CANCELED;
+        ret = 1;
+    }
+    pthread_mutex_unlock(&async.mutex);
+    return ret;
+}
+
+static int listInUse(dynablocklist_t* list)
+{
+    for(int i=0; i<async.nthreads; ++i)
+        if(async.inuse[i]==list)
+            return 1;
+    return 0;
+}
+
+void AsyncDrainList(dynablocklist_t* list, int all)
+{
+    pthread_mutex_lock(&async.mutex);
+    if(!async.threads) {
+        pthread_mutex_unlock(&async.mutex);
+        return;
+    }
+    dynablock_t* canceled = NULL;
+    if(all) {
+        // take the blocks of the list out of the queue: the canceled ones are freed here, the other ones with the list
+        dynablock_t* prev = NULL;
+        dynablock_t* block = async.first;
+        while(block) {
+            dynablock_t* next = block->async_next;
+            if(block->parent==list) {
+                if(prev)
+                    prev->async_next = next;
+                else
+                    async.first = next;
+                if(async.last==block)
+                    async.last = prev;
+                block->async_next = NULL;
+                if(block->async==ASYNC_CANCELED) {
+                    block->async_next = canceled;
+                    canceled = block;
+                }
+                block->async = 0;
+            } else
+                prev = block;
+            block = next;
+        }
+    }
+    while(listInUse(list))
+        pthread_cond_wait(&async.idle, &async.mutex);
+    pthread_mutex_unlock(&async.mutex);
+    while(canceled) {
+        dynablock_t* next = canceled->async_next;
+        canceled->async_next = NULL;
+        FreeDynablock(canceled);
+        canceled = next;
+    }
+}
+
+void FiniDynaAsync()
+{
+    pthread_mutex_lock(&async.mutex);
+    if(!async.started) {
+        pthread_mutex_unlock(&async.mutex);
+        return;
+    }
+    async.quit = 1;
+    pthread_cond_broadcast(&async.cond);
+    pthread_mutex_unlock(&async.mutex);
+    for(int i=0; i<async.nthreads; ++i)
+        if(async.threads[i])
+            pthread_join(async.threads[i], NULL);
+    // what is left in the queue will be freed as a regular block
+    dynablock_t* block = async.first;
+    while(block) {
+        dynablock_t* next = block->async_next;
+        int canceled = (block->async==ASYNC_CANCELED);
+        block->async = 0;
+        if(canceled)
+            FreeDynablock(block);
+        block = next;
+    }
+    async.first = async.last = NULL;
+    async.started = 0;
+    free(async.threads);
+    free(async.compiling);
+    free(async.inuse);
+    async.threads = NULL;
+    async.compiling = NULL;
+    async.inuse = NULL;
+}
@@ -18,6 +18,10 @@
 #include "dynablock_private.h"
 #include "dynarec_private.h"
 #include "elfloader.h"
+#include "dynacache.h"
+#include "dynaasync.h"
+#include "dynaevict.h"
+#include "dynaperf.h"
 #ifdef ARM
 #include "dynarec_arm.h"
 #include "arm_lock_helper.h"
@@ -38,6 +42,51 @@ uint32_t X31_hash_code(void* addr, int len)
 	return (uint32_t)h;
 }
 
+void HashDynablock(dynablock_t* db, uint32_t gen)
+{
+    uintptr_t start = (uintptr_t)db->x86_addr;
+    uintptr_t end = start+db->x86_size;
+    uintptr_t line = start&~(SMC_LINE-1);
+    int n = (end-line+SMC_LINE-1)/SMC_LINE;
+    db->hash = X31_hash_code(db->x86_addr, db->x86_size);
+    db->linehash = (uint32_t*)realloc(db->linehash, n*sizeof(uint32_t));
+    for(int i=0; i<n; ++i, line+=SMC_LINE) {
+        uintptr_t s = (line<start)?start:line;
+        uintptr_t e = (line+SMC_LINE>end)?end:(line+SMC_LINE);
+        db->linehash[i] = X31_hash_code((void*)s, e-s);
+    }
+    db->checkgen = gen;
+}
+
+// check if the x86 code of a father block is unchanged, only hashing the lines of pages that may have been written since last check
+static int checkDynablock(dynablock_t* father)
+{
+    if(!father->nolinker)
+        return 1;
+    uint32_t gen = getDBGeneration();
+    if(!father->linehash)
+        return (X31_hash_code(father->x86_addr, father->x86_size)==father->hash)?1:0;
+    uintptr_t start = (uintptr_t)father->x86_addr;
+    uintptr_t end = start+father->x86_size;
+    uintptr_t line = start&~(SMC_LINE-1);
+    uintptr_t page = (uintptr_t)-1;
+    int dirty = 1;
+    for(int i=0; line<end; ++i, line+=SMC_LINE) {
+        if((line>>DYNAMAP_SHIFT)!=page) {
+            page = line>>DYNAMAP_SHIFT;
+            dirty = isDBDirty(line, father->checkgen);
+        }
+        if(dirty) {
+            uintptr_t s = (line<start)?start:line;
+            uintptr_t e = (line+SMC_LINE>end)?end:(line+SMC_LINE);
+            if(X31_hash_code((void*)s, e-s)!=father->linehash[i])
+                return 0;
+        }
+    }
+    father->checkgen = gen;
+    return 1;
+}
+
 dynablocklist_t* NewDynablockList(uintptr_t base, uintptr_t text, int textsz, int nolinker, int direct)
 {
     if(!textsz) {
@@ -50,28 +99,52 @@ dynablocklist_t* NewDynablockList(uintptr_t base, uintptr_t text, int textsz, in
     ret->textsz = textsz;
     ret->nolinker = nolinker;
     if(direct && textsz) {
-        ret->direct = (dynablock_t**)calloc(textsz, sizeof(dynablock_t*));
+        ret->direct = (dynablock_t***)calloc(DIRECT_CHUNKS(textsz), sizeof(dynablock_t**));
         if(!ret->direct) {printf_log(LOG_NONE, "Warning, fail to create direct block for dynablock @%p\n", (void*)text);}
     }
     return ret;
 }
 
+dynablock_t** getDirectSlot(dynablocklist_t* dynablocks, uintptr_t addr, int create)
+{
+    dynablock_t*** pchunk = &dynablocks->direct[(addr-dynablocks->text)>>DIRECT_SHIFT];
+    dynablock_t** chunk = *pchunk;
+    if(!chunk) {
+        if(!create)
+            return NULL;
+        // chunks are only freed with the list, so they can be read without lock
+        dynablock_t** newchunk = (dynablock_t**)calloc(DIRECT_SIZE, sizeof(dynablock_t*));
+        chunk = (dynablock_t**)arm_lock_storeifnull(pchunk, newchunk);
+        if(chunk!=newchunk)
+            free(newchunk);
+    }
+    return &chunk[(addr-dynablocks->text)&DIRECT_MASK];
+}
+
 void FreeDynablock(dynablock_t* db)
 {
     if(db) {
         dynarec_log(LOG_DEBUG, "FreeDynablock(%p), db->block=%p x86=%p:%p father=%p, tablesz=%d, with %d son(s) already gone=%d\n", db, db->block, db->x86_addr, db->x86_addr+db->x86_size, db->father, db->tablesz, db->sons_size, db->gone);
         if(db->gone)
             return; // already in the process of deletion!
-        db->done = 0;
-        db->gone = 1;
-        // remove from direct if there
-        uintptr_t startdb = db->parent->text;
-        uintptr_t enddb = db->parent->text + db->parent->textsz;
-        if(db->parent->direct) {
+        if(db->tiered) {
+            // the higher tier block will free this one
+            FreeDynablock(db->tiered);
+            return;
+        }
+        // remove from direct if there (and still this block), evicted blocks are already out
+        if(!db->evicted && db->parent->direct) {
+            uintptr_t startdb = db->parent->text;
+            uintptr_t enddb = db->parent->text + db->parent->textsz;
             uintptr_t addr = (uintptr_t)db->x86_addr;
-            if(addr>=startdb && addr<enddb)
-                db->parent->direct[addr-startdb] = NULL;
+            dynablock_t** slot = (addr>=startdb && addr<enddb)?getDirectSlot(db->parent, addr, 0):NULL;
+            if(slot && *slot==db)
+                *slot = NULL;
         }
+        if(db->async && AsyncCancelBlock(db))
+            return; // the compiler thread will free it
+        db->done = 0;
+        db->gone = 1;
         // remove and free the sons
         for (int i=0; i<db->sons_size; ++i) {
             dynablock_t *son = (dynablock_t*)arm_lock_xchg(&db->sons[i], 0);
@@ -79,12 +152,24 @@ void FreeDynablock(dynablock_t* db)
         }
         // only the father free the DynarecMap
         if(!db->father) {
+            DynaEvictRemove(db);
+            DynaUnlinkBlock(db);
+            IBTCRemove(db);
+            GdbJitRemoveBlock(db);
             dynarec_log(LOG_DEBUG, " -- FreeDyrecMap(%p, %d)\n", db->block, db->size);
+            setDynarecMapOwner((uintptr_t)db->block, db->size, NULL);
             FreeDynarecMap((uintptr_t)db->block, db->size);
         }
+        // and the lower tier block, that was still in use until now
+        if(db->previous) {
+            db->previous->tiered = NULL;
+            FreeDynablock(db->previous);
+        }
         free(db->sons);
         free(db->table);
         free(db->instsize);
+        free(db->linehash);
+        free(db->patch);
         free(db);
     }
 }
@@ -96,11 +181,18 @@ void FreeDynablockList(dynablocklist_t** dynablocks)
     if(!*dynablocks)
         return;
     dynarec_log(LOG_DEBUG, "Free Direct Blocks %p from Dynablocklist nolinker=%d\n", (*dynablocks)->direct, (*dynablocks)->nolinker);
+    AsyncDrainList(*dynablocks, 1);
     if((*dynablocks)->direct) {
-        for (int i=0; i<(*dynablocks)->textsz; ++i) {
-            if((*dynablocks)->direct[i] && !(*dynablocks)->direct[i]->father) 
-                FreeDynablock((*dynablocks)->direct[i]);
+        int n = DIRECT_CHUNKS((*dynablocks)->textsz);
+        for (int i=0; i<n; ++i) {
+            dynablock_t** chunk = (*dynablocks)->direct[i];
+            if(chunk)
+                for (int j=0; j<DIRECT_SIZE; ++j)
+                    if(chunk[j] && !chunk[j]->father) 
+                        FreeDynablock(chunk[j]);
         }
+        for (int i=0; i<n; ++i)
+            free((*dynablocks)->direct[i]);
         free((*dynablocks)->direct);
     }
     (*dynablocks)->direct = NULL;
@@ -137,12 +229,13 @@ void MarkDynablockList(dynablocklist_t** dynablocks)
     if(!(*dynablocks)->nolinker)
         return;
     dynarec_log(LOG_DEBUG, "Marked Blocks from Dynablocklist nolinker=%d %p:0x%x\n", (*dynablocks)->nolinker, (void*)(*dynablocks)->text, (*dynablocks)->textsz);
-    dynablock_t* db;
     if((*dynablocks)->direct) {
-        for (int i=0; i<(*dynablocks)->textsz; ++i) {
-            db = (*dynablocks)->direct[i];
-            if(db)
-                MarkDynablock(db);
+        for (int i=0; i<DIRECT_CHUNKS((*dynablocks)->textsz); ++i) {
+            dynablock_t** chunk = (*dynablocks)->direct[i];
+            if(chunk)
+                for (int j=0; j<DIRECT_SIZE; ++j)
+                    if(chunk[j])
+                        MarkDynablock(chunk[j]);
         }
     }
 }
@@ -154,12 +247,13 @@ void ProtectDynablockList(dynablocklist_t** dynablocks)
     if(!*dynablocks)
         return;
     dynarec_log(LOG_DEBUG, "Protect Blocks from Dynablocklist nolinker=%d %p:0x%x\n", (*dynablocks)->nolinker, (void*)(*dynablocks)->text, (*dynablocks)->textsz);
-    dynablock_t* db;
     if((*dynablocks)->direct) {
-        for (int i=0; i<(*dynablocks)->textsz; ++i) {
-            db = (*dynablocks)->direct[i];
-            if(db)
-                ProtectDynablock(db);
+        for (int i=0; i<DIRECT_CHUNKS((*dynablocks)->textsz); ++i) {
+            dynablock_t** chunk = (*dynablocks)->direct[i];
+            if(chunk)
+                for (int j=0; j<DIRECT_SIZE; ++j)
+                    if(chunk[j])
+                        ProtectDynablock(chunk[j]);
         }
     }
 }
@@ -191,10 +285,12 @@ void MarkDirectDynablock(dynablocklist_t* dynablocks, uintptr_t addr, uintptr_t
     if(end>enddb)
         end = enddb;
     if(end>startdb && start<enddb)
-        for(uintptr_t i = start; i<end; ++i)
-            if(dynablocks->direct[i-startdb]) {
-                MarkDynablock(dynablocks->direct[i-startdb]);
+        for(uintptr_t i = start; i<end; ++i) {
+            dynablock_t* db = getDirect(dynablocks, i);
+            if(db) {
+                MarkDynablock(db);
             }
+        }
 }
 
 void ProtectDirectDynablock(dynablocklist_t* dynablocks, uintptr_t addr, uintptr_t size)
@@ -227,7 +323,8 @@ void FreeRangeDynablock(dynablocklist_t* dynablocks, uintptr_t addr, uintptr_t s
         if(dynablocks->direct) {
             uintptr_t startdb = dynablocks->text;
             uintptr_t enddb = startdb + dynablocks->textsz;
-            uintptr_t start = addr;
+            // a block starting before can go up to there (an inlined function is in the range of its caller)
+            uintptr_t start = (addr>box86_dynarec_largest)?(addr-box86_dynarec_largest):0;
             uintptr_t end = addr+size;
             if(start<startdb)
                 start = startdb;
@@ -235,10 +332,19 @@ void FreeRangeDynablock(dynablocklist_t* dynablocks, uintptr_t addr, uintptr_t s
                 end = enddb;
             if(end>startdb && start<enddb)
                 for(uintptr_t i = start; i<end; ++i) {
-                    db = (dynablock_t*)arm_lock_xchg(&dynablocks->direct[i-startdb], 0);
+                    dynablock_t** slot = getDirectSlot(dynablocks, i, 0);
+                    if(!slot) {
+                        i = startdb + ((i-startdb)|DIRECT_MASK);    // no chunk here, skip it
+                        continue;
+                    }
+                    if(i<addr && (!*slot || (uintptr_t)(*slot)->x86_addr+(*slot)->x86_size<=addr))
+                        continue;
+                    db = (dynablock_t*)arm_lock_xchg(slot, 0);
                     if(db) {
                         if(db->father)
                             db = db->father;
+                        while(db->tiered)
+                            db = db->tiered;
                         k = kh_put(dynablocks, blocks, (uintptr_t)db, &ret);
                         kh_value(blocks, k) = db;
                     }
@@ -249,6 +355,8 @@ void FreeRangeDynablock(dynablocklist_t* dynablocks, uintptr_t addr, uintptr_t s
             FreeDynablock(db);
         );
         kh_destroy(dynablocks, blocks);
+        // the x86 code of the canceled blocks may be about to go
+        AsyncDrainList(dynablocks, 0);
     }
 }
 void MarkRangeDynablock(dynablocklist_t* dynablocks, uintptr_t addr, uintptr_t size)
@@ -266,37 +374,63 @@ dynablock_t* FindDynablockDynablocklist(void* addr, dynablocklist_t* dynablocks)
     if(!dynablocks)
         return NULL;
     if(dynablocks->direct)
-        for(int i=0; i<dynablocks->textsz; ++i) {
-            dynablock_t* db;
-            if((db = dynablocks->direct[i])) {
-                uintptr_t s = (uintptr_t)db->block;
-                uintptr_t e = (uintptr_t)db->block+db->size;
-                if((uintptr_t)addr>=s && (uintptr_t)addr<e)
-                    return db->father?db->father:db;
-            }
+        for(int i=0; i<DIRECT_CHUNKS(dynablocks->textsz); ++i) {
+            dynablock_t** chunk = dynablocks->direct[i];
+            if(chunk)
+                for(int j=0; j<DIRECT_SIZE; ++j) {
+                    dynablock_t* db;
+                    if((db = chunk[j])) {
+                        uintptr_t s = (uintptr_t)db->block;
+                        uintptr_t e = (uintptr_t)db->block+db->size;
+                        if((uintptr_t)addr>=s && (uintptr_t)addr<e)
+                            return db->father?db->father:db;
+                    }
+                }
         }
     return NULL;
 }
 
 dynablock_t* FindDynablockFromNativeAddress(void* addr)
 {
-    // unoptimized search through all dynablockslist for the dynablock that contains native addr (NULL if not found)
-    dynablock_t *ret = NULL;
-    for(int idx=0; idx<DYNAMAP_SIZE && !ret; ++idx)
-        if(my_context->dynmap[idx])
-            ret = FindDynablockDynablocklist(addr, my_context->dynmap[idx]->dynablocks);
-    if(ret)
-        return ret;
+    // use the native index of the dynarec map (no lock, can be used in signal handler), NULL if not found
+    dynablock_t *ret = getDynarecMapOwner((uintptr_t)addr);
+    if(ret && ((uintptr_t)addr<(uintptr_t)ret->block || (uintptr_t)addr>=(uintptr_t)ret->block+ret->size))
+        return NULL;
     return ret;
 }
 
 static dynablocklist_t* getDBFromAddress(uintptr_t addr)
 {
-    int idx = (addr>>DYNAMAP_SHIFT);
-    if(!my_context->dynmap[idx]) {
+    dynmap_t* dynmap = getDynmap(my_context, addr>>DYNAMAP_SHIFT);
+    if(!dynmap) {
         return NULL;
     }
-    return my_context->dynmap[idx]->dynablocks;
+    return dynmap->dynablocks;
+}
+
+uint32_t DBEntryFlags(uintptr_t addr)
+{
+    dynablocklist_t* dynablocks = getDBFromAddress(addr);
+    if(!dynablocks || dynablocks->nolinker || !dynablocks->direct)
+        return X_ALL;
+    if((addr<dynablocks->text) || (addr>=(dynablocks->text+dynablocks->textsz)))
+        return X_ALL;
+    dynablock_t* db = getDirect(dynablocks, addr);
+    if(!db || !db->done || !db->block)
+        return X_ALL;
+    return db->entry_flags;
+}
+
+int DBIsStatic(uintptr_t addr, uintptr_t size)
+{
+    // first and last page are enough, there is no hole in a function
+    dynablocklist_t* dynablocks = getDBFromAddress(addr);
+    if(!dynablocks || dynablocks->nolinker)
+        return 0;
+    dynablocks = getDBFromAddress(addr+size-1);
+    if(!dynablocks || dynablocks->nolinker)
+        return 0;
+    return 1;
 }
 
 dynablock_t *AddNewDynablock(dynablocklist_t* dynablocks, uintptr_t addr, int* created)
@@ -316,7 +450,7 @@ dynablock_t *AddNewDynablock(dynablocklist_t* dynablocks, uintptr_t addr, int* c
     dynablock_t* block = NULL;
     // first, check if it exist in direct access mode
     if(dynablocks->direct) {
-        block = dynablocks->direct[addr-dynablocks->text];
+        block = getDirect(dynablocks, addr);
         if(block) {
             dynarec_log(LOG_DUMP, "Block already exist in Direct Map\n");
             *created = 0;
@@ -327,14 +461,17 @@ dynablock_t *AddNewDynablock(dynablocklist_t* dynablocks, uintptr_t addr, int* c
     if (!*created)
         return block;
     
-    if(!dynablocks->direct)
-        dynablocks->direct = (dynablock_t**)calloc(dynablocks->textsz, sizeof(dynablock_t*));
+    if(!dynablocks->direct) {
+        dynablock_t*** direct = (dynablock_t***)calloc(DIRECT_CHUNKS(dynablocks->textsz), sizeof(dynablock_t**));
+        if(arm_lock_storeifnull(&dynablocks->direct, direct)!=direct)
+            free(direct);
+    }
 
     // create and add new block
     dynarec_log(LOG_DUMP, "Ask for DynaRec Block creation @%p\n", (void*)addr);
 
     block = (dynablock_t*)calloc(1, sizeof(dynablock_t));
-    dynablock_t* tmp = (dynablock_t*)arm_lock_storeifnull(&dynablocks->direct[addr-dynablocks->text], block);
+    dynablock_t* tmp = (dynablock_t*)arm_lock_storeifnull(getDirectSlot(dynablocks, addr, 1), block);
     if(tmp !=  block) {
         // a block appeard!
         free(block);
@@ -362,7 +499,7 @@ static dynablock_t* internalDBGetBlock(x86emu_t* emu, uintptr_t addr, uintptr_t
         if(!(addr>=dynablocks->text && addr<(dynablocks->text+dynablocks->textsz)))
             dynablocks = NULL;
         else if(dynablocks->direct && (addr>=dynablocks->text) && (addr<(dynablocks->text+dynablocks->textsz))) {
-            block = dynablocks->direct[addr-dynablocks->text];
+            block = getDirect(dynablocks, addr);
             if(block)
                 return block;
         }
@@ -376,7 +513,7 @@ static dynablock_t* internalDBGetBlock(x86emu_t* emu, uintptr_t addr, uintptr_t
         return NULL;
     // check direct first, without lock
     if(dynablocks->direct && (addr>=dynablocks->text) && (addr<(dynablocks->text+dynablocks->textsz)))
-        block = dynablocks->direct[addr-dynablocks->text];
+        block = getDirect(dynablocks, addr);
     if(block)
         return block;
 
@@ -385,11 +522,16 @@ static dynablock_t* internalDBGetBlock(x86emu_t* emu, uintptr_t addr, uintptr_t
     if(!created)
         return block;   // existing block...
 
-    if(box86_dynarec_dump)
-        pthread_mutex_lock(&my_context->mutex_dyndump);
     // fill the block
     block->x86_addr = (void*)addr;
-    FillBlock(block, filladdr);
+    if(box86_dynarec_async && addr==filladdr && AsyncFillBlock(block)) {
+        dynarec_log(LOG_DEBUG, " --- DynaRec Block queued @%p\n", (void*)addr);
+        return block;   // the worker takes mutex_dyndump itself
+    }
+    if(box86_dynarec_dump)
+        pthread_mutex_lock(&my_context->mutex_dyndump);
+    if(!box86_dynarec_diskcache || addr!=filladdr || !DynaCacheLoad(block, addr))
+        FillBlock(block, filladdr);
     if(box86_dynarec_dump)
         pthread_mutex_unlock(&my_context->mutex_dyndump);
 
@@ -401,11 +543,12 @@ static dynablock_t* internalDBGetBlock(x86emu_t* emu, uintptr_t addr, uintptr_t
 dynablock_t* DBGetBlock(x86emu_t* emu, uintptr_t addr, int create, dynablock_t** current)
 {
     dynablock_t *db = internalDBGetBlock(emu, addr, addr, create, *current);
+    if(db && box86_dynarec_cache_mb)
+        DynaEvictTouch(db);
     if(db && (db->need_test || (db->father && db->father->need_test))) {
         dynablock_t *father = db->father?db->father:db;
-        uint32_t hash = father->nolinker?X31_hash_code(father->x86_addr, father->x86_size):0;
-        if(hash!=father->hash) {
-            dynarec_log(LOG_DEBUG, "Invalidating block %p from %p:%p (hash:%X/%X) with %d son(s)\n", father, father->x86_addr, father->x86_addr+father->x86_size, hash, father->hash, father->sons_size);
+        if(!checkDynablock(father)) {
+            dynarec_log(LOG_DEBUG, "Invalidating block %p from %p:%p (hash changed) with %d son(s)\n", father, father->x86_addr, father->x86_addr+father->x86_size, father->sons_size);
             // no more current if it gets invalidated too
             if(*current && father->x86_addr>=(*current)->x86_addr && (father->x86_addr+father->x86_size)<(*current)->x86_addr)
                 *current = NULL;
@@ -414,13 +557,56 @@ dynablock_t* DBGetBlock(x86emu_t* emu, uintptr_t addr, int create, dynablock_t**
             // start again... (will create a new block)
             db = internalDBGetBlock(emu, addr, addr, create, *current);
         } else {
-            father->need_test = 0;
-            protectDB((uintptr_t)father->x86_addr, father->x86_size);
+            // still need testing if some page has been left writable
+            father->need_test = protectDB((uintptr_t)father->x86_addr, father->x86_size)?0:1;
         }
     } 
     return db;
 }
 
+static pthread_mutex_t mutex_tierup = PTHREAD_MUTEX_INITIALIZER;
+dynablock_t* DBTierUp(dynablock_t* block)
+{
+    if(block->father || block->gone || !block->block)
+        return block;
+    pthread_mutex_lock(&mutex_tierup);
+    if(block->tiered) {
+        dynablock_t* ret = block->tiered;
+        pthread_mutex_unlock(&mutex_tierup);
+        return ret;
+    }
+    dynablocklist_t* dynablocks = block->parent;
+    uintptr_t addr = (uintptr_t)block->x86_addr;
+    dynarec_log(LOG_DEBUG, "Recompiling hot block %p at %p\n", block, (void*)addr);
+    dynablock_t* hot = (dynablock_t*)calloc(1, sizeof(dynablock_t));
+    hot->parent = dynablocks;
+    hot->x86_addr = block->x86_addr;
+    hot->tier = 2;
+    if(box86_dynarec_dump)
+        pthread_mutex_lock(&my_context->mutex_dyndump);
+    FillBlock(hot, addr);
+    if(box86_dynarec_dump)
+        pthread_mutex_unlock(&my_context->mutex_dyndump);
+    if(!hot->block || !dynablocks->direct || getDirect(dynablocks, addr)!=block) {
+        // failed, or block is not current anymore, forget it
+        FreeDynablock(hot);
+        pthread_mutex_unlock(&mutex_tierup);
+        return block;
+    }
+    hot->previous = block;
+    block->tiered = hot;
+    *getDirectSlot(dynablocks, addr, 0) = hot;
+    // redirect the entry of the old block, for all the blocks linked to it
+    uint32_t* entry = (uint32_t*)block->block;
+    entry[1] = (uint32_t)hot->block;
+    __sync_synchronize();
+    entry[0] = 0xe51ff004;  // ldr pc, [pc, #-4]
+    __clear_cache(entry, entry+2);
+    pthread_mutex_unlock(&mutex_tierup);
+    dynarec_log(LOG_DEBUG, " --- DynaRec Hot Block created @%p:%p (%p, 0x%x bytes, with %d son(s))\n", (void*)addr, (void*)(addr+hot->x86_size), hot->block, hot->size, hot->sons_size);
+    return hot;
+}
+
 dynablock_t* DBAlternateBlock(x86emu_t* emu, uintptr_t addr, uintptr_t filladdr)
 {
     dynarec_log(LOG_DEBUG, "Creating AlternateBlock at %p for %p\n", (void*)addr, (void*)filladdr);
@@ -428,16 +614,15 @@ dynablock_t* DBAlternateBlock(x86emu_t* emu, uintptr_t addr, uintptr_t filladdr)
     dynablock_t *db = internalDBGetBlock(emu, addr, filladdr, create, NULL);
     if(db && (db->need_test || (db->father && db->father->need_test))) {
         dynablock_t *father = db->father?db->father:db;
-        uint32_t hash = father->nolinker?X31_hash_code(father->x86_addr, father->x86_size):0;
-        if(hash!=father->hash) {
-            dynarec_log(LOG_DEBUG, "Invalidating block %p from %p:%p (hash:%X/%X) with %d son(s)\n", father, father->x86_addr, father->x86_addr+father->x86_size, hash, father->hash, father->sons_size);
+        if(!checkDynablock(father)) {
+            dynarec_log(LOG_DEBUG, "Invalidating block %p from %p:%p (hash changed) with %d son(s)\n", father, father->x86_addr, father->x86_addr+father->x86_size, father->sons_size);
             // Free father, it's now invalid!
             FreeDynablock(father);
             // start again... (will create a new block)
             db = internalDBGetBlock(emu, addr, filladdr, create, NULL);
         } else {
-            father->need_test = 0;
-            protectDB((uintptr_t)father->x86_addr, father->x86_size);
+            // still need testing if some page has been left writable
+            father->need_test = protectDB((uintptr_t)father->x86_addr, father->x86_size)?0:1;
         }
     } 
     return db;
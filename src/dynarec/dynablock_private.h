@@ -29,14 +29,48 @@ typedef struct dynablock_s {
     int             sons_size;
     dynablock_t*    father; // set only in the case of a son
     instsize_t*      instsize;
+    int             async;      // state in the compiler threads queue
+    dynablock_t*    async_next; // next in the compiler threads queue
+    int             tier;       // 1 for regular block, 2 for block recompiled because hot
+    dynablock_t*    previous;   // lower tier block replaced by this one (still in use)
+    dynablock_t*    tiered;     // higher tier block replacing this one
+    void***         linkfrom;   // jump table entries linked to this block (father only)
+    int             linkfrom_size;
+    int             linkfrom_cap;
+    uint32_t        lastuse;    // eviction clock when last used
+    uint8_t         inlru;      // in the code cache list
+    uint8_t         evicted;    // evicted from the code cache, waiting to be freed
+    dynablock_t*    lru_prev;
+    dynablock_t*    lru_next;
+    uint32_t*       linehash;   // hash of the x86 code by SMC_LINE (for nolinker father)
+    uint32_t        checkgen;   // SMC generation of the last time the hash was checked
+    uint32_t        entry_flags;// x86 flags that may be read from the entry of the block (X_ALL if unknown)
+    uint8_t         nolock;     // built for a single thread, with plain LOCK'd operations
+    uintptr_t*      patch;      // slot of each jump table entry that can become a direct branch (BOX86_DYNAREC_PATCH), 0 if none
+    void*           gdbjit;     // GDB JIT object with the symbol of the block (BOX86_DYNAREC_GDBJIT)
 } dynablock_t;
 
+// direct mapping is in 2 levels: chunks of DIRECT_SIZE entries, allocated only where some block starts
+#define DIRECT_SHIFT    6
+#define DIRECT_SIZE     (1<<DIRECT_SHIFT)
+#define DIRECT_MASK     (DIRECT_SIZE-1)
+#define DIRECT_CHUNKS(textsz)   (((textsz)+DIRECT_MASK)>>DIRECT_SHIFT)
+
 typedef struct dynablocklist_s {
     uintptr_t           base;
     uintptr_t           text;
     int                 textsz;
     int                 nolinker;    // in case this dynablock can disapear (also, block memory are allocated with a temporary scheme)
-    dynablock_t**       direct;    // direct mapping (waste of space, so not always there)
+    dynablock_t***      direct;    // direct mapping, by chunks (not always there)
 } dynablocklist_t;
 
+// get the block starting at addr (must be inside the list, with a direct mapping), no lock needed
+static inline dynablock_t* getDirect(dynablocklist_t* dynablocks, uintptr_t addr)
+{
+    dynablock_t** chunk = dynablocks->direct[(addr-dynablocks->text)>>DIRECT_SHIFT];
+    return chunk?chunk[(addr-dynablocks->text)&DIRECT_MASK]:NULL;
+}
+// get the direct mapping entry of addr, creating its chunk if create is set (else NULL if no chunk)
+dynablock_t** getDirectSlot(dynablocklist_t* dynablocks, uintptr_t addr, int create);
+
 #endif //__DYNABLOCK_PRIVATE_H_
\ No newline at end of file
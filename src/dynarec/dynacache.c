@@ -0,0 +1,446 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <elf.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/file.h>
+
+#include "debug.h"
+#include "box86context.h"
+#include "elfloader.h"
+#include "elfs/elfloader_private.h"
+#include "dynablock.h"
+#include "dynablock_private.h"
+#include "dynarec_arm.h"
+#include "dynarec_arm_private.h"
+#include "dynarec_arm_functions.h"
+#include "dynacache.h"
+#include "dynaevict.h"
+#include "dynaperf.h"
+
+#include "khash.h"
+
+KHASH_MAP_INIT_INT(dynacache, uint32_t)
+
+void arm_linker();
+
+#define DYNACACHE_MAGIC     0x43363842  // "B86C"
+#define DYNACACHE_VERSION   2
+
+#define ALIGN4(A)   (((A)+3)&~3)
+
+typedef struct dynacache_header_s {
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    box86_size;     // identity of the box86 binary that generated the code
+    uint32_t    box86_mtime;
+    uint32_t    box86_fnc;      // address of a box86 function, to detect a relocated box86
+    uint32_t    elf_size;       // identity of the elf
+    uint32_t    elf_mtime;
+    uint32_t    delta;          // load delta of the elf
+    uint32_t    options;        // dynarec options that change the generated code
+} dynacache_header_t;
+
+typedef struct dynacache_entry_s {
+    uint32_t    x86_addr;
+    uint32_t    x86_size;
+    uint32_t    hash;           // X31 hash of the x86 code
+    uint32_t    size;           // size of the arm code
+    uint32_t    isize;          // number of x86 instructions
+    uint32_t    instsize_sz;
+    uint32_t    tablesz;
+    uint32_t    sons_size;
+    uint32_t    relocs_size;
+    uint32_t    total;          // size of the whole entry
+} dynacache_entry_t;
+// an entry is followed by: arm code, instsize (aligned), x86 ip of each jump table slot, sons (x86 address / arm offset) and relocs
+
+typedef struct dynacache_s {
+    int                 fd;         // -1 if there is no cache for this elf
+    uint8_t*            map;        // cache file, as it was when opened
+    size_t              mapsz;
+    kh_dynacache_t*     index;      // x86 address -> offset of the entry in map
+    size_t              filesz;
+    pthread_mutex_t     mutex;
+    int                 loaded;
+    int                 saved;
+} dynacache_t;
+
+static pthread_mutex_t mutex_dynacache = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t entrySize(uint32_t size, uint32_t instsize_sz, uint32_t tablesz, uint32_t sons_size, uint32_t relocs_size)
+{
+    return sizeof(dynacache_entry_t) + ALIGN4(size) + ALIGN4(instsize_sz) + (tablesz/4)*sizeof(uint32_t) + sons_size*2*sizeof(uint32_t) + relocs_size*sizeof(dynareloc_t);
+}
+
+static uint32_t getOptions()
+{
+    uint32_t ret = 0;
+    if(box86_dynarec_linker) ret |= 1<<0;
+    if(box86_dynarec_smc) ret |= 1<<1;
+    if(box86_dynarec_hot) ret |= 1<<3;
+    if(box86_dynarec_ibtc) ret |= 1<<4;
+    if(box86_dynarec_ibtc && box86_dynarec_stats) ret |= 1<<5;
+    if(box86_dynarec_patch) ret |= 1<<6;
+    ret |= (box86_dynarec_inline&0xffff)<<16;
+#ifdef HAVE_TRACE
+    if(box86_dynarec_trace) ret |= 1<<2;
+#endif
+#ifdef ARM
+    ret |= (arm_vfp&0xf)<<8;
+    if(arm_swap) ret |= 1<<12;
+    if(arm_div) ret |= 1<<13;
+#endif
+    return ret;
+}
+
+static int fillHeader(elfheader_t* h, dynacache_header_t* head)
+{
+    struct stat st;
+    memset(head, 0, sizeof(dynacache_header_t));
+    head->magic = DYNACACHE_MAGIC;
+    head->version = DYNACACHE_VERSION;
+    if(stat("/proc/self/exe", &st))
+        return 1;
+    head->box86_size = st.st_size;
+    head->box86_mtime = st.st_mtime;
+    head->box86_fnc = (uintptr_t)FillBlock;
+    if(!h->path || stat(h->path, &st))
+        return 1;
+    head->elf_size = st.st_size;
+    head->elf_mtime = st.st_mtime;
+    head->delta = h->delta;
+    head->options = getOptions();
+    return 0;
+}
+
+static int mkdirs(char* path)
+{
+    for(char* p = strchr(path+1, '/'); p; p = strchr(p+1, '/')) {
+        *p = '\0';
+        if(mkdir(path, 0755) && errno!=EEXIST) {
+            *p = '/';
+            return 1;
+        }
+        *p = '/';
+    }
+    if(mkdir(path, 0755) && errno!=EEXIST)
+        return 1;
+    return 0;
+}
+
+static int getCachePath(elfheader_t* h, char* path)
+{
+    char dir[PATH_MAX];
+    if(box86_dynarec_diskcache_dir)
+        snprintf(dir, sizeof(dir), "%s", box86_dynarec_diskcache_dir);
+    else {
+        const char* home = getenv("HOME");
+        if(!home)
+            return 1;
+        snprintf(dir, sizeof(dir), "%s/.cache/box86", home);
+    }
+    if(mkdirs(dir)) {
+        dynarec_log(LOG_INFO, "Warning, cannot create dynarec cache folder \"%s\" (%s)\n", dir, strerror(errno));
+        return 1;
+    }
+    const char* name = strrchr(h->path, '/');
+    name = name?(name+1):h->path;
+    if(snprintf(path, PATH_MAX, "%s/%s-%08x.dyc", dir, name, X31_hash_code(h->path, strlen(h->path)))>=PATH_MAX) {
+        dynarec_log(LOG_INFO, "Warning, dynarec cache path for \"%s\" is too long\n", h->path);
+        return 1;
+    }
+    return 0;
+}
+
+static void indexDynaCache(dynacache_t* cache)
+{
+    int ret;
+    cache->index = kh_init(dynacache);
+    size_t off = sizeof(dynacache_header_t);
+    while(off+sizeof(dynacache_entry_t)<=cache->mapsz) {
+        dynacache_entry_t* e = (dynacache_entry_t*)(cache->map+off);
+        if(e->total<sizeof(dynacache_entry_t) || e->total>cache->mapsz-off || (e->total&3))
+            break;  // truncated entry, stop here
+        khint_t k = kh_put(dynacache, cache->index, e->x86_addr, &ret);
+        kh_value(cache->index, k) = off;
+        off += e->total;
+    }
+}
+
+static void openDynaCache(elfheader_t* h, dynacache_t* cache)
+{
+    dynacache_header_t head, filehead;
+    char path[PATH_MAX];
+    struct stat st;
+    if(fillHeader(h, &head) || getCachePath(h, path))
+        return;
+    int fd = open(path, O_RDWR|O_CREAT|O_APPEND|O_CLOEXEC, 0644);
+    if(fd<0) {
+        dynarec_log(LOG_INFO, "Warning, cannot open dynarec cache \"%s\" (%s)\n", path, strerror(errno));
+        return;
+    }
+    flock(fd, LOCK_EX);
+    int valid = !fstat(fd, &st) && (st.st_size>=(off_t)sizeof(head))
+        && (pread(fd, &filehead, sizeof(filehead), 0)==sizeof(filehead))
+        && !memcmp(&head, &filehead, sizeof(head));
+    if(!valid) {
+        // new cache, or elf / box86 changed: start again from scratch
+        if(ftruncate(fd, 0) || write(fd, &head, sizeof(head))!=sizeof(head)) {
+            dynarec_log(LOG_INFO, "Warning, cannot write dynarec cache \"%s\" (%s)\n", path, strerror(errno));
+            flock(fd, LOCK_UN);
+            close(fd);
+            return;
+        }
+        cache->filesz = sizeof(head);
+    } else {
+        cache->filesz = st.st_size;
+        cache->map = (uint8_t*)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(cache->map==MAP_FAILED)
+            cache->map = NULL;
+        else {
+            cache->mapsz = st.st_size;
+            indexDynaCache(cache);
+        }
+    }
+    flock(fd, LOCK_UN);
+    cache->fd = fd;
+    dynarec_log(LOG_INFO, "Using dynarec cache \"%s\" for %s (%d blocks)\n", path, h->name, cache->index?kh_size(cache->index):0);
+}
+
+static dynacache_t* getDynaCache(elfheader_t* h)
+{
+    pthread_mutex_lock(&mutex_dynacache);
+    if(!h->dynacache) {
+        dynacache_t* cache = (dynacache_t*)calloc(1, sizeof(dynacache_t));
+        cache->fd = -1;
+        pthread_mutex_init(&cache->mutex, NULL);
+        openDynaCache(h, cache);
+        h->dynacache = cache;
+    }
+    pthread_mutex_unlock(&mutex_dynacache);
+    return h->dynacache;
+}
+
+void FreeDynaCache(elfheader_t* h)
+{
+    dynacache_t* cache = h->dynacache;
+    if(!cache)
+        return;
+    dynarec_log(LOG_INFO, "Dynarec cache for %s: %d block(s) loaded, %d block(s) saved\n", h->name, cache->loaded, cache->saved);
+    if(cache->index)
+        kh_destroy(dynacache, cache->index);
+    if(cache->map)
+        munmap(cache->map, cache->mapsz);
+    if(cache->fd>=0)
+        close(cache->fd);
+    pthread_mutex_destroy(&cache->mutex);
+    free(cache);
+    h->dynacache = NULL;
+}
+
+// change the value loaded by a MOVW/MOVT pair
+static void patchMOV32(uint32_t* p, uint32_t val)
+{
+    p[0] = (p[0]&0xfff0f000) | ((val&0xf000)<<4) | (val&0x0fff);
+    val >>= 16;
+    p[1] = (p[1]&0xfff0f000) | ((val&0xf000)<<4) | (val&0x0fff);
+}
+
+void DynaCacheSave(dynablock_t* block, int instsize_sz, dynareloc_t* relocs, int relocs_sz)
+{
+    uintptr_t addr = (uintptr_t)block->x86_addr;
+    elfheader_t* h = FindElfAddress(my_context, addr);
+    if(!h || !IsAddressInElfSpace(h, addr+block->x86_size-1))
+        return;
+    dynacache_t* cache = getDynaCache(h);
+    if(cache->fd<0)
+        return;
+    if(cache->filesz>=(size_t)box86_dynarec_diskcache_mb*1024*1024)
+        return; // cache is full
+    uint32_t total = entrySize(block->size, instsize_sz, block->tablesz, block->sons_size, relocs_sz);
+    uint8_t* buff = (uint8_t*)calloc(1, total);
+    dynacache_entry_t* e = (dynacache_entry_t*)buff;
+    e->x86_addr = addr;
+    e->x86_size = block->x86_size;
+    e->hash = X31_hash_code(block->x86_addr, block->x86_size);
+    e->size = block->size;
+    e->isize = block->isize;
+    e->instsize_sz = instsize_sz;
+    e->tablesz = block->tablesz;
+    e->sons_size = block->sons_size;
+    e->relocs_size = relocs_sz;
+    e->total = total;
+    uint8_t* p = (uint8_t*)(e+1);
+    memcpy(p, block->block, block->size);
+    p += ALIGN4(block->size);
+    memcpy(p, block->instsize, instsize_sz);
+    p += ALIGN4(instsize_sz);
+    uint32_t* tableip = (uint32_t*)p;
+    for(int i=0; i<block->tablesz/4; ++i)
+        tableip[i] = block->table[i*4+1];
+    p += (block->tablesz/4)*sizeof(uint32_t);
+    uint32_t* sons = (uint32_t*)p;
+    for(int i=0; i<block->sons_size; ++i) {
+        sons[i*2+0] = (uintptr_t)block->sons[i]->x86_addr;
+        sons[i*2+1] = (uintptr_t)block->sons[i]->block - (uintptr_t)block->block;
+    }
+    p += block->sons_size*2*sizeof(uint32_t);
+    memcpy(p, relocs, relocs_sz*sizeof(dynareloc_t));
+
+    pthread_mutex_lock(&cache->mutex);
+    if(write(cache->fd, buff, total)==total) {
+        cache->filesz += total;
+        ++cache->saved;
+    } else {
+        dynarec_log(LOG_INFO, "Warning, failed to write in dynarec cache of %s, disabling it\n", h->name);
+        close(cache->fd);
+        cache->fd = -1;
+    }
+    pthread_mutex_unlock(&cache->mutex);
+    free(buff);
+}
+
+int DynaCacheLoad(dynablock_t* block, uintptr_t addr)
+{
+    if(block->parent->nolinker)
+        return 0;   // only static code is cached
+    elfheader_t* h = FindElfAddress(my_context, addr);
+    if(!h)
+        return 0;
+    dynacache_t* cache = getDynaCache(h);
+    if(!cache->index)
+        return 0;
+    khint_t k = kh_get(dynacache, cache->index, addr);
+    if(k==kh_end(cache->index))
+        return 0;
+    dynacache_entry_t* e = (dynacache_entry_t*)(cache->map+kh_value(cache->index, k));
+    if(e->total!=entrySize(e->size, e->instsize_sz, e->tablesz, e->sons_size, e->relocs_size) || !e->x86_size || !e->size)
+        return 0;
+    if(!IsAddressInElfSpace(h, addr+e->x86_size-1))
+        return 0;
+    if(X31_hash_code((void*)addr, e->x86_size)!=e->hash)
+        return 0;   // x86 code changed
+    uint8_t* p = (uint8_t*)(e+1);
+    uint8_t* code = p;
+    p += ALIGN4(e->size);
+    instsize_t* instsize = (instsize_t*)p;
+    p += ALIGN4(e->instsize_sz);
+    uint32_t* tableip = (uint32_t*)p;
+    p += (e->tablesz/4)*sizeof(uint32_t);
+    uint32_t* sonsinfo = (uint32_t*)p;
+    p += e->sons_size*2*sizeof(uint32_t);
+    dynareloc_t* relocs = (dynareloc_t*)p;
+    // check the native calls are still the same before doing anything
+    for(uint32_t i=0; i<e->relocs_size; ++i) {
+        if(relocs[i].offset+8>e->size)
+            return 0;
+        if(relocs[i].type==RELOC_NATCALL) {
+            int retn = 0;
+            uintptr_t natcall = 0;
+            if(!isNativeCall(NULL, relocs[i].ref, &natcall, &retn))
+                return 0;
+            if(getNativeCallSignature(natcall))
+                retn |= NATCALL_DIRECT; // the wrapper and its signature must still match too
+            if(retn!=relocs[i].extra)
+                return 0;
+        }
+    }
+    void* arm = (void*)AllocDynarecMap(e->size, block->parent->nolinker);
+    if(!arm)
+        return 0;
+    uintptr_t* table = NULL;
+    uintptr_t* patch = NULL;
+    if(e->tablesz) {
+        table = (uintptr_t*)calloc(e->tablesz, sizeof(uintptr_t));
+        for(uint32_t i=0; i<e->tablesz/4; ++i) {
+            table[i*4+0] = (uintptr_t)arm_linker;
+            table[i*4+1] = tableip[i];
+            table[i*4+2] = (uintptr_t)block;
+        }
+        if(box86_dynarec_hot && box86_dynarec_linker)
+            table[3] = box86_dynarec_hot;   // hit counter of the block (see hot_counter)
+    }
+    memcpy(arm, code, e->size);
+    for(uint32_t i=0; i<e->relocs_size; ++i) {
+        dynareloc_t* r = &relocs[i];
+        uintptr_t val = 0;
+        switch(r->type) {
+            case RELOC_TABLE:
+                val = (uintptr_t)table + r->addend;
+                // a jump to linker with a fixed ip has its patch slot just before
+                if(box86_dynarec_patch && r->offset>=4 && *(uint32_t*)(arm+r->offset-4)==0xe320f000) {
+                    if(!patch)
+                        patch = (uintptr_t*)calloc(e->tablesz/4, sizeof(uintptr_t));
+                    patch[r->addend/16] = (uintptr_t)arm+r->offset-4;
+                }
+                break;
+            case RELOC_BLOCK:
+                val = (uintptr_t)arm + r->addend;
+                break;
+            case RELOC_NATCALL:
+                isNativeCall(NULL, r->ref, &val, NULL);
+                val += r->addend;
+                break;
+        }
+        patchMOV32((uint32_t*)(arm+r->offset), val);
+    }
+    __clear_cache(arm, arm+e->size);
+    block->instsize = (instsize_t*)calloc(e->instsize_sz+1, sizeof(instsize_t));
+    memcpy(block->instsize, instsize, e->instsize_sz);
+    block->table = table;
+    block->tablesz = e->tablesz;
+    block->patch = patch;
+    block->size = e->size;
+    block->isize = e->isize;
+    block->block = arm;
+    setDynarecMapOwner((uintptr_t)arm, e->size, block);
+    block->nolinker = box86_dynarec_linker?0:1;
+    block->tier = 1;
+    block->need_test = 0;
+    block->x86_size = e->x86_size;
+    if(box86_dynarec_largest<block->x86_size)
+        box86_dynarec_largest = block->x86_size;
+    block->hash = block->nolinker?e->hash:0;
+    block->entry_flags = X_ALL;
+    // create the sons, the same way FillBlock does
+    if(e->sons_size) {
+        dynablock_t** sons = (dynablock_t**)calloc(e->sons_size, sizeof(dynablock_t*));
+        int sons_size = 0;
+        for(uint32_t i=0; i<e->sons_size; ++i) {
+            int created = 1;
+            dynablock_t *son = AddNewDynablock(block->parent, sonsinfo[i*2+0], &created);
+            if(son && (created || !son->parent)) {
+                son->block = arm+sonsinfo[i*2+1];
+                son->x86_addr = (void*)sonsinfo[i*2+0];
+                son->x86_size = addr+e->x86_size-sonsinfo[i*2+0];
+                son->father = block;
+                son->entry_flags = X_ALL;
+                son->done = 1;
+                sons[sons_size++] = son;
+                if(!son->parent)
+                    son->parent = block->parent;
+            }
+        }
+        if(sons_size) {
+            block->sons = sons;
+            block->sons_size = sons_size;
+        } else
+            free(sons);
+    }
+    pthread_mutex_lock(&cache->mutex);
+    ++cache->loaded;
+    pthread_mutex_unlock(&cache->mutex);
+    DynaEvictAdd(block);
+    PerfMapBlock(block);
+    GdbJitAddBlock(block);
+    __sync_synchronize();
+    block->done = 1;
+    return 1;
+}
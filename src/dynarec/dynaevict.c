@@ -0,0 +1,574 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <errno.h>
+
+#include "debug.h"
+#include "box86context.h"
+#include "dynarec.h"
+#include "emu/x86emu_private.h"
+#include "dynablock.h"
+#include "dynablock_private.h"
+#include "dynarec_private.h"
+#include "dynaevict.h"
+
+#include "khash.h"
+
+#define EMIT(A)     *(site) = (uint32_t)(A)
+#include "arm_emitter.h"
+
+KHASH_SET_INIT_INT(evicted)
+
+// ---- Links between blocks
+// Each linked jump table entry has the target (father) block in its 4th slot, and the target keeps the list of those entries.
+// So the links to a block can be reset before it's freed.
+// Only needed when blocks can go while still linked (code cache budget, single thread mode) or with patched links.
+static pthread_mutex_t mutex_links = PTHREAD_MUTEX_INITIALIZER;
+
+static int trackLinks()
+{
+    return box86_dynarec_cache_mb || box86_dynarec_patch || box86_lockelision;
+}
+
+static void addLink(dynablock_t* db, void** table)
+{
+    if(db->linkfrom_size==db->linkfrom_cap) {
+        db->linkfrom_cap += 8;
+        db->linkfrom = (void***)realloc(db->linkfrom, db->linkfrom_cap*sizeof(void**));
+    }
+    db->linkfrom[db->linkfrom_size++] = table;
+}
+
+static void removeLink(dynablock_t* db, void** table)
+{
+    for(int i=0; i<db->linkfrom_size; ++i)
+        if(db->linkfrom[i]==table) {
+            db->linkfrom[i] = db->linkfrom[--db->linkfrom_size];
+            return;
+        }
+}
+
+// the 1st entry of a block with a hit counter is not a link (see hot_counter)
+static int firstLinkEntry(dynablock_t* db)
+{
+    return (box86_dynarec_hot && db->tier==1 && !db->nolinker && db->tablesz)?1:0;
+}
+
+// with BOX86_DYNAREC_PATCH, the slot before the jump table load of a linked exit is a direct branch to the target
+// (a hint nop otherwise). Only B and NOP can be changed while they may be running, and only that word is flushed.
+static void patchLink(void** table, void* jumpto)
+{
+    dynablock_t* owner = (dynablock_t*)table[2];
+    if(!owner || !owner->patch)
+        return;
+    int idx = ((uintptr_t*)table-owner->table)/4;
+    if(!idx && firstLinkEntry(owner))
+        return;
+    uint32_t* site = (uint32_t*)owner->patch[idx];
+    if(!site)
+        return;
+    int32_t offset = (intptr_t)jumpto-((intptr_t)site+8);
+    if(jumpto && offset>=-0x2000000 && offset<0x2000000) {
+        Bcond(c__, offset);
+    } else {
+        NOP_HINT;   // too far (or unlinked), the jump table is used
+    }
+    __clear_cache(site, site+1);
+}
+
+void DynaLinkTable(void** table, void* jumpto, uintptr_t addr, dynablock_t* block)
+{
+    if(!trackLinks()) {
+        tableupdate(jumpto, addr, table);
+        return;
+    }
+    dynablock_t* father = block->father?block->father:block;
+    pthread_mutex_lock(&mutex_links);
+    if(!father->gone && !father->evicted) {
+        if(table[3]!=father) {
+            if(table[3])
+                removeLink((dynablock_t*)table[3], table);
+            addLink(father, table);
+            table[3] = father;
+        }
+        tableupdate(jumpto, addr, table);
+        patchLink(table, jumpto);
+    }
+    pthread_mutex_unlock(&mutex_links);
+}
+
+// reset all the links to db, mutex_links must be locked
+static void unlinkIncoming(dynablock_t* db)
+{
+    for(int i=0; i<db->linkfrom_size; ++i) {
+        patchLink(db->linkfrom[i], NULL);
+        resettable(db->linkfrom[i]);    // also clear the 4th slot
+    }
+    db->linkfrom_size = 0;
+}
+
+void DynaUnlinkBlock(dynablock_t* db)
+{
+    if(!trackLinks())
+        return;
+    pthread_mutex_lock(&mutex_links);
+    for(int i=firstLinkEntry(db); i<db->tablesz/4; ++i) {
+        void** table = (void**)&db->table[i*4];
+        if(table[3] && table[3]!=db)
+            removeLink((dynablock_t*)table[3], table);
+        table[3] = NULL;
+    }
+    unlinkIncoming(db);
+    free(db->linkfrom);
+    db->linkfrom = NULL;
+    db->linkfrom_cap = 0;
+    pthread_mutex_unlock(&mutex_links);
+}
+
+// ---- Code cache budget
+// Blocks are evicted, from the least recently used, when the budget is exceeded. An evicted block is removed from the
+// direct maps and unlinked, but it's only freed once all threads went back to their DynaCall/DynaRun loop (with no
+// native code that could return in it), forgetting their return stack on the way.
+// A nested DynaCall/DynaRun is quiescent too, except for the block each outer depth is in, that called the native
+// function coming back to x86 code (see DynaNativeEnter). Those blocks are kept until the outer depths are back.
+#define EVICT_DEPTH     16
+#define EVICT_NOBLOCK   ((dynablock_t*)1)   // the native function has not been called from a block
+typedef struct evictthread_s {
+    int                     depth;  // DynaCall/DynaRun depth
+    uint32_t                seen;   // last eviction epoch seen at a quiescent point
+    dynablock_t*            native; // block calling the current native function, NULL if unknown
+    dynablock_t*            entry[EVICT_DEPTH]; // block each outer depth is in (native when the next depth started)
+    x86emu_t*               emu[EVICT_DEPTH];   // emu running at each depth
+    struct evictthread_s*   next;
+} evictthread_t;
+
+typedef struct evicted_s {
+    dynablock_t*    db;
+    uint32_t        epoch;
+    uint32_t        size;   // still counted in evict_used
+} evicted_t;
+
+static pthread_mutex_t  mutex_evict = PTHREAD_MUTEX_INITIALIZER;
+static dynablock_t*     lru = NULL;             // all the fathers blocks
+static uint32_t         evict_used = 0;         // size of the code of the blocks in the list and of the evicted ones not freed yet
+static uint32_t         evict_pending = 0;      // size of the code of the evicted blocks not freed yet
+static uint32_t         evict_clock = 1;        // incremented at each eviction round
+static uint32_t         evict_epoch = 0;        // incremented when blocks are evicted
+static int              evict_needed = 0;
+static evicted_t*       evicted = NULL;         // evicted blocks waiting to be freed
+static int              evicted_size = 0;
+static int              evicted_cap = 0;
+static kh_evicted_t*    evicted_addr = NULL;    // x86 address of evicted blocks, to count re-translations
+static evictthread_t*   threads = NULL;
+static pthread_key_t    thread_key;
+static pthread_once_t   thread_key_once = PTHREAD_ONCE_INIT;
+static __thread evictthread_t* thread_rec = NULL;
+// stats
+static uint32_t         stat_rounds = 0, stat_evicted = 0, stat_evictedsize = 0, stat_retranslated = 0, stat_freed = 0;
+
+static void thread_rec_destroy(void* p)
+{
+    evictthread_t* rec = (evictthread_t*)p;
+    pthread_mutex_lock(&mutex_evict);
+    evictthread_t** prev = &threads;
+    while(*prev && *prev!=rec)
+        prev = &(*prev)->next;
+    if(*prev)
+        *prev = rec->next;
+    pthread_mutex_unlock(&mutex_evict);
+    free(rec);
+}
+static void evictChild()
+{
+    // only the current thread survives a fork
+    pthread_mutex_init(&mutex_evict, NULL);
+    pthread_mutex_init(&mutex_links, NULL);
+    threads = thread_rec;
+    if(thread_rec)
+        thread_rec->next = NULL;
+}
+static void evictPrepare()
+{
+    pthread_mutex_lock(&mutex_evict);
+}
+static void evictParent()
+{
+    pthread_mutex_unlock(&mutex_evict);
+}
+static void thread_key_alloc()
+{
+    pthread_key_create(&thread_key, thread_rec_destroy);
+    pthread_atfork(evictPrepare, evictParent, evictChild);
+}
+static evictthread_t* getThreadRec()
+{
+    if(!thread_rec) {
+        pthread_once(&thread_key_once, thread_key_alloc);
+        evictthread_t* rec = (evictthread_t*)calloc(1, sizeof(evictthread_t));
+        pthread_mutex_lock(&mutex_evict);
+        rec->seen = evict_epoch;
+        rec->next = threads;
+        threads = rec;
+        pthread_mutex_unlock(&mutex_evict);
+        pthread_setspecific(thread_key, rec);
+        thread_rec = rec;
+    }
+    return thread_rec;
+}
+
+int DynaGetDepth()
+{
+    if(!box86_dynarec_cache_mb)
+        return 0;
+    evictthread_t* rec = getThreadRec();
+    if(rec->depth && rec->depth<EVICT_DEPTH)
+        rec->entry[rec->depth] = rec->native;   // a new depth starts, from the native function called by that block
+    return rec->depth;
+}
+void DynaSetDepth(int depth)
+{
+    if(!box86_dynarec_cache_mb)
+        return;
+    getThreadRec()->depth = depth;
+}
+
+dynablock_t* DynaNativeEnter(void* ret)
+{
+    if(!box86_dynarec_cache_mb)
+        return NULL;
+    evictthread_t* rec = getThreadRec();
+    dynablock_t* old = rec->native;
+    dynablock_t* db = FindDynablockFromNativeAddress(ret);
+    rec->native = db?db:EVICT_NOBLOCK;
+    return old;
+}
+void DynaNativeLeave(dynablock_t* old)
+{
+    if(!box86_dynarec_cache_mb)
+        return;
+    getThreadRec()->native = old;
+}
+
+// mutex_evict must be locked
+static void lruRemove(dynablock_t* db)
+{
+    if(db->lru_prev)
+        db->lru_prev->lru_next = db->lru_next;
+    else
+        lru = db->lru_next;
+    if(db->lru_next)
+        db->lru_next->lru_prev = db->lru_prev;
+    db->lru_prev = db->lru_next = NULL;
+    db->inlru = 0;
+    evict_used -= db->size;
+}
+
+static void forgetReturnStack(x86emu_t* emu)
+{
+    emu->cstacki = 0;
+    memset(emu->cstack, 0, sizeof(emu->cstack));
+}
+
+void DynaEvictAdd(dynablock_t* db)
+{
+    if(!box86_dynarec_cache_mb || db->father || !db->block)
+        return;
+    pthread_mutex_lock(&mutex_evict);
+    db->lastuse = evict_clock;
+    db->lru_prev = NULL;
+    db->lru_next = lru;
+    if(lru)
+        lru->lru_prev = db;
+    lru = db;
+    db->inlru = 1;
+    evict_used += db->size;
+    if(evicted_addr) {
+        khint_t k = kh_get(evicted, evicted_addr, (uintptr_t)db->x86_addr);
+        if(k!=kh_end(evicted_addr)) {
+            ++stat_retranslated;
+            kh_del(evicted, evicted_addr, k);
+        }
+    }
+    // the evicted blocks not freed yet count, but only the blocks still in the list can be evicted
+    if(evict_used>(uint32_t)box86_dynarec_cache_mb*1024*1024 && evict_used-evict_pending>(uint32_t)box86_dynarec_cache_mb*1024*1024/4*3)
+        evict_needed = 1;
+    pthread_mutex_unlock(&mutex_evict);
+}
+
+void DynaEvictRemove(dynablock_t* db)
+{
+    if(!db->inlru)
+        return;
+    pthread_mutex_lock(&mutex_evict);
+    if(db->inlru)
+        lruRemove(db);
+    pthread_mutex_unlock(&mutex_evict);
+}
+
+void DynaEvictTouch(dynablock_t* db)
+{
+    if(db->father)
+        db = db->father;
+    db->lastuse = evict_clock;
+}
+
+static void removeDirect(dynablock_t* db)
+{
+    dynablocklist_t* dynablocks = db->parent;
+    if(dynablocks && dynablocks->direct) {
+        uintptr_t addr = (uintptr_t)db->x86_addr;
+        dynablock_t** slot = (addr>=dynablocks->text && addr<dynablocks->text+dynablocks->textsz)?getDirectSlot(dynablocks, addr, 0):NULL;
+        if(slot && *slot==db)
+            *slot = NULL;
+    }
+}
+
+// remove the block from the direct maps and unlink it, it will be freed later. mutex_evict must be locked
+static void retireBlock(dynablock_t* db)
+{
+    uint32_t size = 0;
+    if(db->inlru) {
+        lruRemove(db);
+        size = db->size;    // counted until really freed
+        evict_used += size;
+        evict_pending += size;
+    }
+    // lower tier blocks are still linked and redirect to this one, and may still own some sons
+    pthread_mutex_lock(&mutex_links);
+    for(dynablock_t* b=db; b; b=b->previous) {
+        removeDirect(b);
+        b->evicted = 1;
+        for(int i=0; i<b->sons_size; ++i)
+            if(b->sons[i]) {
+                removeDirect(b->sons[i]);
+                b->sons[i]->evicted = 1;
+            }
+        unlinkIncoming(b);
+        IBTCRemove(b);
+    }
+    pthread_mutex_unlock(&mutex_links);
+    if(evicted_size==evicted_cap) {
+        evicted_cap += 64;
+        evicted = (evicted_t*)realloc(evicted, evicted_cap*sizeof(evicted_t));
+    }
+    evicted[evicted_size].db = db;
+    evicted[evicted_size].epoch = evict_epoch+1;
+    evicted[evicted_size].size = size;
+    ++evicted_size;
+}
+
+// mutex_evict must be locked
+static void evictBlock(dynablock_t* db)
+{
+    dynarec_log(LOG_DEBUG, "Evicting block %p from %p:%p (%d bytes, last used %u/%u)\n", db, db->x86_addr, db->x86_addr+db->x86_size, db->size, db->lastuse, evict_clock);
+    retireBlock(db);
+    if(!evicted_addr)
+        evicted_addr = kh_init(evicted);
+    int ret;
+    kh_put(evicted, evicted_addr, (uintptr_t)db->x86_addr, &ret);
+    ++stat_evicted;
+    stat_evictedsize += db->size;
+}
+
+static int cmpLastUse(const void* a, const void* b)
+{
+    dynablock_t* db1 = *(dynablock_t**)a;
+    dynablock_t* db2 = *(dynablock_t**)b;
+    if(db1->lastuse!=db2->lastuse)
+        return (db1->lastuse<db2->lastuse)?-1:1;
+    return 0;
+}
+
+// mutex_evict must be locked
+static void evictRound()
+{
+    evict_needed = 0;
+    uint32_t target = (uint32_t)box86_dynarec_cache_mb*1024*1024/4*3;
+    int n = 0;
+    for(dynablock_t* db=lru; db; db=db->lru_next)
+        ++n;
+    dynablock_t** list = (dynablock_t**)malloc(n*sizeof(dynablock_t*));
+    n = 0;
+    for(dynablock_t* db=lru; db; db=db->lru_next)
+        if(!db->gone && !db->tiered && !db->async && db->done)
+            list[n++] = db;
+    // oldest first (the list is from the most recent, so block age is used for the same last use)
+    qsort(list, n, sizeof(dynablock_t*), cmpLastUse);
+    int i = 0;
+    uint32_t old = stat_evicted;
+    while(i<n && evict_used-evict_pending>target && list[i]->lastuse<evict_clock)
+        evictBlock(list[i++]);
+    // second chance: unlink the blocks not seen since last round, so their next use goes through the linker and is noticed
+    pthread_mutex_lock(&mutex_links);
+    for(; i<n && list[i]->lastuse<evict_clock; ++i) {
+        unlinkIncoming(list[i]);
+        IBTCRemove(list[i]);
+    }
+    pthread_mutex_unlock(&mutex_links);
+    free(list);
+    ++stat_rounds;
+    ++evict_clock;
+    if(stat_evicted!=old)
+        ++evict_epoch;
+    dynarec_log(LOG_INFO, "Dynarec cache: evicted %u block(s), %uKB of code left (%uKB to be freed)\n", stat_evicted-old, (evict_used-evict_pending)/1024, evict_pending/1024);
+}
+
+// an outer depth of a thread is in that block (or one of its lower tiers), mutex_evict must be locked
+static int pinnedBlock(dynablock_t* db)
+{
+    for(evictthread_t* rec=threads; rec; rec=rec->next)
+        for(int d=1; d<rec->depth && d<EVICT_DEPTH; ++d)
+            for(dynablock_t* b=db; b; b=b->previous)
+                if(rec->entry[d]==b)
+                    return 1;
+    return 0;
+}
+
+// mutex_evict must be locked, return the number of blocks that can be freed (moved at the start of evicted)
+static int reclaimable()
+{
+    if(!evicted_size)
+        return 0;
+    uint32_t acked = evict_epoch;
+    for(evictthread_t* rec=threads; rec; rec=rec->next)
+        if(rec->depth && rec->seen<acked)
+            acked = rec->seen;
+    int n = 0;
+    for(int i=0; i<evicted_size; ++i)
+        if(evicted[i].epoch<=acked && !pinnedBlock(evicted[i].db)) {
+            evicted_t tmp = evicted[n];
+            evicted[n++] = evicted[i];
+            evicted[i] = tmp;
+        }
+    return n;
+}
+
+// forget the return stacks of all the depths, the ones of the outer depths are used when they are back
+static void ackEpoch(evictthread_t* rec, int depth)
+{
+    for(int d=1; d<=depth; ++d)
+        forgetReturnStack(rec->emu[d-1]);
+    rec->seen = evict_epoch;
+}
+
+void DynaQuiescent(x86emu_t* emu, int depth)
+{
+    if(!box86_dynarec_cache_mb)
+        return;
+    evictthread_t* rec = getThreadRec();
+    rec->depth = depth;
+    if(depth>EVICT_DEPTH)
+        return;
+    rec->emu[depth-1] = emu;
+    if(depth==1)
+        rec->native = NULL; // nothing left from a native function that didn't return (longjmp)
+    // the block of an outer depth is known only if it was entered from DynaNativeEnter
+    for(int d=1; d<depth; ++d)
+        if(!rec->entry[d])
+            return;
+    if(rec->seen!=evict_epoch) {
+        // some blocks have been evicted, the return stacks may point to them
+        ackEpoch(rec, depth);
+    }
+    if(!evict_needed && !evicted_size)
+        return;
+    if(pthread_mutex_trylock(&mutex_evict))
+        return; // someone else is doing it
+    if(evict_needed) {
+        evictRound();
+        // this thread is quiescent, no need to wait for it
+        ackEpoch(rec, depth);
+    }
+    int n = reclaimable();
+    dynablock_t** list = NULL;
+    if(n) {
+        list = (dynablock_t**)malloc(n*sizeof(dynablock_t*));
+        for(int i=0; i<n; ++i) {
+            list[i] = evicted[i].db;
+            evict_used -= evicted[i].size;
+            evict_pending -= evicted[i].size;
+        }
+        memmove(evicted, evicted+n, (evicted_size-n)*sizeof(evicted_t));
+        evicted_size -= n;
+    }
+    pthread_mutex_unlock(&mutex_evict);
+    // evicted flag is kept, so FreeDynablock doesn't look at the direct map (that may be gone with its library)
+    for(int i=0; i<n; ++i)
+        FreeDynablock(list[i]);
+    stat_freed += n;
+    free(list);
+}
+
+// ---- Single thread mode (BOX86_LOCKELISION)
+// Blocks built while there was only one thread can have plain LOCK'd operations. They are all evicted when another
+// thread is created, the same way as for the code cache budget (so without budget, they are only freed at exit).
+static int nolockBlock(dynablock_t* db)
+{
+    for(dynablock_t* b=db; b; b=b->previous)
+        if(b->nolock)
+            return 1;
+    return 0;
+}
+
+void DynaEvictNoLock(x86emu_t* emu)
+{
+    int n = 0;
+    pthread_mutex_lock(&mutex_evict);
+    for(int i=0; i<DYNAMAP_L1SIZE; ++i) {
+        dynmap_t** table = my_context->dynmap[i];
+        if(!table)
+            continue;
+        for(int j=0; j<DYNAMAP_L2SIZE; ++j) {
+            dynablocklist_t* dynablocks = table[j]?table[j]->dynablocks:NULL;
+            if(!dynablocks || !dynablocks->direct)
+                continue;
+            for(int k=0; k<DIRECT_CHUNKS(dynablocks->textsz); ++k) {
+                dynablock_t** chunk = dynablocks->direct[k];
+                if(chunk)
+                    for(int l=0; l<DIRECT_SIZE; ++l) {
+                        dynablock_t* db = chunk[l];
+                        if(db && !db->father && db->done && !db->gone && !db->evicted && nolockBlock(db)) {
+                            retireBlock(db);
+                            ++n;
+                        }
+                    }
+            }
+        }
+    }
+    if(n)
+        ++evict_epoch;
+    pthread_mutex_unlock(&mutex_evict);
+    if(emu) {
+        // the return stack of the creating thread may point to them
+        forgetReturnStack(emu);
+    }
+    dynarec_log(LOG_INFO, "Dynarec: %d block(s) with plain LOCK'd operations evicted\n", n);
+}
+
+void FiniDynaEvict()
+{
+    // at exit, nothing runs anymore
+    pthread_mutex_lock(&mutex_evict);
+    int n = evicted_size;
+    evicted_t* list = evicted;
+    evicted = NULL;
+    evicted_size = evicted_cap = 0;
+    evict_used -= evict_pending;
+    evict_pending = 0;
+    if(evicted_addr)
+        kh_destroy(evicted, evicted_addr);
+    evicted_addr = NULL;
+    pthread_mutex_unlock(&mutex_evict);
+    for(int i=0; i<n; ++i)
+        FreeDynablock(list[i].db);
+    free(list);
+}
+
+void PrintDynaEvictStats()
+{
+    if(!box86_dynarec_cache_mb)
+        return;
+    printf_log(LOG_NONE, "Dynarec cache: %uKB of code (%uKB evicted, not freed yet) for a budget of %dMB, %u eviction round(s), %u block(s) evicted (%uKB), %u freed, %u re-translated\n",
+        evict_used/1024, evict_pending/1024, box86_dynarec_cache_mb, stat_rounds, stat_evicted, stat_evictedsize/1024, stat_freed, stat_retranslated);
+}
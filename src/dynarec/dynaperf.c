@@ -0,0 +1,443 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <elf.h>
+
+#include "debug.h"
+#include "box86context.h"
+#include "elfloader.h"
+#include "x86run.h"
+#include "dynablock.h"
+#include "dynablock_private.h"
+#include "dynaperf.h"
+
+// BOX86_PERFMAP=1: a line per block in /tmp/perf-<pid>.map, that perf report reads as is
+// BOX86_PERFMAP=2: a jitdump in /tmp/jit-<pid>.dump, with the code and a "line" per x86 instruction (the x86 address)
+//  to use with "perf record -k mono" then "perf inject --jit"
+
+#define JITDUMP_MAGIC       0x4A695444
+#define JITDUMP_VERSION     1
+#define JIT_CODE_LOAD       0
+#define JIT_CODE_DEBUG_INFO 2
+#define JIT_EM_ARM          40
+
+typedef struct jitheader_s {
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    total_size;
+    uint32_t    elf_mach;
+    uint32_t    pad1;
+    uint32_t    pid;
+    uint64_t    timestamp;
+    uint64_t    flags;
+} jitheader_t;
+
+typedef struct jitrecord_s {
+    uint32_t    id;
+    uint32_t    total_size;
+    uint64_t    timestamp;
+} jitrecord_t;
+
+typedef struct jitcodeload_s {
+    jitrecord_t p;
+    uint32_t    pid;
+    uint32_t    tid;
+    uint64_t    vma;
+    uint64_t    code_addr;
+    uint64_t    code_size;
+    uint64_t    code_index;
+    // followed by the name and the code
+} jitcodeload_t;
+
+typedef struct jitdebuginfo_s {
+    jitrecord_t p;
+    uint64_t    code_addr;
+    uint64_t    nr_entry;
+    // followed by the entries
+} jitdebuginfo_t;
+
+typedef struct jitdebugentry_s {
+    uint64_t    addr;
+    uint32_t    lineno;
+    uint32_t    discrim;
+    // followed by the file name
+} jitdebugentry_t;
+
+static pthread_mutex_t mutex_perf = PTHREAD_MUTEX_INITIALIZER;
+static FILE*    perfmap = NULL;
+static int      jitdump = -1;
+static void*    jitmark = NULL;     // perf finds the jitdump with the mmap of it
+static uint64_t code_index = 0;
+static int      failed = 0;
+
+static uint64_t perf_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec*1000000000LL+ts.tv_nsec;
+}
+
+static void writeAll(const void* p, size_t sz)
+{
+    while(sz) {
+        ssize_t r = write(jitdump, p, sz);
+        if(r<=0)
+            return;
+        p += r;
+        sz -= r;
+    }
+}
+
+static int openPerf()
+{
+    char path[64];
+    if(box86_perfmap==1) {
+        snprintf(path, sizeof(path), "/tmp/perf-%d.map", getpid());
+        perfmap = fopen(path, "a");
+        if(!perfmap) {
+            printf_log(LOG_NONE, "Warning, cannot open %s for the perf map\n", path);
+            return 0;
+        }
+    } else {
+        snprintf(path, sizeof(path), "/tmp/jit-%d.dump", getpid());
+        jitdump = open(path, O_CREAT|O_TRUNC|O_RDWR, 0666);
+        if(jitdump<0) {
+            printf_log(LOG_NONE, "Warning, cannot open %s for the jitdump\n", path);
+            return 0;
+        }
+        jitheader_t h = {0};
+        h.magic = JITDUMP_MAGIC;
+        h.version = JITDUMP_VERSION;
+        h.total_size = sizeof(h);
+        h.elf_mach = JIT_EM_ARM;
+        h.pid = getpid();
+        h.timestamp = perf_ns();
+        writeAll(&h, sizeof(h));
+        jitmark = mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ|PROT_EXEC, MAP_PRIVATE, jitdump, 0);
+        if(jitmark==MAP_FAILED) {
+            jitmark = NULL;
+            printf_log(LOG_NONE, "Warning, cannot mmap %s, perf will not find it\n", path);
+        }
+    }
+    printf_log(LOG_INFO, "Writing the translated blocks in %s\n", path);
+    return 1;
+}
+
+// x86 function of addr, as "elf/symbol+offset"
+static void blockName(char* buff, int sz, uintptr_t addr)
+{
+    elfheader_t* h = FindElfAddress(my_context, addr);
+    uintptr_t start = 0;
+    uint32_t ssz = 0;
+    const char* symbname = h?FindNearestSymbolName(h, (void*)addr, &start, &ssz):NULL;
+    if(symbname && addr>=start && (addr<(start+ssz) || !ssz)) {
+        if(addr==start)
+            snprintf(buff, sz, "x86:%s/%s", ElfName(h), symbname);
+        else
+            snprintf(buff, sz, "x86:%s/%s+0x%zx", ElfName(h), symbname, (size_t)(addr-start));
+    } else
+        snprintf(buff, sz, "x86:%p", (void*)addr);
+}
+
+static void jitdumpBlock(dynablock_t* block, const char* name)
+{
+    uintptr_t arm = (uintptr_t)block->block;
+    elfheader_t* h = FindElfAddress(my_context, (uintptr_t)block->x86_addr);
+    const char* file = h?ElfName(h):"x86";
+    int filesz = strlen(file)+1;
+    // debug info first, one entry per x86 instruction (an instruction can use more than 1 instsize)
+    uint64_t nr = 0;
+    for(instsize_t* i=block->instsize; i && i->c; ++i)
+        if(i->x86)
+            ++nr;
+    uint64_t ts = perf_ns();
+    if(nr) {
+        jitdebuginfo_t d = {0};
+        d.p.id = JIT_CODE_DEBUG_INFO;
+        d.p.total_size = sizeof(d)+nr*(sizeof(jitdebugentry_t)+filesz);
+        d.p.timestamp = ts;
+        d.code_addr = arm;
+        d.nr_entry = nr;
+        writeAll(&d, sizeof(d));
+        uintptr_t x86 = (uintptr_t)block->x86_addr;
+        uintptr_t nat = arm;
+        for(instsize_t* i=block->instsize; i->c; ++i) {
+            if(i->x86) {
+                jitdebugentry_t e = {0};
+                e.addr = nat;
+                e.lineno = x86;
+                writeAll(&e, sizeof(e));
+                writeAll(file, filesz);
+            }
+            x86 += i->x86;
+            nat += i->nat*4;
+        }
+    }
+    int namesz = strlen(name)+1;
+    jitcodeload_t c = {0};
+    c.p.id = JIT_CODE_LOAD;
+    c.p.total_size = sizeof(c)+namesz+block->size;
+    c.p.timestamp = ts;
+    c.pid = getpid();
+    c.tid = GetTID();
+    c.vma = arm;
+    c.code_addr = arm;
+    c.code_size = block->size;
+    c.code_index = code_index++;
+    writeAll(&c, sizeof(c));
+    writeAll(name, namesz);
+    writeAll(block->block, block->size);
+}
+
+void PerfMapBlock(dynablock_t* block)
+{
+    if(!box86_perfmap || !block->block || !block->size)
+        return;
+    char name[512];
+    blockName(name, sizeof(name), (uintptr_t)block->x86_addr);
+    pthread_mutex_lock(&mutex_perf);
+    if(!perfmap && jitdump<0 && !failed)
+        failed = openPerf()?0:1;
+    if(perfmap) {
+        fprintf(perfmap, "%x %x %s\n", (uint32_t)(uintptr_t)block->block, block->size, name);
+        fflush(perfmap);
+    } else if(jitdump>=0)
+        jitdumpBlock(block, name);
+    pthread_mutex_unlock(&mutex_perf);
+}
+
+// GDB JIT interface: gdb breaks in __jit_debug_register_code, and reads the in-memory ELF objects listed in __jit_debug_descriptor
+// Each object has a batch of blocks, with a NOBITS .text section at the address of each block, and a symbol for it
+typedef enum {
+    JIT_NOACTION = 0,
+    JIT_REGISTER_FN,
+    JIT_UNREGISTER_FN
+} jit_actions_t;
+
+struct jit_code_entry {
+    struct jit_code_entry*  next_entry;
+    struct jit_code_entry*  prev_entry;
+    const char*             symfile_addr;
+    uint64_t                symfile_size;
+};
+
+struct jit_descriptor {
+    uint32_t                version;
+    uint32_t                action_flag;
+    struct jit_code_entry*  relevant_entry;
+    struct jit_code_entry*  first_entry;
+};
+
+void __attribute__((noinline, used)) __jit_debug_register_code()
+{
+    __asm__ __volatile__("");
+}
+struct jit_descriptor __jit_debug_descriptor = { 1, JIT_NOACTION, NULL, NULL };
+
+#define GDBJIT_BATCH    32
+
+typedef struct gdbjit_s {
+    struct jit_code_entry   entry;
+    int                     registered;
+    int                     n;
+    dynablock_t*            blocks[GDBJIT_BATCH];
+} gdbjit_t;
+
+static pthread_mutex_t mutex_gdbjit = PTHREAD_MUTEX_INITIALIZER;
+static gdbjit_t* gdbjit_pending = NULL;
+
+static void gdbjitBuildElf(gdbjit_t* g)
+{
+    static const char shstrtab[] = "\0.text\0.shstrtab\0.strtab\0.symtab";
+    char (*names)[256] = malloc(g->n*sizeof(*names));
+    int strsz = 1;
+    for(int i=0; i<g->n; ++i) {
+        blockName(names[i], sizeof(names[i]), (uintptr_t)g->blocks[i]->x86_addr);
+        strsz += strlen(names[i])+1;
+    }
+    int nsect = g->n+4; // null, the .text, .shstrtab, .strtab, .symtab
+    int shstr_off = sizeof(Elf32_Ehdr)+nsect*sizeof(Elf32_Shdr);
+    int str_off = shstr_off+sizeof(shstrtab);
+    int sym_off = (str_off+strsz+3)&~3;
+    int size = sym_off+(g->n+1)*sizeof(Elf32_Sym);
+    char* elf = (char*)calloc(1, size);
+    Elf32_Ehdr* eh = (Elf32_Ehdr*)elf;
+    memcpy(eh->e_ident, ELFMAG, SELFMAG);
+    eh->e_ident[EI_CLASS] = ELFCLASS32;
+    eh->e_ident[EI_DATA] = ELFDATA2LSB;
+    eh->e_ident[EI_VERSION] = EV_CURRENT;
+    eh->e_type = ET_REL;
+    eh->e_machine = EM_ARM;
+    eh->e_version = EV_CURRENT;
+    eh->e_flags = EF_ARM_EABI_VER5;
+    eh->e_ehsize = sizeof(Elf32_Ehdr);
+    eh->e_shoff = sizeof(Elf32_Ehdr);
+    eh->e_shentsize = sizeof(Elf32_Shdr);
+    eh->e_shnum = nsect;
+    eh->e_shstrndx = g->n+1;
+    Elf32_Shdr* sh = (Elf32_Shdr*)(elf+eh->e_shoff);
+    for(int i=0; i<g->n; ++i) {
+        sh[i+1].sh_name = 1;    // .text
+        sh[i+1].sh_type = SHT_NOBITS;
+        sh[i+1].sh_flags = SHF_ALLOC|SHF_EXECINSTR;
+        sh[i+1].sh_addr = (uintptr_t)g->blocks[i]->block;
+        sh[i+1].sh_size = g->blocks[i]->size;
+        sh[i+1].sh_addralign = 4;
+    }
+    sh[g->n+1].sh_name = 7;     // .shstrtab
+    sh[g->n+1].sh_type = SHT_STRTAB;
+    sh[g->n+1].sh_offset = shstr_off;
+    sh[g->n+1].sh_size = sizeof(shstrtab);
+    sh[g->n+2].sh_name = 17;    // .strtab
+    sh[g->n+2].sh_type = SHT_STRTAB;
+    sh[g->n+2].sh_offset = str_off;
+    sh[g->n+2].sh_size = strsz;
+    sh[g->n+3].sh_name = 25;    // .symtab
+    sh[g->n+3].sh_type = SHT_SYMTAB;
+    sh[g->n+3].sh_offset = sym_off;
+    sh[g->n+3].sh_size = (g->n+1)*sizeof(Elf32_Sym);
+    sh[g->n+3].sh_link = g->n+2;
+    sh[g->n+3].sh_info = 1;     // first global symbol
+    sh[g->n+3].sh_addralign = 4;
+    sh[g->n+3].sh_entsize = sizeof(Elf32_Sym);
+    memcpy(elf+shstr_off, shstrtab, sizeof(shstrtab));
+    Elf32_Sym* sym = (Elf32_Sym*)(elf+sym_off);
+    char* str = elf+str_off;
+    int stri = 1;
+    for(int i=0; i<g->n; ++i) {
+        sym[i+1].st_name = stri;
+        sym[i+1].st_value = 0;  // start of its section
+        sym[i+1].st_size = g->blocks[i]->size;
+        sym[i+1].st_info = ELF32_ST_INFO(STB_GLOBAL, STT_FUNC);
+        sym[i+1].st_shndx = i+1;
+        strcpy(str+stri, names[i]);
+        stri += strlen(names[i])+1;
+    }
+    free(names);
+    free((void*)g->entry.symfile_addr);
+    g->entry.symfile_addr = elf;
+    g->entry.symfile_size = size;
+}
+
+static void gdbjitRegister(gdbjit_t* g)
+{
+    gdbjitBuildElf(g);
+    g->entry.prev_entry = NULL;
+    g->entry.next_entry = __jit_debug_descriptor.first_entry;
+    if(g->entry.next_entry)
+        g->entry.next_entry->prev_entry = &g->entry;
+    __jit_debug_descriptor.first_entry = &g->entry;
+    __jit_debug_descriptor.relevant_entry = &g->entry;
+    __jit_debug_descriptor.action_flag = JIT_REGISTER_FN;
+    __jit_debug_register_code();
+    g->registered = 1;
+}
+
+static void gdbjitUnregister(gdbjit_t* g)
+{
+    if(g->entry.prev_entry)
+        g->entry.prev_entry->next_entry = g->entry.next_entry;
+    else
+        __jit_debug_descriptor.first_entry = g->entry.next_entry;
+    if(g->entry.next_entry)
+        g->entry.next_entry->prev_entry = g->entry.prev_entry;
+    __jit_debug_descriptor.relevant_entry = &g->entry;
+    __jit_debug_descriptor.action_flag = JIT_UNREGISTER_FN;
+    __jit_debug_register_code();
+    g->registered = 0;
+}
+
+void GdbJitAddBlock(dynablock_t* block)
+{
+    if(!box86_dynarec_gdbjit || !block->block || !block->size)
+        return;
+    pthread_mutex_lock(&mutex_gdbjit);
+    if(!gdbjit_pending)
+        gdbjit_pending = (gdbjit_t*)calloc(1, sizeof(gdbjit_t));
+    gdbjit_t* g = gdbjit_pending;
+    g->blocks[g->n++] = block;
+    block->gdbjit = g;
+    if(g->n==GDBJIT_BATCH || box86_dynarec_gdbjit==2) {
+        gdbjitRegister(g);
+        gdbjit_pending = NULL;
+    }
+    pthread_mutex_unlock(&mutex_gdbjit);
+}
+
+void GdbJitRemoveBlock(dynablock_t* block)
+{
+    if(!block->gdbjit)
+        return;
+    pthread_mutex_lock(&mutex_gdbjit);
+    gdbjit_t* g = (gdbjit_t*)block->gdbjit;
+    block->gdbjit = NULL;
+    for(int i=0; i<g->n; ++i)
+        if(g->blocks[i]==block) {
+            g->blocks[i] = g->blocks[--g->n];
+            break;
+        }
+    // the object is built again without the block (its memory can be reused by another block)
+    if(g->registered) {
+        gdbjitUnregister(g);
+        if(g->n)
+            gdbjitRegister(g);
+    }
+    if(!g->n && g!=gdbjit_pending) {
+        free((void*)g->entry.symfile_addr);
+        free(g);
+    }
+    pthread_mutex_unlock(&mutex_gdbjit);
+}
+
+void GdbJitFlush()
+{
+    if(!box86_dynarec_gdbjit || pthread_mutex_trylock(&mutex_gdbjit))
+        return;
+    if(gdbjit_pending && gdbjit_pending->n) {
+        gdbjitRegister(gdbjit_pending);
+        gdbjit_pending = NULL;
+    }
+    pthread_mutex_unlock(&mutex_gdbjit);
+}
+
+void FiniDynaPerf()
+{
+    // the blocks are freed after this, so they must forget their GDB JIT object
+    pthread_mutex_lock(&mutex_gdbjit);
+    if(gdbjit_pending) {
+        for(int i=0; i<gdbjit_pending->n; ++i)
+            gdbjit_pending->blocks[i]->gdbjit = NULL;
+        free(gdbjit_pending);
+        gdbjit_pending = NULL;
+    }
+    while(__jit_debug_descriptor.first_entry) {
+        gdbjit_t* g = (gdbjit_t*)__jit_debug_descriptor.first_entry;
+        gdbjitUnregister(g);
+        for(int i=0; i<g->n; ++i)
+            g->blocks[i]->gdbjit = NULL;
+        free((void*)g->entry.symfile_addr);
+        free(g);
+    }
+    pthread_mutex_unlock(&mutex_gdbjit);
+    pthread_mutex_lock(&mutex_perf);
+    if(perfmap) {
+        fclose(perfmap);
+        perfmap = NULL;
+    }
+    if(jitmark) {
+        munmap(jitmark, sysconf(_SC_PAGESIZE));
+        jitmark = NULL;
+    }
+    if(jitdump>=0) {
+        close(jitdump);
+        jitdump = -1;
+    }
+    failed = 1; // no more blocks after that
+    pthread_mutex_unlock(&mutex_perf);
+}
@@ -19,6 +19,8 @@
 #ifdef DYNAREC
 #include "dynablock.h"
 #include "dynablock_private.h"
+#include "dynaevict.h"
+#include "arm_lock_helper.h"
 #endif
 
 #ifdef ARM
@@ -51,11 +53,70 @@ void resettable(void** table)
 }
 
 #ifdef DYNAREC
+uintptr_t arm_ibtc[IBTC_SIZE*2] __attribute__((aligned(8))) = {0};
+uint32_t arm_ibtc_hits = 0;
+uint32_t arm_ibtc_misses = 0;
+static uint32_t ibtc_fills = 0;
+
+void IBTCAdd(uintptr_t addr, void* native)
+{
+    uintptr_t* entry = &arm_ibtc[(addr&(IBTC_SIZE-1))*2];
+    if(entry[0]==addr && entry[1]==(uintptr_t)native)
+        return;
+    uint32_t a, b;
+    do {
+        arm_lock_read_dd(&a, &b, entry);
+    } while(arm_lock_write_dd(addr, (uintptr_t)native, entry));
+    ++ibtc_fills;
+}
+
+static void removeIBTC(uintptr_t* entry, uintptr_t start, uintptr_t end)
+{
+    uint32_t a, b;
+    do {
+        arm_lock_read_dd(&a, &b, entry);
+        if(b<start || b>=end)
+            return; // not (anymore) in the block
+    } while(arm_lock_write_dd(0, 0, entry));
+}
+
+void IBTCRemove(dynablock_t* db)
+{
+    if(!box86_dynarec_ibtc || !db->block)
+        return;
+    uintptr_t start = (uintptr_t)db->block;
+    uintptr_t end = start+db->size;
+    if(db->x86_size>=IBTC_SIZE) {
+        for(int i=0; i<IBTC_SIZE; ++i)
+            removeIBTC(&arm_ibtc[i*2], start, end);
+    } else {
+        // the entries of the block and its sons are in its x86 range
+        uintptr_t addr = (uintptr_t)db->x86_addr;
+        for(int i=0; i<db->x86_size; ++i)
+            removeIBTC(&arm_ibtc[((addr+i)&(IBTC_SIZE-1))*2], start, end);
+    }
+}
+
+void PrintIBTCStats()
+{
+    if(!box86_dynarec_ibtc)
+        return;
+    printf_log(LOG_NONE, "Dynarec IBTC: %u hit(s), %u miss(es), %u fill(s)\n", arm_ibtc_hits, arm_ibtc_misses, ibtc_fills);
+}
+
 void* UpdateLinkTable(x86emu_t* emu, void** table, uintptr_t addr)
 {
     dynablock_t* current = (dynablock_t*)table[2];
     if(current->father)
         current = current->father;
+    if(box86_dynarec_hot && table==(void**)current->table && current->tier==1 && addr==(uintptr_t)current->x86_addr) {
+        // hit counter of the block is done, time to recompile it
+        dynablock_t* hot = DBTierUp(current);
+        if(hot!=current)
+            return hot->block;
+        table[3] = (void*)(uintptr_t)box86_dynarec_hot;   // failed, try again later
+        return (void*)((uintptr_t)current->block+2*4);  // skip the entry redirection
+    }
     dynablock_t* block = DBGetBlock(emu, addr, 1, &current);
     if(!current)  {  // current has been invalidated, stop running it...
         //dynarec_log(LOG_DEBUG, "--- Current invalidated while linking.\n");
@@ -79,8 +140,10 @@ void* UpdateLinkTable(x86emu_t* emu, void** table, uintptr_t addr)
     //dynablock_t *father = block->father?block->father:block;
     if(!block->parent->nolinker) {
         //dynarec_log(LOG_DEBUG, "--- Linking %p/%p to %p (table=%p[%p/%p/%p/%p])\n", block, block->block, current, table, table[0], table[1], table[2], table[3]);
-        // only update block if linker is allowed
-        tableupdate(block->block, addr, table);
+        // only update block if linker is allowed (and keep track of the link, so it can be undone)
+        DynaLinkTable(table, block->block, addr, block);
+        if(box86_dynarec_ibtc)
+            IBTCAdd(addr, block->block);
     }
     return block->block;
 }
@@ -91,6 +154,9 @@ void DynaCall(x86emu_t* emu, uintptr_t addr)
     // prepare setjump for signal handling
     emu_jmpbuf_t *ejb = NULL;
     int jmpbuf_reset = 0;
+#ifdef DYNAREC
+    int depth = DynaGetDepth();
+#endif
     if(emu->type == EMUTYPE_MAIN) {
         ejb = GetJmpBuf();
         if(!ejb->jmpbuf_ok) {
@@ -121,8 +187,12 @@ void DynaCall(x86emu_t* emu, uintptr_t addr)
         dynablock_t* block = NULL;
         dynablock_t* current = NULL;
         while(!emu->quit) {
+            if(box86_dynarec_cache_mb)
+                DynaQuiescent(emu, depth+1);  // no block running in this loop, also restore depth after a longjmp
             block = DBGetBlock(emu, R_EIP, 1, &current);
             current = (block && !block->parent->nolinker)?block:NULL;
+            if(box86_dynarec_ibtc && current && current->block && current->done)
+                IBTCAdd(R_EIP, current->block);
             if(!block || !block->block || !block->done) {
                 // no block, of block doesn't have DynaRec content (yet, temp is not null)
                 // Use interpreter (should use single instruction step...)
@@ -153,6 +223,8 @@ void DynaCall(x86emu_t* emu, uintptr_t addr)
                 }
             }
         }
+        if(box86_dynarec_cache_mb)
+            DynaSetDepth(depth);
         emu->quit = 0;  // reset Quit flags...
         emu->df = d_none;
         if(emu->quitonlongjmp && emu->longjmp) {
@@ -177,6 +249,9 @@ int DynaRun(x86emu_t* emu)
     // prepare setjump for signal handling
     emu_jmpbuf_t *ejb = NULL;
     int jmpbuf_reset = 1;
+#ifdef DYNAREC
+    int depth = DynaGetDepth();
+#endif
     if(emu->type == EMUTYPE_MAIN) {
         ejb = GetJmpBuf();
         if(!ejb->jmpbuf_ok) {
@@ -196,8 +271,12 @@ int DynaRun(x86emu_t* emu)
         dynablock_t* block = NULL;
         dynablock_t* current = NULL;
         while(!emu->quit) {
+            if(box86_dynarec_cache_mb)
+                DynaQuiescent(emu, depth+1);  // no block running in this loop, also restore depth after a longjmp
             block = DBGetBlock(emu, R_EIP, 1, &current);
             current = (block && !block->parent->nolinker)?block:NULL;
+            if(box86_dynarec_ibtc && current && current->block && current->done)
+                IBTCAdd(R_EIP, current->block);
             if(!block || !block->block || !block->done) {
                 // no block, of block doesn't have DynaRec content (yet, temp is not null)
                 // Use interpreter (should use single instruction step...)
@@ -225,6 +304,8 @@ int DynaRun(x86emu_t* emu)
                 }
             }
         }
+        if(box86_dynarec_cache_mb)
+            DynaSetDepth(depth);
     }
     // clear the setjmp
     if(ejb && jmpbuf_reset)
@@ -3,6 +3,7 @@
 #include <pthread.h>
 #include <errno.h>
 #include <string.h>
+#include <time.h>
 
 #include "debug.h"
 #include "box86context.h"
@@ -20,6 +21,9 @@
 #include "dynarec_arm.h"
 #include "dynarec_arm_private.h"
 #include "elfloader.h"
+#include "dynacache.h"
+#include "dynaevict.h"
+#include "dynaperf.h"
 
 void printf_x86_instruction(zydis_dec_t* dec, instruction_x86_t* inst, const char* name) {
     uint8_t *ip = (uint8_t*)inst->addr;
@@ -108,10 +112,25 @@ int is_nops(dynarec_arm_t *dyn, uintptr_t addr, int n)
         return is_nops(dyn, addr+7, n-7);
     if(n>7 && PK(0)==0x0f && PK(1)==0x1f && PK(2)==0x84 && PK(3)==0x00 && PK(4)==0x00 && PK(5)==0x00 && PK(6)==0x00 && PK(7)==0x00)
         return is_nops(dyn, addr+8, n-8);
+    if(n>6 && PK(0)==0x8d && PK(1)==0xbc && PK(2)==0x27 && PK(3)==0x00 && PK(4)==0x00 && PK(5)==0x00 && PK(6)==0x00) // lea edi, [edi+0]
+        return is_nops(dyn, addr+7, n-7);
+    if(n>8 && PK(0)==0x2e && PK(1)==0x0f && PK(2)==0x1f && PK(3)==0x84 && PK(4)==0x00 && PK(5)==0x00 && PK(6)==0x00 && PK(7)==0x00 && PK(8)==0x00)    // nopw cs:[eax+eax*1+0]
+        return is_nops(dyn, addr+9, n-9);
     return 0;
     #undef PK
 }
 
+// flags needed at the x86 address a jump out of the block goes to, from the summary of the block there (X_ALL if unknown)
+static uint32_t exit_flags(dynarec_arm_t *dyn, int ninst)
+{
+    if(dyn->nolinker)
+        return X_ALL;   // only static code, that can't be changed, is trusted
+    uint32_t flags = DBEntryFlags(dyn->insts[ninst].x86.jmp);
+    if(flags!=X_ALL)
+        dyn->succflags = 1;
+    return flags;
+}
+
 uint32_t needed_flags(dynarec_arm_t *dyn, int ninst, uint32_t setf, int recurse)
 {
     if(recurse == 10)
@@ -145,7 +164,7 @@ uint32_t needed_flags(dynarec_arm_t *dyn, int ninst, uint32_t setf, int recurse)
 
     int jinst = dyn->insts[ninst].x86.jmp_insts;
     if(dyn->insts[ninst].x86.jmp) {
-        dyn->insts[ninst].x86.need_flags = (jinst==-1)?X_PEND:needed_flags(dyn, jinst, setf, recurse+1);
+        dyn->insts[ninst].x86.need_flags = (jinst==-1)?((exit_flags(dyn, ninst)&setf)?X_PEND:0):needed_flags(dyn, jinst, setf, recurse+1);
         if(dyn->insts[ninst].x86.use_flags)  // conditionnal jump
              dyn->insts[ninst].x86.need_flags |= needed_flags(dyn, ninst+1, setf, recurse);
     } else
@@ -159,6 +178,222 @@ uint32_t needed_flags(dynarec_arm_t *dyn, int ninst, uint32_t setf, int recurse)
     return needed;
 }
 
+// flags needed after the conditional instruction ninst, that reads its condition from the CPSR and not from x86emu_t
+static uint32_t fused_needed_flags(dynarec_arm_t *dyn, int ninst, uint32_t setf)
+{
+    uint32_t needed = needed_flags(dyn, ninst+1, setf, 0);
+    if(dyn->insts[ninst].x86.jmp) {
+        int jinst = dyn->insts[ninst].x86.jmp_insts;
+        needed |= (jinst==-1)?((exit_flags(dyn, ninst)&setf)?X_PEND:0):needed_flags(dyn, jinst, setf, 1);
+    }
+    if(needed == (X_PEND|X_ALL))
+        needed = X_ALL;
+    return needed;
+}
+
+// liveness of the flags on the whole block (following all the jumps, with no depth limit)
+// used[i] are the flags read before being set from instruction i, pend[i] the flags that can leave the block before being set
+// (for jumps out of the block to a known block, only the flags it needs on entry)
+#define SUCC(i, U, P)                                               \
+    if(dyn->insts[i].x86.jmp) {                                     \
+        int j = dyn->insts[i].x86.jmp_insts;                        \
+        U = (j==-1)?0:used[j];                                      \
+        P = (j==-1)?exitf[i]:pend[j];                               \
+        if(dyn->insts[i].x86.use_flags) {                           \
+            U |= used[i+1];                                         \
+            P |= pend[i+1];                                         \
+        }                                                           \
+    } else {                                                        \
+        U = used[i+1];                                              \
+        P = pend[i+1];                                              \
+    }
+
+static void flags_liveness(dynarec_arm_t *dyn, uint32_t* used, uint32_t* pend, uint32_t* exitf)
+{
+    int n = dyn->size;
+    used[n] = 0;
+    pend[n] = X_ALL;
+    for(int i=0; i<n; ++i)
+        exitf[i] = (dyn->insts[i].x86.jmp && dyn->insts[i].x86.jmp_insts==-1)?exit_flags(dyn, i):X_ALL;
+    int changed = 1;
+    while(changed) {
+        changed = 0;
+        for(int i=n-1; i>=0; --i) {
+            uint32_t u, p;
+            SUCC(i, u, p);
+            uint32_t kill = (dyn->insts[i].x86.state_flags!=SF_MAYSET)?dyn->insts[i].x86.set_flags:0;
+            u = dyn->insts[i].x86.use_flags | (u & ~kill);
+            p &= ~kill;
+            if(u!=used[i] || p!=pend[i]) {
+                used[i] = u;
+                pend[i] = p;
+                changed = 1;
+            }
+        }
+    }
+}
+
+// used by hot blocks instead of needed_flags
+static void needed_flags_block(dynarec_arm_t *dyn, uint32_t* used, uint32_t* pend, uint32_t* exitf)
+{
+    int n = dyn->size;
+    for(int i=0; i<n; ++i)
+        if(dyn->insts[i].x86.set_flags) {
+            uint32_t u, p;
+            // a fused conditional instruction doesn't need the flags in x86emu_t, only what comes after it
+            if(dyn->insts[i+1].fused) {
+                SUCC(i+1, u, p);
+            } else {
+                SUCC(i, u, p);
+            }
+            uint32_t needed = u;
+            if(p & dyn->insts[i].x86.set_flags)
+                needed |= X_PEND;
+            if((needed&X_PEND) && (dyn->insts[i].x86.state_flags==SF_MAYSET))
+                needed = X_ALL;
+            if(needed == (X_PEND|X_ALL))
+                needed = X_ALL;
+            dyn->insts[i].x86.need_flags = needed;
+        }
+}
+#undef SUCC
+
+void add_reloc(dynarec_arm_t *dyn, int type, uintptr_t ref, int addend, int extra)
+{
+    if(dyn->relocs_size == dyn->relocs_cap) {
+        dyn->relocs_cap += 16;
+        dyn->relocs = (dynareloc_t*)realloc(dyn->relocs, dyn->relocs_cap*sizeof(dynareloc_t));
+    }
+    dynareloc_t* r = &dyn->relocs[dyn->relocs_size++];
+    r->offset = dyn->arm_size;
+    r->type = type;
+    r->ref = ref;
+    r->addend = addend;
+    r->extra = extra;
+}
+
+void add_fixup(dynarec_arm_t *dyn, int type, uintptr_t* label)
+{
+    if(dyn->fixups_size == dyn->fixups_cap) {
+        dyn->fixups_cap += 16;
+        dyn->fixups = (dynafixup_t*)realloc(dyn->fixups, dyn->fixups_cap*sizeof(dynafixup_t));
+    }
+    dynafixup_t* f = &dyn->fixups[dyn->fixups_size++];
+    f->offset = dyn->arm_size;
+    f->type = type;
+    f->label = label;
+}
+
+// the scratch buffer of the one pass mode is full: make it bigger, and move what points inside it
+void grow_scratch(dynarec_arm_t *dyn)
+{
+    uintptr_t old = dyn->arm_start;
+    dyn->scratch_cap *= 2;
+    dyn->arm_start = (uintptr_t)realloc((void*)old, dyn->scratch_cap);
+    dyn->block = (void*)(dyn->arm_start+dyn->arm_size);
+    intptr_t delta = dyn->arm_start-old;
+    if(!delta)
+        return;
+    for(int i=0; i<dyn->sons_size; ++i)
+        dyn->sons_arm[i] += delta;
+    if(dyn->patch)
+        for(int i=0; i<dyn->tablesz/4; ++i)
+            if(dyn->patch[i])
+                dyn->patch[i] += delta;
+}
+
+// resolve the forward references of a block emitted in one pass, that will be at arm
+static void resolve_fixups(dynarec_arm_t *dyn, uintptr_t arm)
+{
+    for(int i=0; i<dyn->fixups_size; ++i) {
+        dynafixup_t* f = &dyn->fixups[i];
+        uint32_t* op = (uint32_t*)(dyn->arm_start+f->offset);
+        switch(f->type) {
+            case FIXUP_BRANCH:
+                op[0] = (op[0]&0xff000000) | (((*f->label-(f->offset+8))>>2)&0xffffff);
+                break;
+            case FIXUP_MOV32: {
+                uint32_t val = arm+*f->label;
+                op[0] = (op[0]&0xfff0f000) | ((val&0xf000)<<4) | (val&0x0fff);
+                val >>= 16;
+                op[1] = (op[1]&0xfff0f000) | ((val&0xf000)<<4) | (val&0x0fff);
+                // the relocation for the persistent cache was recorded with the label unknown too
+                for(int j=0; j<dyn->relocs_size; ++j)
+                    if(dyn->relocs[j].offset==f->offset && dyn->relocs[j].type==RELOC_BLOCK)
+                        dyn->relocs[j].addend = *f->label;
+                }
+                break;
+        }
+    }
+}
+
+// (x86 address, inlined function) of the instructions of a block, sorted, to find an instruction without scanning the whole block
+typedef struct instindex_s {
+    uintptr_t   addr;
+    int         inlined;
+    int         ninst;
+} instindex_t;
+
+static int compare_instindex(const void* a, const void* b)
+{
+    const instindex_t* ia = (const instindex_t*)a;
+    const instindex_t* ib = (const instindex_t*)b;
+    if(ia->addr!=ib->addr)
+        return (ia->addr<ib->addr)?-1:1;
+    if(ia->inlined!=ib->inlined)
+        return (ia->inlined<ib->inlined)?-1:1;
+    return ia->ninst-ib->ninst;
+}
+
+static instindex_t* build_instindex(dynarec_arm_t *dyn)
+{
+    instindex_t* idx = (instindex_t*)malloc(dyn->size*sizeof(instindex_t));
+    for(int i=0; i<dyn->size; ++i) {
+        idx[i].addr = dyn->insts[i].x86.addr;
+        idx[i].inlined = dyn->insts[i].inlined;
+        idx[i].ninst = i;
+    }
+    qsort(idx, dyn->size, sizeof(instindex_t), compare_instindex);
+    return idx;
+}
+
+// first instruction at addr, from inlined function inl (0 for the block itself), -1 if none
+static int find_inst(dynarec_arm_t *dyn, instindex_t* idx, uintptr_t addr, int inl)
+{
+    int lo = 0, hi = dyn->size;
+    while(lo<hi) {
+        int mid = (lo+hi)/2;
+        if(idx[mid].addr<addr || (idx[mid].addr==addr && idx[mid].inlined<inl))
+            lo = mid+1;
+        else
+            hi = mid;
+    }
+    if(lo<dyn->size && idx[lo].addr==addr && idx[lo].inlined==inl)
+        return idx[lo].ninst;
+    return -1;
+}
+
+// compilation time of the blocks (BOX86_DYNAREC_STATS)
+static uint64_t stat_fill_ns = 0;
+static uint64_t stat_fill_insts = 0;
+static uint32_t stat_fill_blocks = 0;
+
+static uint64_t fill_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec*1000000000LL+ts.tv_nsec;
+}
+
+void PrintFillBlockStats()
+{
+    if(!stat_fill_blocks)
+        return;
+    printf_log(LOG_NONE, "Dynarec compilation (%s): %u block(s), %llu x86 instructions, %llums, %.1fns per instruction\n",
+        box86_dynarec_onepass?"one pass":"4 passes", stat_fill_blocks, (unsigned long long)stat_fill_insts, (unsigned long long)(stat_fill_ns/1000000),
+        (double)stat_fill_ns/stat_fill_insts);
+}
+
 instsize_t* addInst(instsize_t* insts, size_t* size, size_t* cap, int x86_size, int arm_size)
 {
     // x86 instruction is <16 bytes anyway
@@ -195,11 +430,59 @@ void arm_pass1(dynarec_arm_t* dyn, uintptr_t addr);
 void arm_pass2(dynarec_arm_t* dyn, uintptr_t addr);
 void arm_pass3(dynarec_arm_t* dyn, uintptr_t addr);
 
+#define INLINE_DISTANCE 0x10000 // an inlined function ends at most that far from the start of the block
+
+// check if callee, called from addr, is a small leaf function that can be translated in the block of its caller (BOX86_DYNAREC_INLINE)
+int is_inlinable(dynarec_arm_t *dyn, uintptr_t addr, uintptr_t callee)
+{
+    if(!dyn->inline_max || dyn->nolinker || dyn->noinline || dyn->inline_ret || callee<0x10000)
+        return 0;
+    if(callee<=addr && addr<callee+dyn->inline_max)
+        return 0;   // could be a recursive call
+    if(callee<dyn->start || callee+dyn->inline_max>dyn->start+INLINE_DISTANCE)
+        return 0;   // the x86 range of the block goes from its start to the end of its inlined functions
+    // only code that is not checked for modifications, from the same elf (so the persistent cache stays valid)
+    elfheader_t* h = FindElfAddress(my_context, callee);
+    if(!h || h!=FindElfAddress(my_context, addr) || !DBIsStatic(callee, 1))
+        return 0;
+    dynarec_arm_t scan = {0};
+    scan.start = callee;
+    scan.tier = dyn->tier;
+    scan.nolock = dyn->nolock;
+    scan.noinline = 1;
+    scan.inline_max = dyn->inline_max;
+    arm_pass0(&scan, callee);
+    // a JMP or another end before the RET would not be followed by pass1+ (they only go on inside [start, start+isize[)
+    int ret = (scan.size && !scan.calls && !scan.extended && scan.isize<=dyn->inline_max && DBIsStatic(callee, scan.isize));
+    // the function must end with its RET...
+    #define PK(A) (*((uint8_t*)(scan.lastip+(A))))
+    if(ret) {
+        int sz = (PK(0)==0xC3)?1:((PK(0)==0xC2)?3:((PK(0)==0xF3 && PK(1)==0xC3)?2:0));
+        if(!sz || scan.lastip+sz!=callee+scan.isize)
+            ret = 0;
+    }
+    #undef PK
+    // ...and all its jumps stay inside
+    for(int i=0; i<scan.next_sz && ret; ++i)
+        if(scan.next[i]<callee || scan.next[i]>=callee+scan.isize)
+            ret = 0;
+    free(scan.next);
+    return ret;
+}
+
 void* FillBlock(dynablock_t* block, uintptr_t addr) {
     // init the helper
     dynarec_arm_t helper = {0};
+    uint64_t t0 = box86_dynarec_stats?fill_ns():0;
+    uint32_t smcgen = getDBGeneration();    // before the x86 code is read
     helper.nolinker = box86_dynarec_linker?(block->parent->nolinker):1;
     helper.start = addr;
+    helper.tier = block->tier?block->tier:1;
+    helper.hot = (box86_dynarec_hot && helper.tier==1 && !helper.nolinker)?1:0;
+    helper.nolock = my_context->singlethread;
+    helper.inline_max = box86_dynarec_inline;
+    if(helper.tier>1 && helper.inline_max<TIER2_INLINE)
+        helper.inline_max = TIER2_INLINE;   // hot blocks always go over the calls of tiny leaf functions
     arm_pass0(&helper, addr);
     if(!helper.size) {
         dynarec_log(LOG_DEBUG, "Warning, null-sized dynarec block (%p)\n", (void*)addr);
@@ -214,38 +497,79 @@ void* FillBlock(dynablock_t* block, uintptr_t addr) {
     // calculate barriers
     uintptr_t start = helper.insts[0].x86.addr;
     uintptr_t end = helper.insts[helper.size].x86.addr+helper.insts[helper.size].x86.size;
+    // the inlined functions are after the start, the x86 range of the block (and of its sons) goes up to their end
+    uintptr_t x86end = end;
+    for(int i=0; i<helper.size; ++i)
+        if(helper.insts[i].inlined && helper.insts[i].x86.addr+helper.insts[i].x86.size>x86end)
+            x86end = helper.insts[i].x86.addr+helper.insts[i].x86.size;
+    instindex_t* instindex = build_instindex(&helper);
     for(int i=0; i<helper.size; ++i)
         if(helper.insts[i].x86.jmp) {
             uintptr_t j = helper.insts[i].x86.jmp;
-            if(j<start || j>=end)
+            int inl = helper.insts[i].inlined;
+            if(!inl && (j<start || j>=end))
                 helper.insts[i].x86.jmp_insts = -1;
             else {
-                // find jump address instruction
-                int k=-1;
-                for(int i2=0; i2<helper.size && k==-1; ++i2) {
-                    if(helper.insts[i2].x86.addr==j)
-                        k=i2;
-                }
+                // find jump address instruction (an inlined function only jumps inside itself)
+                int k = find_inst(&helper, instindex, j, inl);
                 if(k!=-1)   // -1 if not found, mmm, probably wrong, exit anyway
                     helper.insts[k].x86.barrier = 1;
                 helper.insts[i].x86.jmp_insts = k;
             }
         }
+    // the condition can only be read from the CPSR if the code between the 2 instructions is never entered nor traced
     for(int i=0; i<helper.size; ++i)
-        if(helper.insts[i].x86.set_flags && !helper.insts[i].x86.need_flags) {
-            helper.insts[i].x86.need_flags = needed_flags(&helper, i+1, helper.insts[i].x86.set_flags, 0);
+        if(helper.insts[i].fused && helper.insts[i].x86.barrier==1)
+            helper.insts[i].fused = 0;
+#ifdef HAVE_TRACE
+    if(my_context->dec && box86_dynarec_trace)
+        for(int i=0; i<helper.size; ++i)
+            helper.insts[i].fused = 0;
+#endif
+    // liveness of the flags, that also gives the flags needed on entry of the block (and of its sons)
+    uint32_t* used = (uint32_t*)calloc(3*(helper.size+1), sizeof(uint32_t));
+    uint32_t* pend = used+helper.size+1;
+    uint32_t* exitf = pend+helper.size+1;
+    flags_liveness(&helper, used, pend, exitf);
+    if(helper.tier>1)
+        needed_flags_block(&helper, used, pend, exitf);
+    else for(int i=0; i<helper.size; ++i)
+        if(helper.insts[i].x86.set_flags && (!helper.insts[i].x86.need_flags || helper.insts[i+1].fused)) {
+            if(helper.insts[i+1].fused)
+                helper.insts[i].x86.need_flags = fused_needed_flags(&helper, i+1, helper.insts[i].x86.set_flags);
+            else
+                helper.insts[i].x86.need_flags = needed_flags(&helper, i+1, helper.insts[i].x86.set_flags, 0);
             if((helper.insts[i].x86.need_flags&X_PEND) && (helper.insts[i].x86.state_flags==SF_MAYSET))
                 helper.insts[i].x86.need_flags = X_ALL;
         }
     
-    // pass 2, instruction size
-    arm_pass2(&helper, addr);
-    // ok, now allocate mapped memory, with executable flag on
-    int sz = helper.arm_size;
-    void* p = (void*)AllocDynarecMap(sz, block->parent->nolinker);
+    int sz = 0;
+    void* p = NULL;
+    helper.onepass = box86_dynarec_onepass;
+    if(helper.onepass) {
+        // no pass 2: pass 3 emits in a scratch buffer, the sizes being known only once it's done
+        for(int i=0; i<helper.cap; ++i) {
+            instruction_arm_t* inst = &helper.insts[i];
+            inst->address = inst->epilog = LABEL_NONE;
+            inst->mark = inst->mark2 = inst->mark3 = inst->markf = inst->markseg = inst->marklock = LABEL_NONE;
+        }
+        for(int i=1; i<helper.size; ++i)
+            if(helper.insts[i].x86.barrier==1 && !helper.insts[i].inlined)
+                ++helper.sons_size;
+        helper.scratch_cap = (helper.isize*16+256)&~3;
+        p = malloc(helper.scratch_cap);
+    } else {
+        // pass 2, instruction size
+        arm_pass2(&helper, addr);
+        // ok, now allocate mapped memory, with executable flag on
+        sz = helper.arm_size;
+        p = (void*)AllocDynarecMap(sz, block->parent->nolinker);
+    }
     if(p==NULL) {
         free(helper.insts);
         free(helper.next);
+        free(used);
+        free(instindex);
         return (void*)block;
     }
     helper.block = p;
@@ -253,6 +577,8 @@ void* FillBlock(dynablock_t* block, uintptr_t addr) {
     helper.tablesz = helper.tablei;
     if(helper.tablesz)
         helper.table = (uintptr_t*)calloc(helper.tablesz, sizeof(uintptr_t));
+    if(helper.tablesz && box86_dynarec_patch)
+        helper.patch = (uintptr_t*)calloc(helper.tablesz/4, sizeof(uintptr_t));
     if(helper.sons_size) {
         helper.sons_x86 = (uintptr_t*)calloc(helper.sons_size, sizeof(uintptr_t));
         helper.sons_arm = (void**)calloc(helper.sons_size, sizeof(void*));
@@ -265,7 +591,40 @@ void* FillBlock(dynablock_t* block, uintptr_t addr) {
     }
     helper.arm_size = 0;
     arm_pass3(&helper, addr);
-    if(sz!=helper.arm_size) {
+    if(helper.onepass) {
+        // now the block can go in the mapped memory
+        void* scratch = (void*)helper.arm_start;
+        sz = helper.arm_size;
+        p = (void*)AllocDynarecMap(sz, block->parent->nolinker);
+        if(p==NULL) {
+            free(scratch);
+            free(helper.table);
+            free(helper.patch);
+            free(helper.sons_x86);
+            free(helper.sons_arm);
+            free(helper.relocs);
+            free(helper.fixups);
+            free(helper.insts);
+            free(helper.next);
+            free(used);
+            free(instindex);
+            return (void*)block;
+        }
+        resolve_fixups(&helper, (uintptr_t)p);
+        memcpy(p, scratch, sz);
+        intptr_t delta = (uintptr_t)p-(uintptr_t)scratch;
+        for(int i=0; i<helper.sons_size; ++i)
+            helper.sons_arm[i] += delta;
+        if(helper.patch)
+            for(int i=0; i<helper.tablesz/4; ++i)
+                if(helper.patch[i])
+                    helper.patch[i] += delta;
+        helper.arm_start = (uintptr_t)p;
+        free(scratch);
+        free(helper.fixups);
+        for(int i=0; i<=helper.size; ++i)
+            helper.insts[i].size = helper.insts[i].size2;
+    } else if(sz!=helper.arm_size) {
         printf_log(LOG_NONE, "BOX86: Warning, size difference in block between pass2 (%d) & pass3 (%d)!\n", sz, helper.arm_size);
         uint8_t *dump = (uint8_t*)helper.start;
         printf_log(LOG_NONE, "Dump of %d x86 opcodes:\n", helper.size);
@@ -280,31 +639,50 @@ void* FillBlock(dynablock_t* block, uintptr_t addr) {
     // all done...
     __clear_cache(p, p+sz);   // need to clear the cache before execution...
     // keep size of instructions for signal handling
+    size_t instsize_sz = 0;
     {
         size_t cap = helper.size+1;
-        size_t size = 0;
         block->instsize = (instsize_t*)calloc(cap, sizeof(instsize_t));
+        // the code of an inlined function counts as part of its CALL, so the x86 addresses can still be summed
         for(int i=0; i<helper.size; ++i)
-            block->instsize = addInst(block->instsize, &size, &cap, helper.insts[i].x86.size, helper.insts[i].size/4);
-        addInst(block->instsize, &size, &cap, 0, 0);    // add a "end of block" mark, just in case
+            block->instsize = addInst(block->instsize, &instsize_sz, &cap, helper.insts[i].inlined?0:helper.insts[i].x86.size, helper.insts[i].size/4);
+        addInst(block->instsize, &instsize_sz, &cap, 0, 0);    // add a "end of block" mark, just in case
+    }
+    // flags needed on entry, for the blocks jumping here
+    block->entry_flags = used[0]|pend[0];
+    uint32_t* sons_flags = helper.sons_size?(uint32_t*)calloc(helper.sons_size, sizeof(uint32_t)):NULL;
+    for(int i=0; i<helper.sons_size; ++i) {
+        int k = find_inst(&helper, instindex, helper.sons_x86[i], 0);
+        sons_flags[i] = (k==-1)?X_ALL:(used[k]|pend[k]);
     }
+    free(used);
+    free(instindex);
     // ok, free the helper now
     free(helper.insts);
     free(helper.next);
     block->table = helper.table;
     block->tablesz = helper.tablesz;
+    block->patch = helper.patch;
     for (int i=0; i<helper.tablesz/4; ++i)
         block->table[i*4+2] = (uintptr_t)block;
+    if(helper.hot)
+        block->table[3] = box86_dynarec_hot;    // hit counter
+    block->tier = helper.tier;
+    block->nolock = helper.elided;
     block->size = sz;
     block->isize = helper.size;
     block->block = p;
+    setDynarecMapOwner((uintptr_t)p, sz, block);
     block->nolinker = helper.nolinker;
     block->need_test = 0;
     //block->x86_addr = (void*)start;
-    block->x86_size = end-start;
+    block->x86_size = x86end-start;
     if(box86_dynarec_largest<block->x86_size)
         box86_dynarec_largest = block->x86_size;
-    block->hash = (helper.nolinker)?X31_hash_code(block->x86_addr, block->x86_size):0;
+    if(helper.nolinker)
+        HashDynablock(block, smcgen);
+    else
+        block->hash = 0;
     // fill sons if any
     dynablock_t** sons = NULL;
     int sons_size = 0;
@@ -316,9 +694,10 @@ void* FillBlock(dynablock_t* block, uintptr_t addr) {
             if(created || !son->parent) {    // avoid breaking a working block! also, block could be outside this parent...
                 son->block = helper.sons_arm[i];
                 son->x86_addr = (void*)helper.sons_x86[i];
-                son->x86_size = end-helper.sons_x86[i];
+                son->x86_size = x86end-helper.sons_x86[i];
                 if(!son->x86_size) {printf_log(LOG_NONE, "Warning, son with null x86 size! (@%p / ARM=%p)", son->x86_addr, son->block);}
                 son->father = block;
+                son->entry_flags = sons_flags[i];
                 son->done = 1;
                 sons[sons_size++] = son;
                 if(!son->parent)
@@ -331,10 +710,28 @@ void* FillBlock(dynablock_t* block, uintptr_t addr) {
         } else
             free(sons);
     }
+    free(sons_flags);
     if(block->parent->nolinker)
-        protectDB((uintptr_t)block->x86_addr, block->x86_size);
+        block->need_test = protectDB((uintptr_t)block->x86_addr, block->x86_size)?0:1;
+    else if(box86_dynarec_diskcache && sz==helper.arm_size && helper.tier==1 && !helper.elided && !helper.succflags)
+        DynaCacheSave(block, instsize_sz, helper.relocs, helper.relocs_size);
     free(helper.sons_x86);
     free(helper.sons_arm);
+    free(helper.relocs);
+    if(box86_dynarec_stats) {
+        uint64_t t = fill_ns()-t0;
+        __sync_fetch_and_add(&stat_fill_ns, t);
+        __sync_fetch_and_add(&stat_fill_insts, helper.size);
+        __sync_fetch_and_add(&stat_fill_blocks, 1);
+        dynarec_log(LOG_DEBUG, "Block %p: %d x86 instructions compiled in %lluns (%.1fns per instruction)\n", (void*)addr, helper.size, (unsigned long long)t, (double)t/helper.size);
+    }
+    DynaEvictAdd(block);
+    PerfMapBlock(block);
+    GdbJitAddBlock(block);
+    __sync_synchronize();   // block must be complete before being seen as done by other threads
     block->done = 1;
+    __sync_synchronize();   // done must be seen before singlethread is read, or DynaEvictNoLock could skip the block
+    if(block->nolock && !my_context->singlethread)
+        DynaEvictNoLock(NULL);  // a thread has been created while the block was built
     return (void*)block;
 }
\ No newline at end of file
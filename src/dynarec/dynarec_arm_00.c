@@ -3,6 +3,7 @@
 #include <stddef.h>
 #include <pthread.h>
 #include <errno.h>
+#include <string.h>
 
 #include "debug.h"
 #include "box86context.h"
@@ -14,6 +15,7 @@
 #include "box86stack.h"
 #include "callback.h"
 #include "bridge.h"
+#include "tools/bridge_private.h"
 #include "emu/x86run_private.h"
 #include "x86trace.h"
 #include "dynarec_arm.h"
@@ -356,6 +358,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
         case 0x29:
             INST_NAME("SUB Ed, Gd");
             SETFLAGS(X_ALL, SF_SET);
+            SETCPSR(CPSR_SUB);
             nextop = F8;
             GETGD;
             GETED;
@@ -374,6 +377,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
         case 0x2B:
             INST_NAME("SUB Gd, Ed");
             SETFLAGS(X_ALL, SF_SET);
+            SETCPSR(CPSR_SUB);
             nextop = F8;
             GETGD;
             GETED;
@@ -390,6 +394,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
         case 0x2D:
             INST_NAME("SUB EAX, Id");
             SETFLAGS(X_ALL, SF_SET);
+            SETCPSR(CPSR_SUB);
             i32 = F32S;
             emit_sub32c(dyn, ninst, xEAX, i32, x3, x12);
             break;
@@ -477,6 +482,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
         case 0x39:
             INST_NAME("CMP Ed, Gd");
             SETFLAGS(X_ALL, SF_SET);
+            SETCPSR(CPSR_SUB);
             nextop = F8;
             GETGD;
             GETEDH(x1);
@@ -493,6 +499,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
         case 0x3B:
             INST_NAME("CMP Gd, Ed");
             SETFLAGS(X_ALL, SF_SET);
+            SETCPSR(CPSR_SUB);
             nextop = F8;
             GETGD;
             GETEDH(x2);
@@ -513,6 +520,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
         case 0x3D:
             INST_NAME("CMP EAX, Id");
             SETFLAGS(X_ALL, SF_SET);
+            SETCPSR(CPSR_SUB);
             i32 = F32S;
             if(i32) {
                 MOV32(x2, i32);
@@ -686,20 +694,32 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
 
         #define GO(GETFLAGS, NO, YES, F)    \
             READFLAGS(F);                   \
+            FUSECC(opcode);                 \
             i8 = F8S;   \
-            BARRIER(2); \
+            BARRIER_JCC; \
             JUMP(addr+i8);\
-            GETFLAGS;   \
+            if(CPSR_FUSED) {    \
+                /* the flags are still in the CPSR */   \
+                u8 = cpsr_cond(dyn->insts[ninst-1].cpsr, opcode);   \
+            } else {    \
+                GETFLAGS;   \
+                u8 = ((uint32_t)(YES))>>28; \
+            }   \
             if(dyn->insts) {    \
-                if(dyn->insts[ninst].x86.jmp_insts==-1) {   \
+                if(dyn->insts[ninst].x86.barrier==3) {  \
+                    /* the fpu cache is only purged if taken */ \
+                    jump_cond_purge(dyn, ninst, (uint32_t)(u8^1)<<28, addr+i8); \
+                } else if(dyn->insts[ninst].x86.jmp_insts==-1) {   \
                     /* out of the block */                  \
                     i32 = dyn->insts[ninst+1].address-(dyn->arm_size+8); \
-                    Bcond(NO, i32);     \
+                    FIXUP(FIXUP_BRANCH, dyn->insts[ninst+1].address); \
+                    Bcond((uint32_t)(u8^1)<<28, i32);     \
                     jump_to_linker(dyn, addr+i8, 0, ninst); \
                 } else {    \
                     /* inside the block */  \
                     i32 = dyn->insts[dyn->insts[ninst].x86.jmp_insts].address-(dyn->arm_size+8);    \
-                    Bcond(YES, i32);    \
+                    FIXUP(FIXUP_BRANCH, dyn->insts[dyn->insts[ninst].x86.jmp_insts].address); \
+                    Bcond((uint32_t)u8<<28, i32);    \
                 }   \
             }
 
@@ -939,6 +959,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                 case 5: //SUB
                     if(opcode==0x81) {INST_NAME("SUB Ed, Id");} else {INST_NAME("SUB Ed, Ib");}
                     SETFLAGS(X_ALL, SF_SET);
+                    SETCPSR(CPSR_SUB);
                     GETED;
                     if(opcode==0x81) i32 = F32S; else i32 = F8S;
                     emit_sub32c(dyn, ninst, ed, i32, x3, x12);
@@ -955,6 +976,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                 case 7: //CMP
                     if(opcode==0x81) {INST_NAME("CMP Ed, Id");} else {INST_NAME("CMP Ed, Ib");}
                     SETFLAGS(X_ALL, SF_SET);
+                    SETCPSR(CPSR_SUB);
                     GETEDH(x1);
                     if(opcode==0x81 /*&& fmod_smc_start && ip>=fmod_smc_start && ip<=fmod_smc_end*/) {
                         //In libfmod from Unreal, there can be some SMC here, so getching the address instead of using a constant...
@@ -986,6 +1008,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
         case 0x85:
             INST_NAME("TEST Ed, Gd");
             SETFLAGS(X_ALL, SF_SET);
+            SETCPSR(CPSR_LOGIC);
             nextop=F8;
             GETGD;
             GETEDH(x1);
@@ -1009,11 +1032,9 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                 addr = geted(dyn, addr, ninst, nextop, &ed, x2, &fixedaddress, 0, 0);
                 MARKLOCK;
                 // do the swap with exclusive locking
-                LDREXB(x1, ed);
+                LOCK_LDREXB(x1, ed);
                 // do the swap 12 -> strb(ed), 1 -> gd
-                STREXB(x3, x12, ed);
-                CMPS_IMM8(x3, 0);
-                B_MARKLOCK(cNE);
+                LOCK_STREXB(x3, x12, ed);
                 BFI(gb1, x1, gb2*8, 8);
             }
             break;
@@ -1034,10 +1055,8 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                 TSTS_IMM8(ed, 3);
                 B_MARK(cNE);
                 MARKLOCK;
-                LDREX(x1, ed);
-                STREX(x3, gd, ed);
-                CMPS_IMM8(x3, 0);
-                B_MARKLOCK(cNE);
+                LOCK_LDREX(x1, ed);
+                LOCK_STREX(x3, gd, ed);
                 B_MARK2(c__);
                 MARK;
                 LDR_IMM9(x1, ed, 0);
@@ -1308,6 +1327,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
         case 0xA9:
             INST_NAME("TEST EAX, Id");
             SETFLAGS(X_ALL, SF_SET);
+            SETCPSR(CPSR_LOGIC);
             i32 = F32S;
             MOV32(x2, i32);
             emit_test32(dyn, ninst, xEAX, x2, x3, x12);
@@ -1547,6 +1567,18 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             break;
 
         case 0xC2:
+            if(dyn->inline_ret) {
+                INST_NAME("RETN (inlined)");
+                READFLAGS(X_PEND);
+                BARRIER(2);
+                i32 = F16;
+                ret_inlined(dyn, ninst, i32);
+                if(dyn->insts)
+                    dyn->insts[ninst].x86.size = addr-ip;
+                addr = dyn->inline_ret; // back to the caller
+                dyn->inline_ret = 0;
+                break;
+            }
             INST_NAME("RETN");
             //SETFLAGS(X_ALL, SF_SET);    // Hack, set all flags (to an unknown state...)
             READFLAGS(X_PEND);  // lets play safe here too
@@ -1557,6 +1589,17 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             *ok = 0;
             break;
         case 0xC3:
+            if(dyn->inline_ret) {
+                INST_NAME("RET (inlined)");
+                READFLAGS(X_PEND);
+                BARRIER(2);
+                ret_inlined(dyn, ninst, 0);
+                if(dyn->insts)
+                    dyn->insts[ninst].x86.size = addr-ip;
+                addr = dyn->inline_ret; // back to the caller
+                dyn->inline_ret = 0;
+                break;
+            }
             INST_NAME("RET");
             // SETFLAGS(X_ALL, SF_SET);    // Hack, set all flags (to an unknown state...)
             // ^^^ that hack break PlantsVsZombies and GOG Setup under wine....
@@ -1634,6 +1677,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     B_MARK(cNE);
                     LDR_IMM9(x1, xEmu, offsetof(x86emu_t, quit));
                     CMPS_IMM8(x1, 1);
+                    CHECK_NOLOCK(x1);
                     B_NEXT(cNE);
                     MARK;
                     jump_to_epilog(dyn, 0, 12, ninst);
@@ -1996,17 +2040,22 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             addr = dynarecDF(dyn, addr, ip, ninst, ok, need_epilog);
             break;
         #define GO(NO, YES)   \
-            BARRIER(2); \
+            BARRIER_JCC; \
             JUMP(addr+i8);\
             if(dyn->insts) {    \
-                if(dyn->insts[ninst].x86.jmp_insts==-1) {   \
+                if(dyn->insts[ninst].x86.barrier==3) {  \
+                    /* the fpu cache is only purged if taken */ \
+                    jump_cond_purge(dyn, ninst, NO, addr+i8); \
+                } else if(dyn->insts[ninst].x86.jmp_insts==-1) {   \
                     /* out of the block */                  \
                     i32 = dyn->insts[ninst+1].address-(dyn->arm_size+8); \
+                    FIXUP(FIXUP_BRANCH, dyn->insts[ninst+1].address); \
                     Bcond(NO, i32);     \
                     jump_to_linker(dyn, addr+i8, 0, ninst); \
                 } else {    \
                     /* inside the block */  \
                     i32 = dyn->insts[dyn->insts[ninst].x86.jmp_insts].address-(dyn->arm_size+8);    \
+                    FIXUP(FIXUP_BRANCH, dyn->insts[dyn->insts[ninst].x86.jmp_insts].address); \
                     Bcond(YES, i32);    \
                 }   \
             }
@@ -2053,21 +2102,28 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                 #endif
             }
             #if STEP == 0
+            uintptr_t natcall;
             if ((i32==0) && ((PK(0)>=0x58) && (PK(0)<=0x5F)))
                 tmp = 1;
             else if (((addr+i32)>0x10000) && (PK(i32+0)==0x8B) && (((PK(i32+1))&0xC7)==0x04) && (PK(i32+2)==0x24) && (PK(i32+3)==0xC3))
                 tmp = 2;
-            else if(isNativeCall(dyn, addr+i32, NULL, NULL))
-                tmp = 3;
+            else if(isNativeCall(dyn, addr+i32, &natcall, NULL))
+                tmp = getNativeCallSignature(natcall)?4:3;
+            else if(is_inlinable(dyn, addr, addr+i32))
+                tmp = 5;
             else 
                 tmp = 0;
+            if(tmp!=1 && tmp!=2)
+                ++dyn->calls;   // a real call, so not a leaf function
             #elif STEP < 2
             if ((i32==0) && ((PK(0)>=0x58) && (PK(0)<=0x5F)))
                 tmp = dyn->insts[ninst].pass2choice = 1;
             else if (((addr+i32)>0x10000) && (PK(i32+0)==0x8B) && (((PK(i32+1))&0xC7)==0x04) && (PK(i32+2)==0x24) && (PK(i32+3)==0xC3))
                 tmp = dyn->insts[ninst].pass2choice = 2;
             else if(isNativeCall(dyn, addr+i32, &dyn->insts[ninst].natcall, &dyn->insts[ninst].retn))
-                tmp = dyn->insts[ninst].pass2choice = 3;
+                tmp = dyn->insts[ninst].pass2choice = getNativeCallSignature(dyn->insts[ninst].natcall)?4:3;
+            else if(is_inlinable(dyn, addr, addr+i32))
+                tmp = dyn->insts[ninst].pass2choice = 5;
             else 
                 tmp = dyn->insts[ninst].pass2choice = 0;
             #else
@@ -2097,11 +2153,13 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     MESSAGE(LOG_DUMP, "Native Call to %s (retn=%d)\n", GetNativeName(GetNativeFnc(dyn->insts[ninst].natcall-1)), dyn->insts[ninst].retn);
                     // calling a native function
                     x87_forget(dyn, ninst, x3, x12, 0);
-                    MOV32(x12, dyn->insts[ninst].natcall); // read the 0xCC already
+                    RELOC(RELOC_NATCALL, addr+i32, 0, dyn->insts[ninst].retn);
+                    MOV32_(x12, dyn->insts[ninst].natcall); // read the 0xCC already
                     STM(xEmu, (1<<4)|(1<<5)|(1<<6)|(1<<7)|(1<<8)|(1<<9)|(1<<10)|(1<<11)|(1<<12));
                     CALL_(x86Int3, -1, 0);
                     LDM(xEmu, (1<<4)|(1<<5)|(1<<6)|(1<<7)|(1<<8)|(1<<9)|(1<<10)|(1<<11)|(1<<12));
-                    MOV32(x3, dyn->insts[ninst].natcall+2+4+4);
+                    RELOC(RELOC_NATCALL, addr+i32, 2+4+4, dyn->insts[ninst].retn);
+                    MOV32_(x3, dyn->insts[ninst].natcall+2+4+4);
                     CMPS_REG_LSL_IMM5(xEIP, x3, 0);
                     B_MARK(cNE);    // Not the expected address, exit dynarec block
                     POP(xESP, (1<<xEIP));   // pop the return address
@@ -2113,10 +2171,65 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     B_MARK(cNE);    // Not the expected address again
                     LDR_IMM9(x1, xEmu, offsetof(x86emu_t, quit));
                     CMPS_IMM8(x1, 1);
+                    CHECK_NOLOCK(x1);
                     B_NEXT(cNE);    // not quitting, so lets continue
                     MARK;
                     jump_to_epilog(dyn, 0, xEIP, ninst);
                     break;
+                case 4:
+                    SETFLAGS(X_ALL, SF_SET);    // Hack to set flags to "dont'care" state
+                    BARRIER(1);
+                    BARRIER_NEXT(1);
+                    {
+                        // simple signature: call the native function directly, args are on the x86 stack, no return address pushed
+                        const char* sig = getNativeCallSignature(dyn->insts[ninst].natcall);
+                        MESSAGE(LOG_DUMP, "Direct Native Call to %s (%s, retn=%d)\n", GetNativeName(GetNativeFnc(dyn->insts[ninst].natcall-1)), sig, dyn->insts[ninst].retn);
+                        int nargs = (sig[2]=='v')?0:(strlen(sig)-2);
+                        // the native function can call back x86 code, so the emu needs the x86 registers and the x87 state
+                        x87_forget(dyn, ninst, x3, x12, 0);
+                        MOV32(xEIP, addr);
+                        STM(xEmu, (1<<4)|(1<<5)|(1<<6)|(1<<7)|(1<<8)|(1<<9)|(1<<10)|(1<<11)|(1<<12));
+                        PUSH(xSP, 1<<xEmu);
+                        fpu_pushcache(dyn, ninst, x12);
+                        for(int i=nargs-1; i>=0; --i) {
+                            LDR_IMM9(i, xESP, i*4);
+                        }
+                        RELOC(RELOC_NATCALL, addr+i32, 0, dyn->insts[ninst].retn|NATCALL_DIRECT);
+                        MOV32_(x12, dyn->insts[ninst].natcall);
+                        LDR_IMM9(x12, x12, offsetof(onebridge_t, f)-1); // the function from the bridge
+                        BLX(x12);
+                        fpu_popcache(dyn, ninst, x12);
+                        MOV_REG(x2, 0);
+                        POP(xSP, 1<<xEmu);
+                        LDM(xEmu, (1<<4)|(1<<5)|(1<<6)|(1<<7)|(1<<8)|(1<<9)|(1<<10)|(1<<11)|(1<<12));
+                        if(sig[0]!='v') {
+                            MOV_REG(xEAX, x2);
+                        }
+                        if(sig[0]=='I' || sig[0]=='U') {
+                            MOV_REG(xEDX, x1);
+                        }
+                        if(dyn->insts[ninst].retn) {
+                            ADD_IMM8(xESP, xESP, dyn->insts[ninst].retn);
+                        }
+                        LDR_IMM9(x1, xEmu, offsetof(x86emu_t, quit));
+                        CMPS_IMM8(x1, 1);
+                        CHECK_NOLOCK(x1);   // the function may have started a thread
+                        B_NEXT(cNE);    // not quitting, so lets continue
+                        MARK;
+                        jump_to_epilog(dyn, addr, 0, ninst);
+                    }
+                    break;
+                case 5:
+                    // small leaf function: push the return address and go on with the translation in the function
+                    MESSAGE(LOG_DUMP, "Inlined Call to %p\n", (void*)(addr+i32));
+                    MOV32(x2, addr);
+                    PUSH(xESP, 1<<x2);
+                    if(dyn->insts)
+                        dyn->insts[ninst].x86.size = addr-ip;
+                    dyn->inline_ret = addr;
+                    ++dyn->inline_id;
+                    addr += i32;
+                    break;
                 default:
                     if(ninst && dyn->insts && dyn->insts[ninst-1].x86.set_flags) {
                         READFLAGS(X_PEND);  // that's suspicious
@@ -2127,10 +2240,10 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     BARRIER(1);
                     BARRIER_NEXT(1);
                     if(!dyn->nolinker && (!dyn->insts || ninst!=dyn->size-1)) {
-                        PASS2(cstack_push(dyn, ninst, addr, dyn->insts[ninst+1].address, x1, x2);)
+                        PASS2(cstack_push(dyn, ninst, addr, x1, x2);)
                         //cstatck_push put addr in x2, don't need to put it again
                     } else {
-                        PASS2(cstack_push(dyn, ninst, 0, 0, x1, x2);)
+                        PASS2(cstack_push(dyn, ninst, 0, x1, x2);)
                         *need_epilog = 0;
                         *ok = 0;
                         MOV32(x2, addr);
@@ -2165,6 +2278,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     if(tmp==-4) {
                         NOP;
                     } else {
+                        FIXUP(FIXUP_BRANCH, dyn->insts[dyn->insts[ninst].x86.jmp_insts].address);
                         Bcond(c__, tmp);
                     }
                 }
@@ -2273,6 +2387,17 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         INST_NAME("PAUSE");
                         break;
                     case 0xC3:
+                        if(dyn->inline_ret) {
+                            INST_NAME("(REPZ) RET (inlined)");
+                            READFLAGS(X_PEND);
+                            BARRIER(2);
+                            ret_inlined(dyn, ninst, 0);
+                            if(dyn->insts)
+                                dyn->insts[ninst].x86.size = addr-ip;
+                            addr = dyn->inline_ret; // back to the caller
+                            dyn->inline_ret = 0;
+                            break;
+                        }
                         INST_NAME("(REPZ) RET");
                         SETFLAGS(X_ALL, SF_SET);    // Hack to set flags to "dont'care" state
                         BARRIER(2);
@@ -2282,27 +2407,11 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         break;
                     case 0xA4:
                         INST_NAME("REP MOVSB");
-                        TSTS_REG_LSL_IMM5(xECX, xECX, 0);
-                        B_NEXT(cEQ);    // end of loop
-                        GETDIR(x3,1);
-                        MARK;
-                        LDRBAI_REG_LSL_IMM5(x1, xESI, x3, 0);
-                        STRBAI_REG_LSL_IMM5(x1, xEDI, x3, 0);
-                        SUBS_IMM8(xECX, xECX, 1);
-                        B_MARK(cNE);
-                        // done
+                        rep_movs(dyn, ninst, 0, 0);
                         break;
                     case 0xA5:
                         INST_NAME("REP MOVSD");
-                        TSTS_REG_LSL_IMM5(xECX, xECX, 0);
-                        B_NEXT(cEQ);    // end of loop
-                        GETDIR(x3,4);
-                        MARK;
-                        LDRAI_REG_LSL_IMM5(x1, xESI, x3, 0);
-                        STRAI_REG_LSL_IMM5(x1, xEDI, x3, 0);
-                        SUBS_IMM8(xECX, xECX, 1);
-                        B_MARK(cNE);
-                        // done
+                        rep_movs(dyn, ninst, 2, 0);
                         break;
                     case 0xA6:
                         if(opcode==0xF2) {INST_NAME("REPNZ CMPSB");} else {INST_NAME("REPZ CMPSB");}
@@ -2354,23 +2463,11 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         break;
                     case 0xAA:
                         INST_NAME("REP STOSB");
-                        TSTS_REG_LSL_IMM5(xECX, xECX, 0);
-                        B_NEXT(cEQ);    // end of loop
-                        GETDIR(x3,1);
-                        MARK;
-                        STRBAI_REG_LSL_IMM5(xEAX, xEDI, x3, 0);
-                        SUBS_IMM8(xECX, xECX, 1);
-                        B_MARK(cNE);
+                        rep_movs(dyn, ninst, 0, 1);
                         break;
                     case 0xAB:
                         INST_NAME("REP STOSD");
-                        TSTS_REG_LSL_IMM5(xECX, xECX, 0);
-                        B_NEXT(cEQ);    // end of loop
-                        GETDIR(x3,4);
-                        MARK;
-                        STRAI_REG_LSL_IMM5(xEAX, xEDI, x3, 0);
-                        SUBS_IMM8(xECX, xECX, 1);
-                        B_MARK(cNE);
+                        rep_movs(dyn, ninst, 2, 1);
                         break;
                     case 0xAC:
                         INST_NAME("REP LODSB");
@@ -2400,6 +2497,22 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         B_NEXT(cEQ);    // end of loop
                         GETDIR(x3,1);
                         UXTB(x1, xEAX, 0);
+                        if(opcode==0xF2) {
+                            // forward scan of a big buffer: use memchr
+                            B_MARK(cEQ);    // backward
+                            MOVW(x2, REP_BULK_NATIVE);
+                            CMPS_REG_LSL_IMM5(xECX, x2, 0);
+                            B_MARK(cCC);
+                            MOV_REG(x2, x1);
+                            MOV_REG(x1, xEDI);
+                            MOV_REG(x3, xECX);
+                            CALL(arm_repnz_scasb, x2, 0);
+                            ADD_REG_LSL_IMM5(xEDI, xEDI, x2, 0);
+                            SUB_REG_LSL_IMM5(xECX, xECX, x2, 0);
+                            LDRB_IMM9(x2, xEDI, -1);    // last byte scanned, for the flags
+                            UXTB(x1, xEAX, 0);
+                            B_MARK3(c__);
+                        }
                         MARK;
                         LDRBAI_REG_LSL_IMM5(x2, xEDI, x3, 0);
                         CMPS_REG_LSL_IMM5(x1, x2, 0);
@@ -2521,6 +2634,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                 case 1:
                     INST_NAME("TEST Ed, Id");
                     SETFLAGS(X_ALL, SF_SET);
+                    SETCPSR(CPSR_LOGIC);
                     GETEDH(x1);
                     i32 = F32S;
                     MOV32(x2, i32);
@@ -2662,6 +2776,7 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     break;
                 case 2: // CALL Ed
                     INST_NAME("CALL Ed");
+                    ++dyn->calls;
                     PASS2IF(ninst && dyn->insts && dyn->insts[ninst-1].x86.set_flags, 1) {
                         READFLAGS(X_PEND);          // that's suspicious
                     } else {
@@ -2671,9 +2786,9 @@ uintptr_t dynarec00(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     BARRIER(1);
                     BARRIER_NEXT(1);
                     if(!dyn->nolinker && (!dyn->insts || ninst!=dyn->size-1)) {
-                        PASS2(cstack_push(dyn, ninst, addr, dyn->insts[ninst+1].address, x1, x2);)
+                        PASS2(cstack_push(dyn, ninst, addr, x1, x2);)
                     } else {
-                        PASS2(cstack_push(dyn, ninst, 0, 0, x1, x2);)
+                        PASS2(cstack_push(dyn, ninst, 0, x1, x2);)
                         *need_epilog = 0;
                         *ok = 0;
                         MOV32(x2, addr);
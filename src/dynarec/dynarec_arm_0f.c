@@ -434,15 +434,22 @@ uintptr_t dynarec0F(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
         
         #define GO(GETFLAGS, NO, YES, F)    \
             READFLAGS(F);                   \
-            GETFLAGS;   \
+            FUSECC(opcode);                 \
+            if(CPSR_FUSED) {    \
+                /* the flags are still in the CPSR */   \
+                u8 = cpsr_cond(dyn->insts[ninst-1].cpsr, opcode);   \
+            } else {    \
+                GETFLAGS;   \
+                u8 = ((uint32_t)(YES))>>28; \
+            }   \
             nextop=F8;  \
             GETGD;      \
             if((nextop&0xC0)==0xC0) {   \
                 ed = xEAX+(nextop&7);   \
-                MOV_REG_COND(YES, gd, ed); \
+                MOV_REG_COND((uint32_t)u8<<28, gd, ed); \
             } else { \
                 addr = geted(dyn, addr, ninst, nextop, &ed, x2, &fixedaddress, 4095, 0);    \
-                LDR_IMM9_COND(YES, gd, ed, fixedaddress); \
+                LDR_IMM9_COND((uint32_t)u8<<28, gd, ed, fixedaddress); \
             }
 
         case 0x40:
@@ -1145,20 +1152,32 @@ uintptr_t dynarec0F(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
 
         #define GO(GETFLAGS, NO, YES, F)   \
             READFLAGS(F);   \
+            FUSECC(opcode); \
             i32_ = F32S;    \
-            BARRIER(2);     \
+            BARRIER_JCC;    \
             JUMP(addr+i32_);\
-            GETFLAGS;   \
+            if(CPSR_FUSED) {    \
+                /* the flags are still in the CPSR */   \
+                u8 = cpsr_cond(dyn->insts[ninst-1].cpsr, opcode);   \
+            } else {    \
+                GETFLAGS;   \
+                u8 = ((uint32_t)(YES))>>28; \
+            }   \
             if(dyn->insts) {    \
-                if(dyn->insts[ninst].x86.jmp_insts==-1) {   \
+                if(dyn->insts[ninst].x86.barrier==3) {  \
+                    /* the fpu cache is only purged if taken */ \
+                    jump_cond_purge(dyn, ninst, (uint32_t)(u8^1)<<28, addr+i32_); \
+                } else if(dyn->insts[ninst].x86.jmp_insts==-1) {   \
                     /* out of the block */                  \
                     i32 = dyn->insts[ninst+1].address-(dyn->arm_size+8); \
-                    Bcond(NO, i32);     \
+                    FIXUP(FIXUP_BRANCH, dyn->insts[ninst+1].address); \
+                    Bcond((uint32_t)(u8^1)<<28, i32);     \
                     jump_to_linker(dyn, addr+i32_, 0, ninst); \
                 } else {    \
                     /* inside the block */  \
                     i32 = dyn->insts[dyn->insts[ninst].x86.jmp_insts].address-(dyn->arm_size+8);    \
-                    Bcond(YES, i32);    \
+                    FIXUP(FIXUP_BRANCH, dyn->insts[dyn->insts[ninst].x86.jmp_insts].address); \
+                    Bcond((uint32_t)u8<<28, i32);    \
                 }   \
             }
 
@@ -1271,10 +1290,17 @@ uintptr_t dynarec0F(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
         #undef GO
         #define GO(GETFLAGS, NO, YES, F)    \
             READFLAGS(F);                   \
-            GETFLAGS;   \
+            FUSECC(opcode);                 \
+            if(CPSR_FUSED) {    \
+                /* the flags are still in the CPSR */   \
+                u8 = cpsr_cond(dyn->insts[ninst-1].cpsr, opcode);   \
+            } else {    \
+                GETFLAGS;   \
+                u8 = ((uint32_t)(YES))>>28; \
+            }   \
             nextop=F8;  \
-            MOVW_COND(NO, x3, 0); \
-            MOVW_COND(YES, x3, 1);  \
+            MOVW_COND((uint32_t)(u8^1)<<28, x3, 0); \
+            MOVW_COND((uint32_t)u8<<28, x3, 1);  \
             if((nextop&0xC0)==0xC0) { \
                 ed = (nextop&7);    \
                 eb1 = xEAX+(ed&3);  \
@@ -271,9 +271,9 @@ uintptr_t dynarecFS(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     BARRIER(1);
                     BARRIER_NEXT(1);
                     if(!dyn->nolinker && (!dyn->insts || ninst!=dyn->size-1)) {
-                        PASS2(cstack_push(dyn, ninst, addr, dyn->insts[ninst+1].address, x1, x2);)
+                        PASS2(cstack_push(dyn, ninst, addr, x1, x2);)
                     } else {
-                        PASS2(cstack_push(dyn, ninst, 0, 0, x1, x2);)
+                        PASS2(cstack_push(dyn, ninst, 0, x1, x2);)
                         *need_epilog = 0;
                         *ok = 0;
                         MOV32(x2, addr);
@@ -133,17 +133,22 @@ uintptr_t dynarec67(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             break;
             
         #define GO(NO, YES)   \
-            BARRIER(2); \
+            BARRIER_JCC; \
             JUMP(addr+i8);\
             if(dyn->insts) {    \
-                if(dyn->insts[ninst].x86.jmp_insts==-1) {   \
+                if(dyn->insts[ninst].x86.barrier==3) {  \
+                    /* the fpu cache is only purged if taken */ \
+                    jump_cond_purge(dyn, ninst, NO, addr+i8); \
+                } else if(dyn->insts[ninst].x86.jmp_insts==-1) {   \
                     /* out of the block */                  \
                     i32 = dyn->insts[ninst+1].address-(dyn->arm_size+8); \
+                    FIXUP(FIXUP_BRANCH, dyn->insts[ninst+1].address); \
                     Bcond(NO, i32);     \
                     jump_to_linker(dyn, addr+i8, 0, ninst); \
                 } else {    \
                     /* inside the block */  \
                     i32 = dyn->insts[dyn->insts[ninst].x86.jmp_insts].address-(dyn->arm_size+8);    \
+                    FIXUP(FIXUP_BRANCH, dyn->insts[dyn->insts[ninst].x86.jmp_insts].address); \
                     Bcond(YES, i32);    \
                 }   \
             }
@@ -188,6 +188,8 @@ void emit_sub32(dynarec_arm_t* dyn, int ninst, int s1, int s2, int s3, int s4)
     }
     IFX(X_ALL) {
         SUBS_REG_LSL_IMM5(s1, s1, s2, 0);
+    } else if(CPSR_USED) {
+        SUBS_REG_LSL_IMM5(s1, s1, s2, 0);   // the flags are read from the CPSR by the next instruction
     } else {
         SUB_REG_LSL_IMM5(s1, s1, s2, 0);
     }
@@ -262,6 +264,8 @@ void emit_sub32c(dynarec_arm_t* dyn, int ninst, int s1, int32_t c, int s3, int s
     if(c>=0 && c<256) {
         IFX(X_ALL) {
             SUBS_IMM8(s1, s1, c);
+        } else if(CPSR_USED) {
+            SUBS_IMM8(s1, s1, c);
         } else {
             SUB_IMM8(s1, s1, c);
         }
@@ -269,6 +273,8 @@ void emit_sub32c(dynarec_arm_t* dyn, int ninst, int s1, int32_t c, int s3, int s
         IFXN(X_PEND, X_AF) {} else {MOV32(s3, c);}
         IFX(X_ALL) {
             SUBS_REG_LSL_IMM5(s1, s1, s3, 0);
+        } else if(CPSR_USED) {
+            SUBS_REG_LSL_IMM5(s1, s1, s3, 0);
         } else {
             SUB_REG_LSL_IMM5(s1, s1, s3, 0);
         }
@@ -51,11 +51,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {                   
                 addr = geted(dyn, addr, ninst, nextop, &wback, x3, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREXB(x1, wback);
+                LOCK_LDREXB(x1, wback);
                 emit_add8(dyn, ninst, x1, x2, x12, x3, (wback==x3)?1:0);
-                STREXB(x12, x1, wback);
-                CMPS_IMM8(x12, 0);
-                B_MARKLOCK(cNE);    // write failed, try again
+                LOCK_STREXB(x12, x1, wback);
             }
             break;
         case 0x01:
@@ -69,11 +67,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {
                 addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREX(x1, wback);
+                LOCK_LDREX(x1, wback);
                 emit_add32(dyn, ninst, x1, gd, x3, x12);
-                STREX(x3, x1, wback);
-                CMPS_IMM8(x3, 0);
-                B_MARKLOCK(cNE);
+                LOCK_STREX(x3, x1, wback);
             }
             break;
         case 0x08:
@@ -91,11 +87,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {                   
                 addr = geted(dyn, addr, ninst, nextop, &wback, x3, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREXB(x1, wback);
+                LOCK_LDREXB(x1, wback);
                 emit_or8(dyn, ninst, x1, x2, x12, x3, (wback==x3)?1:0);
-                STREXB(x12, x1, wback);
-                CMPS_IMM8(x12, 0);
-                B_MARKLOCK(cNE);    // write failed, try again
+                LOCK_STREXB(x12, x1, wback);
             }
             break;
         case 0x09:
@@ -109,11 +103,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {
                 addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREX(x1, wback);
+                LOCK_LDREX(x1, wback);
                 emit_or32(dyn, ninst, x1, gd, x3, x12);
-                STREX(x3, x1, wback);
-                CMPS_IMM8(x3, 0);
-                B_MARKLOCK(cNE);
+                LOCK_STREX(x3, x1, wback);
             }
             break;
         case 0x10:
@@ -131,11 +123,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {                   
                 addr = geted(dyn, addr, ninst, nextop, &wback, x3, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREXB(x1, wback);
+                LOCK_LDREXB(x1, wback);
                 emit_adc8(dyn, ninst, x1, x2, x12, x3, (wback==x3)?1:0);
-                STREXB(x12, x1, wback);
-                CMPS_IMM8(x12, 0);
-                B_MARKLOCK(cNE);    // write failed, try again
+                LOCK_STREXB(x12, x1, wback);
             }
             break;
         case 0x11:
@@ -149,11 +139,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {
                 addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREX(x1, wback);
+                LOCK_LDREX(x1, wback);
                 emit_adc32(dyn, ninst, x1, gd, x3, x12);
-                STREX(x3, x1, wback);
-                CMPS_IMM8(x3, 0);
-                B_MARKLOCK(cNE);
+                LOCK_STREX(x3, x1, wback);
             }
             break;
         case 0x18:
@@ -171,11 +159,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {                   
                 addr = geted(dyn, addr, ninst, nextop, &wback, x3, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREXB(x1, wback);
+                LOCK_LDREXB(x1, wback);
                 emit_sbb8(dyn, ninst, x1, x2, x12, x3, (wback==x3)?1:0);
-                STREXB(x12, x1, wback);
-                CMPS_IMM8(x12, 0);
-                B_MARKLOCK(cNE);    // write failed, try again
+                LOCK_STREXB(x12, x1, wback);
             }
             break;
         case 0x19:
@@ -189,11 +175,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {
                 addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREX(x1, wback);
+                LOCK_LDREX(x1, wback);
                 emit_sbb32(dyn, ninst, x1, gd, x3, x12);
-                STREX(x3, x1, wback);
-                CMPS_IMM8(x3, 0);
-                B_MARKLOCK(cNE);
+                LOCK_STREX(x3, x1, wback);
             }
             break;
         case 0x20:
@@ -211,11 +195,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {                   
                 addr = geted(dyn, addr, ninst, nextop, &wback, x3, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREXB(x1, wback);
+                LOCK_LDREXB(x1, wback);
                 emit_and8(dyn, ninst, x1, x2, x12, x3, (wback==x3)?1:0);
-                STREXB(x12, x1, wback);
-                CMPS_IMM8(x12, 0);
-                B_MARKLOCK(cNE);    // write failed, try again
+                LOCK_STREXB(x12, x1, wback);
             }
             break;
         case 0x21:
@@ -229,11 +211,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {
                 addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREX(x1, wback);
+                LOCK_LDREX(x1, wback);
                 emit_and32(dyn, ninst, x1, gd, x3, x12);
-                STREX(x3, x1, wback);
-                CMPS_IMM8(x3, 0);
-                B_MARKLOCK(cNE);
+                LOCK_STREX(x3, x1, wback);
             }
             break;
         case 0x28:
@@ -251,11 +231,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {                   
                 addr = geted(dyn, addr, ninst, nextop, &wback, x3, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREXB(x1, wback);
+                LOCK_LDREXB(x1, wback);
                 emit_sub8(dyn, ninst, x1, x2, x12, x3, (wback==x3)?1:0);
-                STREXB(x12, x1, wback);
-                CMPS_IMM8(x12, 0);
-                B_MARKLOCK(cNE);    // write failed, try again
+                LOCK_STREXB(x12, x1, wback);
             }
             break;
         case 0x29:
@@ -269,11 +247,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {
                 addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREX(x1, wback);
+                LOCK_LDREX(x1, wback);
                 emit_sub32(dyn, ninst, x1, gd, x3, x12);
-                STREX(x3, x1, wback);
-                CMPS_IMM8(x3, 0);
-                B_MARKLOCK(cNE);
+                LOCK_STREX(x3, x1, wback);
             }
             break;
         case 0x38:
@@ -291,11 +267,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {                   
                 addr = geted(dyn, addr, ninst, nextop, &wback, x3, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREXB(x1, wback);
+                LOCK_LDREXB(x1, wback);
                 emit_xor8(dyn, ninst, x1, x2, x12, x3, (wback==x3)?1:0);
-                STREXB(x12, x1, wback);
-                CMPS_IMM8(x12, 0);
-                B_MARKLOCK(cNE);    // write failed, try again
+                LOCK_STREXB(x12, x1, wback);
             }
             break;
         case 0x39:
@@ -309,11 +283,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
             } else {
                 addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                 MARKLOCK;
-                LDREX(x1, wback);
+                LOCK_LDREX(x1, wback);
                 emit_xor32(dyn, ninst, x1, gd, x3, x12);
-                STREX(x3, x1, wback);
-                CMPS_IMM8(x3, 0);
-                B_MARKLOCK(cNE);
+                LOCK_STREX(x3, x1, wback);
             }
             break;
 
@@ -338,11 +310,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         TSTS_IMM8(wback, 0x3);
                         B_MARK(cNE);
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         emit_add32c(dyn, ninst, x1, i32, x3, x12);
-                        STREX(x3, x1, wback);
-                        CMPS_IMM8(x3, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x3, x1, wback);
                         B_NEXT(c__);
                         MARK;   // unaligned! also, not enough 
                         LDR_IMM9(x1, wback, 0);
@@ -366,11 +336,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                         if(opcode==0x81) i32 = F32S; else i32 = F8S;
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         emit_or32c(dyn, ninst, x1, i32, x3, x12);
-                        STREX(x3, x1, wback);
-                        CMPS_IMM8(x3, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x3, x1, wback);
                     }
                     break;
                 case 2: //ADC
@@ -385,11 +353,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                         if(opcode==0x81) i32 = F32S; else i32 = F8S;
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         emit_adc32c(dyn, ninst, x1, i32, x3, x12);
-                        STREX(x3, x1, wback);
-                        CMPS_IMM8(x3, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x3, x1, wback);
                     }
                     break;
                 case 3: //SBB
@@ -404,11 +370,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                         if(opcode==0x81) i32 = F32S; else i32 = F8S;
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         emit_sbb32c(dyn, ninst, x1, i32, x3, x12);
-                        STREX(x3, x1, wback);
-                        CMPS_IMM8(x3, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x3, x1, wback);
                     }
                     break;
                 case 4: //AND
@@ -422,11 +386,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                         if(opcode==0x81) i32 = F32S; else i32 = F8S;
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         emit_and32c(dyn, ninst, x1, i32, x3, x12);
-                        STREX(x3, x1, wback);
-                        CMPS_IMM8(x3, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x3, x1, wback);
                     }
                     break;
                 case 5: //SUB
@@ -442,11 +404,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         TSTS_IMM8(wback, 0x3);
                         B_MARK(cNE);
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         emit_sub32c(dyn, ninst, x1, i32, x3, x12);
-                        STREX(x3, x1, wback);
-                        CMPS_IMM8(x3, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x3, x1, wback);
                         B_NEXT(c__);
                         MARK;   // unaligned! also, not enough 
                         LDR_IMM9(x1, wback, 0);
@@ -470,11 +430,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                         if(opcode==0x81) i32 = F32S; else i32 = F8S;
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         emit_xor32c(dyn, ninst, x1, i32, x3, x12);
-                        STREX(x3, x1, wback);
-                        CMPS_IMM8(x3, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x3, x1, wback);
                     }
                     break;
                 case 7: //CMP
@@ -539,7 +497,7 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     } else {                   
                         addr = geted(dyn, addr, ninst, nextop, &wback, x3, &fixedaddress, 0, 0);
                         MARKLOCK;
-                        LDREXB(x2, wback);
+                        LOCK_LDREXB(x2, wback);
                         ed = x2;
                         wb1 = 1;
                     }
@@ -549,9 +507,7 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     // AL == Eb
                     GETGB(x1);
                     if(wb1) {
-                        STREXB(x12, x1, wback);
-                        CMPS_IMM8(x12, 0);
-                        B_MARKLOCK(cNE);    // write failed, try again
+                        LOCK_STREXB(x12, x1, wback);
                         if(!(gb1==xEAX && gb2==0)) {
                             UXTB(x1, xEAX, 0);  // readback AL if needed
                         }
@@ -578,23 +534,32 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     } else {
                         addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                         MARKLOCK;
-                        TSTS_IMM8(wback, 3);    // can be unaligned it seems
-                        LDREX_COND(cEQ, x1, wback);
-                        LDR_IMM9_COND(cNE, x1, wback, 0);
-                        LDREXB_COND(cNE, x3, wback); // dummy read, to arm the write...
+                        if(dyn->nolock) {
+                            dyn->elided = 1;
+                            LDR_IMM9(x1, wback, 0);
+                        } else {
+                            TSTS_IMM8(wback, 3);    // can be unaligned it seems
+                            LDREX_COND(cEQ, x1, wback);
+                            LDR_IMM9_COND(cNE, x1, wback, 0);
+                            LDREXB_COND(cNE, x3, wback); // dummy read, to arm the write...
+                        }
                         ed = x1;
                     }
                     CMPS_REG_LSL_IMM5(xEAX, ed, 0);
                     B_MARK(cNE);
                     // EAX == Ed
                     if(wback) {
-                        TSTS_IMM8(wback, 3);
-                        STREX_COND(cEQ, x12, gd, wback);
-                        STREXB_COND(cNE, x12, gd, wback);
-                        CMPS_IMM8(x12, 0);
-                        B_MARKLOCK(cNE);
-                        TSTS_IMM8(wback, 3);    // anoying, all those test
-                        STR_IMM9_COND(cNE, gd, wback, 0);
+                        if(dyn->nolock) {
+                            STR_IMM9(gd, wback, 0);
+                        } else {
+                            TSTS_IMM8(wback, 3);
+                            STREX_COND(cEQ, x12, gd, wback);
+                            STREXB_COND(cNE, x12, gd, wback);
+                            CMPS_IMM8(x12, 0);
+                            B_MARKLOCK(cNE);
+                            TSTS_IMM8(wback, 3);    // anoying, all those test
+                            STR_IMM9_COND(cNE, gd, wback, 0);
+                        }
                         emit_cmp32(dyn, ninst, xEAX, ed, x1, x12);
                     } else {
                         emit_cmp32(dyn, ninst, xEAX, ed, x1, x12);
@@ -622,7 +587,7 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         ADD_REG_LSL_IMM5(x3, wback, x1, 2); //(&ed)+=r1*4;
                         wback = x3;
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         ed = x1;
                     }
                     AND_IMM8(x2, gd, 0x1f);
@@ -633,9 +598,7 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     MOVW(x12, 1);
                     XOR_REG_LSL_REG(ed, ed, x12, x2);
                     if(wback) {
-                        STREX(x12, ed, wback);
-                        CMPS_IMM8(x12, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x12, ed, wback);
                     }
                     MARK3;
                     break;
@@ -681,7 +644,7 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                                 UBFX(x1, gd, 5, 3); // r1 = (gd>>5);
                                 ADD_REG_LSL_IMM5(x3, ed, x1, 2); //(&ed)+=r1*4;
                                 MARKLOCK;
-                                LDREX(x1, x3);
+                                LOCK_LDREX(x1, x3);
                                 ed = x1;
                                 wback = x3;
                             }
@@ -693,9 +656,7 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                             //MOVW(x12, 1); // already 0x01
                             XOR_REG_LSL_REG(ed, ed, x12, x2);
                             if(wback) {
-                                STREX(x12, ed, wback);
-                                CMPS_IMM8(x12, 0);
-                                B_MARKLOCK(cNE);
+                                LOCK_STREX(x12, ed, wback);
                             }
                             MARK3;
                             break;
@@ -716,7 +677,7 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         UBFX(x1, gd, 5, 3); // r1 = (gd>>5);
                         ADD_REG_LSL_IMM5(x3, wback, x1, 2); //(&ed)+=r1*4;
                         MARKLOCK;
-                        LDREX(x1, x3);
+                        LOCK_LDREX(x1, x3);
                         ed = x1;
                         wback = x3;
                     }
@@ -727,9 +688,7 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     MOVW(x12, 1);
                     XOR_REG_LSL_REG(ed, ed, x12, x2);
                     if(wback) {
-                        STREX(x12, ed, wback);
-                        CMPS_IMM8(x12, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x12, ed, wback);
                     }
                     break;
             
@@ -748,16 +707,14 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     } else { 
                         addr = geted(dyn, addr, ninst, nextop, &wback, x3, &fixedaddress, 0, 0); 
                         MARKLOCK;
-                        LDREXB(x2, wback); 
+                        LOCK_LDREXB(x2, wback); 
                         wb1 = 1;
                         ed = x2;
                     }
                     BFI(gb1, ed, gb2*8, 8); // gb <- eb
                     emit_add8(dyn, ninst, ed, gd, x12, x3, 1);
                     if(wb1) {
-                        STREXB(x12, ed, wback);
-                        CMPS_IMM8(x12, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREXB(x12, ed, wback);
                     } else {
                         BFI(wback, ed, wb2*8, 8);
                     }
@@ -780,11 +737,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                         TSTS_IMM8(wback, 3);
                         B_MARK(cNE);    // unaligned
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         ADD_REG_LSL_IMM5(x12, x1, gd, 0);
-                        STREX(x3, x12, wback);
-                        CMPS_IMM8(x3, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x3, x12, wback);
                         IFX(X_ALL|X_PEND) {
                             MOV_REG(x2, x1);
                             emit_add32(dyn, ninst, x2, gd, x3, x12);
@@ -814,23 +769,34 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     nextop = F8;
                     addr = geted(dyn, addr, ninst, nextop, &wback, x1, &fixedaddress, 0, 0);
                     MARKLOCK;
-                    TSTS_IMM8(wback, 7);
-                    LDREXD_COND(cEQ, x2, wback);
-                    LDREX_COND(cNE, x2, wback);
-                    LDR_IMM9_COND(cNE, x3, wback, 4);
+                    if(dyn->nolock) {
+                        dyn->elided = 1;
+                        LDR_IMM9(x2, wback, 0);
+                        LDR_IMM9(x3, wback, 4);
+                    } else {
+                        TSTS_IMM8(wback, 7);
+                        LDREXD_COND(cEQ, x2, wback);
+                        LDREX_COND(cNE, x2, wback);
+                        LDR_IMM9_COND(cNE, x3, wback, 4);
+                    }
                     CMPS_REG_LSL_IMM5(xEAX, x2, 0);
                     B_MARK(cNE);    // EAX != Ed[0]
                     CMPS_REG_LSL_IMM5(xEDX, x3, 0);
                     B_MARK(cNE);    // EDX != Ed[1]
                     MOV_REG(x2, xEBX);
                     MOV_REG(x3, xECX);
-                    TSTS_IMM8(wback, 7);
-                    STREXD_COND(cEQ, x12, x2, wback);
-                    STREX_COND(cNE, x12, x2, wback);
-                    CMPS_IMM8(x12, 0);
-                    B_MARKLOCK(cNE);
-                    TSTS_IMM8(wback, 7);
-                    STR_IMM9_COND(cNE, x3, wback, 4);
+                    if(dyn->nolock) {
+                        STR_IMM9(x2, wback, 0);
+                        STR_IMM9(x3, wback, 4);
+                    } else {
+                        TSTS_IMM8(wback, 7);
+                        STREXD_COND(cEQ, x12, x2, wback);
+                        STREX_COND(cNE, x12, x2, wback);
+                        CMPS_IMM8(x12, 0);
+                        B_MARKLOCK(cNE);
+                        TSTS_IMM8(wback, 7);
+                        STR_IMM9_COND(cNE, x3, wback, 4);
+                    }
                     MOVW(x1, 1);
                     B_MARK3(c__);
                     MARK;
@@ -860,11 +826,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     } else {
                         addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         emit_inc32(dyn, ninst, x1, x3, x12);
-                        STREX(x3, x1, wback);
-                        CMPS_IMM8(x3, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x3, x1, wback);
                     }
                     break;
                 case 1: //DEC Ed
@@ -876,11 +840,9 @@ uintptr_t dynarecF0(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst,
                     } else {
                         addr = geted(dyn, addr, ninst, nextop, &wback, x2, &fixedaddress, 0, 0);
                         MARKLOCK;
-                        LDREX(x1, wback);
+                        LOCK_LDREX(x1, wback);
                         emit_dec32(dyn, ninst, x1, x3, x12);
-                        STREX(x3, x1, wback);
-                        CMPS_IMM8(x3, 0);
-                        B_MARKLOCK(cNE);
+                        LOCK_STREX(x3, x1, wback);
                     }
                     break;
                 default:
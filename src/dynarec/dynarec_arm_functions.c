@@ -24,6 +24,8 @@
 #include "dynarec_arm.h"
 #include "dynarec_arm_private.h"
 #include "dynarec_arm_functions.h"
+#include "wrapper.h"
+#include "dynathunk.h"
 
 void arm_popf(x86emu_t* emu, uint32_t f)
 {
@@ -156,6 +158,35 @@ void arm_ud(x86emu_t* emu)
     kill(getpid(), SIGILL);
 }
 
+void arm_rep_movs(x86emu_t* emu, void* dst, void* src, uint32_t size)
+{
+    // the caller made sure dst is not inside [src, src+size[, so memmove gives the same result as the x86 forward copy
+    memmove(dst, src, size);
+}
+
+void arm_rep_stosb(x86emu_t* emu, void* dst, uint32_t val, uint32_t size)
+{
+    memset(dst, val&0xff, size);
+}
+
+void arm_rep_stosd(x86emu_t* emu, void* dst, uint32_t val, uint32_t size)
+{
+    if(((val&0xff)*0x01010101)==val) {
+        memset(dst, val&0xff, size);
+        return;
+    }
+    uint32_t* p = (uint32_t*)dst;
+    for(uint32_t i=0; i<size/4; ++i)
+        p[i] = val;
+}
+
+// return the number of bytes scanned, including the one found (if any)
+uint32_t arm_repnz_scasb(x86emu_t* emu, void* dst, uint32_t val, uint32_t size)
+{
+    uint8_t* p = (uint8_t*)memchr(dst, val&0xff, size);
+    return p?(p-(uint8_t*)dst+1):size;
+}
+
 void arm_fsave(x86emu_t* emu, uint8_t* ed)
 {
     fpu_savenv(emu, (char*)ed, 0);
@@ -266,6 +297,18 @@ void fpu_reset_reg(dynarec_arm_t* dyn)
         dyn->fpuused[i]=0;
 }
 
+int cpsr_cond(int cpsr, int cc)
+{
+    // x86 conditions: O NO C NC Z NZ BE A S NS P NP L GE LE G
+    static const int sub[16]   = { 6,  7,  3,  2,  0,  1,  9,  8,  4,  5, -1, -1, 11, 10, 13, 12};
+    static const int logic[16] = {-1, -1, -1, -1,  0,  1,  0,  1,  4,  5, -1, -1,  4,  5, -1, -1};
+    switch(cpsr) {
+        case CPSR_SUB:      return sub[cc&15];
+        case CPSR_LOGIC:    return logic[cc&15];   // CF=OF=0: BE is Z, L is S
+    }
+    return -1;
+}
+
 // Get if ED will have the correct parity. Not emiting anything. Parity is 2 for DWORD or 3 for QWORD
 int getedparity(dynarec_arm_t* dyn, int ninst, uintptr_t addr, uint8_t nextop, int parity)
 {
@@ -332,3 +375,21 @@ int isNativeCall(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t* calladdress, int
 #undef PK
 }
 
+const char* getNativeCallSignature(uintptr_t calladdress)
+{
+    if(box86_log>=LOG_DEBUG)
+        return NULL;    // native calls are traced by x86Int3
+    onebridge_t *b = (onebridge_t*)(calladdress-1);
+    const char* sig = GetWrapperSignature(DynaThunkWrapper(b->w));
+    if(!sig || strlen(sig)>2+4)
+        return NULL;
+    if(!strchr("vipuLlIU", sig[0]))
+        return NULL;
+    if(!strcmp(sig+1, "Fv"))
+        return sig;
+    for(const char* p=sig+2; *p; ++p)
+        if(!strchr("ipuLl", *p))
+            return NULL;
+    return sig;
+}
+
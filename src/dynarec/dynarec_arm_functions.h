@@ -32,6 +32,12 @@ void arm_fprem1(x86emu_t* emu);
 
 void arm_ud(x86emu_t* emu);
 
+// REP MOVS/STOS/SCAS with DF=0 on big sizes
+void arm_rep_movs(x86emu_t* emu, void* dst, void* src, uint32_t size);
+void arm_rep_stosb(x86emu_t* emu, void* dst, uint32_t val, uint32_t size);
+void arm_rep_stosd(x86emu_t* emu, void* dst, uint32_t val, uint32_t size);
+uint32_t arm_repnz_scasb(x86emu_t* emu, void* dst, uint32_t val, uint32_t size);
+
 // Get an FPU single scratch reg
 int fpu_get_scratch_single(dynarec_arm_t* dyn);
 // Get an FPU double scratch reg
@@ -51,10 +57,16 @@ void fpu_free_reg_quad(dynarec_arm_t* dyn, int reg);
 // Reset fpu regs counter
 void fpu_reset_reg(dynarec_arm_t* dyn);
 
+// ARM condition (0..14) for the x86 condition cc (low 4 bits of Jcc/SETcc/CMOVcc) when the CPSR holds cpsr (CPSR_xxx), -1 if it cannot be done
+int cpsr_cond(int cpsr, int cc);
+
 // Get if ED will have the correct parity. Not emiting anything. Parity is 2 for DWORD or 3 for QWORD
 int getedparity(dynarec_arm_t* dyn, int ninst, uintptr_t addr, uint8_t nextop, int parity);
 
 // Is what pointed at addr a native call? And if yes, to what function?
 int isNativeCall(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t* calladdress, int* retn);
+// Can the native function at calladdress (from isNativeCall) be called directly, without the wrapper?
+// Only for 32bits integer or pointer args (at most 4, so they fit in r0-r3), and integer or no result. Return the wrapper signature, or NULL
+const char* getNativeCallSignature(uintptr_t calladdress);
 
 #endif //__DYNAREC_ARM_FUNCTIONS_H__
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 #include <pthread.h>
 #include <errno.h>
 
@@ -288,6 +289,15 @@ void jump_to_linker(dynarec_arm_t* dyn, uintptr_t ip, int reg, int ninst)
             table[0] = (uintptr_t)arm_linker;
             table[1] = ip;
         }
+        if(!ip)
+            ibtc_jump(dyn, ninst);  // try the IBTC first, in case the target changes often
+        else if(box86_dynarec_patch) {
+            // will become a direct branch to the target once linked (see DynaLinkTable)
+            if(dyn->patch)
+                dyn->patch[dyn->tablei/4] = (uintptr_t)dyn->block;
+            NOP_HINT;
+        }
+        RELOC(RELOC_TABLE, 0, dyn->tablei*sizeof(uintptr_t), 0);
         dyn->tablei+=4; // smart linker or not, we keep table correctly alligned for LDREXD/STREXD access
         MOV32_(x1, (uintptr_t)table);
         // TODO: This is not thread safe.
@@ -311,6 +321,79 @@ void jump_to_linker(dynarec_arm_t* dyn, uintptr_t ip, int reg, int ninst)
     }
 }
 
+// conditional jump to ip (taken if not "no"), the fpu cache being purged only on the taken path. Use x1, x2 and x3
+void jump_cond_purge(dynarec_arm_t* dyn, int ninst, int no, uintptr_t ip)
+{
+    int j32;
+    int k = dyn->insts[ninst].x86.jmp_insts;
+    if(k!=-1 && !fpu_cached(dyn)) {
+        // nothing to purge, direct jump inside the block
+        j32 = dyn->insts[k].address-(dyn->arm_size+8);
+        FIXUP(FIXUP_BRANCH, dyn->insts[k].address);
+        Bcond((no^(1<<28)), j32);
+        return;
+    }
+    MESSAGE(LOG_DUMP, "Jump with cache purge\n");
+    j32 = dyn->insts[ninst+1].address-(dyn->arm_size+8);
+    FIXUP(FIXUP_BRANCH, dyn->insts[ninst+1].address);
+    Bcond(no, j32);
+    fpu_purgecache_jump(dyn, ninst, x1, x2, x3);
+    if(k==-1) {
+        jump_to_linker(dyn, ip, 0, ninst);
+    } else {
+        j32 = dyn->insts[k].address-(dyn->arm_size+8);
+        FIXUP(FIXUP_BRANCH, dyn->insts[k].address);
+        Bcond(c__, j32);
+    }
+}
+
+void hot_counter(dynarec_arm_t* dyn, uintptr_t ip, int ninst)
+{
+    MESSAGE(LOG_DUMP, "Hot counter (#%d)\n", dyn->tablei);
+    // entry of the block, will become "ldr pc, [pc, #-4]" with the address of the higher tier block
+    Bcond(c__, 0);
+    EMIT(0);
+    // the counter is the 4th slot of the 1st table entry, that entry being a jump to the linker at the start of this block
+    uintptr_t* table = 0;
+    if(dyn->tablesz)
+        table = &dyn->table[dyn->tablei];
+    MAYUSE(table);
+    RELOC(RELOC_TABLE, 0, dyn->tablei*sizeof(uintptr_t), 0);
+    MOV32_(x1, (uintptr_t)table);
+    LDR_IMM9(x2, x1, 12);
+    SUBS_IMM8(x2, x2, 1);
+    STR_IMM9(x2, x1, 12);
+    Bcond(cNE, (box86_dynarec_patch?6:5)*4);    // skip the jump to linker (6 opcodes, 7 with the patch slot)
+    jump_to_linker(dyn, ip, 0, ninst);
+}
+
+// look for xEIP in the IBTC, and jump to the native code if found. Use x1, x2 and x3
+void ibtc_jump(dynarec_arm_t* dyn, int ninst)
+{
+    if(!box86_dynarec_ibtc)
+        return;
+    MESSAGE(LOG_DUMP, "IBTC lookup\n");
+    MOV32_(x1, (uintptr_t)arm_ibtc);
+    UBFX(x2, xEIP, 0, IBTC_BITS);
+    ADD_REG_LSL_IMM5(x1, x1, x2, 3);
+    LDREXD(x2, x1); // load x86 address in x2 and native address in x3
+    CMPS_REG_LSL_IMM5(xEIP, x2, 0);
+    if(box86_dynarec_stats) {
+        Bcond(cNE, 5*4);    // skip the hit counter (6 opcodes)
+        MOV32_(x1, (uintptr_t)&arm_ibtc_hits);
+        LDR_IMM9(x2, x1, 0);
+        ADD_IMM8(x2, x2, 1);
+        STR_IMM9(x2, x1, 0);
+        BX(x3);
+        MOV32_(x1, (uintptr_t)&arm_ibtc_misses);
+        LDR_IMM9(x2, x1, 0);
+        ADD_IMM8(x2, x2, 1);
+        STR_IMM9(x2, x1, 0);
+    } else {
+        BXcond(cEQ, x3);
+    }
+}
+
 void ret_to_epilog(dynarec_arm_t* dyn, int ninst)
 {
 // using linker here doesn't seem to bring any significant speed improvment. To much change in the jump table probably
@@ -322,6 +405,7 @@ void ret_to_epilog(dynarec_arm_t* dyn, int ninst)
         MESSAGE(LOG_DUMP, "Ret epilog\n");
         POP(xESP, 1<<xEIP);
         cstack_pop(dyn, ninst, xEIP, x1, x2);
+        ibtc_jump(dyn, ninst);
         PASS3(void* epilog = arm_epilog);
         MOV32_(x2, (uintptr_t)epilog);
         BX(x2);
@@ -369,6 +453,7 @@ void retn_to_epilog(dynarec_arm_t* dyn, int ninst, int n)
             ADD_IMM8(xESP, xESP, n);
         }
         cstack_pop(dyn, ninst, xEIP, x1, x2);
+        ibtc_jump(dyn, ninst);
         PASS3(void* epilog = arm_epilog);
         MOV32_(x2, (uintptr_t)epilog);
         BX(x2);
@@ -401,6 +486,25 @@ void retn_to_epilog(dynarec_arm_t* dyn, int ninst, int n)
 #endif
 }
 
+// RET of an inlined function: POP the return address, and go on in the block if it's the expected one
+void ret_inlined(dynarec_arm_t* dyn, int ninst, int n)
+{
+    int32_t j32;
+    MAYUSE(j32);
+    MESSAGE(LOG_DUMP, "Inlined Ret to %p\n", (void*)dyn->inline_ret);
+    POP(xESP, 1<<xEIP);
+    if(n>0xff) {
+        MOVW(x1, n);
+        ADD_REG_LSL_IMM5(xESP, xESP, x1, 0);
+    } else if(n) {
+        ADD_IMM8(xESP, xESP, n);
+    }
+    MOV32(x3, dyn->inline_ret);
+    CMPS_REG_LSL_IMM5(xEIP, x3, 0);
+    B_NEXT(cEQ);
+    jump_to_epilog(dyn, 0, xEIP, ninst);    // the return address has been changed
+}
+
 void iret_to_epilog(dynarec_arm_t* dyn, int ninst)
 {
     MESSAGE(LOG_DUMP, "IRet epilog\n");
@@ -473,6 +577,93 @@ void grab_fsdata(dynarec_arm_t* dyn, uintptr_t addr, int ninst, int reg)
     MESSAGE(LOG_DUMP, "----FS: Offset\n");
 }
 
+// REP MOVS / REP STOS of 1<<s bytes elements. With DF=0 and enough data, use NEON (or native memmove/memset for big sizes).
+// Fall back to the element by element loop for DF=1, small counts or an overlap that would repeat a pattern. Use x1, x2, x3 and x12
+void rep_movs(dynarec_arm_t* dyn, int ninst, int s, int stos)
+{
+    int32_t j32;
+    MAYUSE(j32);
+    TSTS_REG_LSL_IMM5(xECX, xECX, 0);
+    B_NEXT(cEQ);    // end of loop
+    GETDIR(x3, 1<<s);
+    B_MARK(cEQ);    // backward
+    if(s) {
+        MOV_REG_LSR_IMM5(x1, xECX, 32-s);
+        CMPS_IMM8(x1, 0);
+        B_MARK(cNE);    // size in bytes would not fit
+    }
+    MOV_REG_LSL_IMM5(x2, xECX, s);  // size in bytes
+    CMPS_IMM8(x2, REP_BULK_MIN);
+    B_MARK(cCC);
+    if(!stos) {
+        // EDI inside [ESI, ESI+size[ means the copy read what it just wrote
+        SUB_REG_LSL_IMM5(x1, xEDI, xESI, 0);
+        CMPS_REG_LSL_IMM5(x1, x2, 0);
+        B_MARK(cCC);
+    }
+    MOVW(x1, REP_BULK_NATIVE);
+    CMPS_REG_LSL_IMM5(x2, x1, 0);
+    B_MARK3(cCS);
+    // NEON, 16 bytes at a time. ECX is updated with ESI/EDI at each step, so they are consistent if a load or store faults
+    int q0 = fpu_get_scratch_quad(dyn);
+    MAYUSE(q0);
+    if(stos) {
+        if(s) {
+            VMOVtoV_D(q0, xEAX, xEAX);
+            VMOVtoV_D(q0+1, xEAX, xEAX);
+        } else {
+            UXTB(x1, xEAX, 0);
+            ORR_REG_LSL_IMM5(x1, x1, x1, 8);
+            ORR_REG_LSL_IMM5(x1, x1, x1, 16);
+            VMOVtoV_D(q0, x1, x1);
+            VMOVtoV_D(q0+1, x1, x1);
+        }
+    }
+    MARK2;
+    if(!stos) {
+        VLD1Q_8_W(q0, xESI);    // byte elements: the buffers can have any alignment
+    }
+    VST1Q_8_W(q0, xEDI);
+    SUB_IMM8(xECX, xECX, 16>>s);
+    CMPS_IMM8(xECX, 16>>s);
+    B_MARK2(cCS);
+    // finish the last bytes with the regular loop (x3 is still the direction)
+    TSTS_REG_LSL_IMM5(xECX, xECX, 0);
+    B_NEXT(cEQ);
+    B_MARK(c__);
+    // big size, use native function
+    MARK3;
+    MOV_REG(x3, x2);
+    MOV_REG(x1, xEDI);
+    MOV_REG(x2, stos?xEAX:xESI);
+    CALL(stos?(s?(void*)arm_rep_stosd:(void*)arm_rep_stosb):(void*)arm_rep_movs, -1, 0);
+    ADD_REG_LSL_IMM5(xEDI, xEDI, xECX, s);
+    if(!stos) {
+        ADD_REG_LSL_IMM5(xESI, xESI, xECX, s);
+    }
+    MOVW(xECX, 0);
+    B_NEXT(c__);
+    // element by element
+    MARK;
+    if(stos) {
+        if(s) {
+            STRAI_REG_LSL_IMM5(xEAX, xEDI, x3, 0);
+        } else {
+            STRBAI_REG_LSL_IMM5(xEAX, xEDI, x3, 0);
+        }
+    } else {
+        if(s) {
+            LDRAI_REG_LSL_IMM5(x1, xESI, x3, 0);
+            STRAI_REG_LSL_IMM5(x1, xEDI, x3, 0);
+        } else {
+            LDRBAI_REG_LSL_IMM5(x1, xESI, x3, 0);
+            STRBAI_REG_LSL_IMM5(x1, xEDI, x3, 0);
+        }
+    }
+    SUBS_IMM8(xECX, xECX, 1);
+    B_MARK(cNE);
+}
+
 // x87 stuffs
 static void x87_reset(dynarec_arm_t* dyn, int ninst)
 {
@@ -1139,6 +1330,38 @@ void fpu_purgecache(dynarec_arm_t* dyn, int ninst, int s1, int s2, int s3)
     fpu_reset_reg(dyn);
 }
 
+// purge the cache on a side exit only: the code that follows still has the registers cached
+void fpu_purgecache_jump(dynarec_arm_t* dyn, int ninst, int s1, int s2, int s3)
+{
+    int x87cache[8], x87reg[8], mmxcache[8], ssecache[8], fpuused[24];
+    memcpy(x87cache, dyn->x87cache, sizeof(x87cache));
+    memcpy(x87reg, dyn->x87reg, sizeof(x87reg));
+    memcpy(mmxcache, dyn->mmxcache, sizeof(mmxcache));
+    memcpy(ssecache, dyn->ssecache, sizeof(ssecache));
+    memcpy(fpuused, dyn->fpuused, sizeof(fpuused));
+    int x87stack = dyn->x87stack;
+    int fpu_reg = dyn->fpu_reg;
+    fpu_purgecache(dyn, ninst, s1, s2, s3);
+    memcpy(dyn->x87cache, x87cache, sizeof(x87cache));
+    memcpy(dyn->x87reg, x87reg, sizeof(x87reg));
+    memcpy(dyn->mmxcache, mmxcache, sizeof(mmxcache));
+    memcpy(dyn->ssecache, ssecache, sizeof(ssecache));
+    memcpy(dyn->fpuused, fpuused, sizeof(fpuused));
+    dyn->x87stack = x87stack;
+    dyn->fpu_reg = fpu_reg;
+}
+
+// is there anything to purge in the cache?
+int fpu_cached(dynarec_arm_t* dyn)
+{
+    if(dyn->x87stack)
+        return 1;
+    for(int i=0; i<8; ++i)
+        if(dyn->x87cache[i]!=-1 || dyn->mmxcache[i]!=-1 || dyn->ssecache[i]!=-1)
+            return 1;
+    return 0;
+}
+
 #ifdef HAVE_TRACE
 void fpu_reflectcache(dynarec_arm_t* dyn, int ninst, int s1, int s2, int s3)
 {
@@ -1180,11 +1403,12 @@ void fpu_putback_single_reg(dynarec_arm_t* dyn, int ninst, int reg, int idx, int
 }
 
 
-// PUSH a x86/native couple of address in cstack, using s1, s2, s2+1
-void cstack_push(dynarec_arm_t* dyn, int ninst, uintptr_t x86ip, uintptr_t armip, int s1, int s2)
+// PUSH a x86/native couple of address in cstack (the native one is the next instruction), using s1, s2, s2+1
+void cstack_push(dynarec_arm_t* dyn, int ninst, uintptr_t x86ip, int s1, int s2)
 {
+    uintptr_t armip = 0;
     if(x86ip)
-        armip+=dyn->arm_start;
+        armip = dyn->arm_start+dyn->insts[ninst+1].address;
     MESSAGE(LOG_DUMP, "CStack PUSH %p/%p-----\n", (void*)x86ip, (void*)armip);
     // load current indice
     LDR_IMM9(s2, xEmu, offsetof(x86emu_t, cstacki));
@@ -1199,6 +1423,10 @@ void cstack_push(dynarec_arm_t* dyn, int ninst, uintptr_t x86ip, uintptr_t armip
     STR_IMM9(s2, xEmu, offsetof(x86emu_t, cstacki));
     // push the pair of address
     MOV32(s2, x86ip);
+    if(x86ip) {
+        RELOC(RELOC_BLOCK, 0, armip-dyn->arm_start, 0);
+        FIXUP(FIXUP_MOV32, dyn->insts[ninst+1].address);
+    }
     MOV32_(s2+1, armip);
     STRD_REG(s2, xEmu, s1);
     MESSAGE(LOG_DUMP, "--------------CStack PUSH\n");
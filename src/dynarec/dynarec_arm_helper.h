@@ -203,32 +203,60 @@
 #define GETMARKSEG ((dyn->insts)?dyn->insts[ninst].markseg:(dyn->arm_size+4))
 #define MARKLOCK if(dyn->insts) {dyn->insts[ninst].marklock = (uintptr_t)dyn->arm_size;}
 #define GETMARKLOCK ((dyn->insts)?dyn->insts[ninst].marklock:(dyn->arm_size+4))
+// in one pass mode, a reference to label L (an arm offset) not emitted yet is recorded, and fixed once the block is emitted
+#if STEP < 3
+#define FIXUP(T, L)
+#else
+#define FIXUP(T, L)     if(dyn->onepass && (L)==LABEL_NONE) add_fixup(dyn, T, &(L))
+#endif
 
 // Branch to MARK if cond (use j32)
 #define B_MARK(cond)    \
     j32 = GETMARK-(dyn->arm_size+8);    \
+    FIXUP(FIXUP_BRANCH, dyn->insts[ninst].mark); \
     Bcond(cond, j32)
 // Branch to MARK2 if cond (use j32)
 #define B_MARK2(cond)    \
     j32 = GETMARK2-(dyn->arm_size+8);   \
+    FIXUP(FIXUP_BRANCH, dyn->insts[ninst].mark2); \
     Bcond(cond, j32)
 // Branch to MARK3 if cond (use j32)
 #define B_MARK3(cond)    \
     j32 = GETMARK3-(dyn->arm_size+8);   \
+    FIXUP(FIXUP_BRANCH, dyn->insts[ninst].mark3); \
     Bcond(cond, j32)
 // Branch to next instruction if cond (use j32)
 #define B_NEXT(cond)     \
     j32 = (dyn->insts)?(dyn->insts[ninst].epilog-(dyn->arm_size+8)):0; \
+    FIXUP(FIXUP_BRANCH, dyn->insts[ninst].epilog); \
     Bcond(cond, j32)
 // Branch to MARKSEG if cond (use j32)
 #define B_MARKSEG(cond)    \
     j32 = GETMARKSEG-(dyn->arm_size+8);   \
+    FIXUP(FIXUP_BRANCH, dyn->insts[ninst].markseg); \
     Bcond(cond, j32)
 // Branch to MARKLOCK if cond (use j32)
 #define B_MARKLOCK(cond)    \
     j32 = GETMARKLOCK-(dyn->arm_size+8);   \
+    FIXUP(FIXUP_BRANCH, dyn->insts[ninst].marklock); \
     Bcond(cond, j32)
 
+// LOCK'd read-modify-write, from MARKLOCK: a LDREX/STREX loop (S is the STREX status),
+// or plain load/store when the block is built while there is only one thread (see nolock)
+#define LOCK_LDREX(A, B)    if(dyn->nolock) {dyn->elided = 1; LDR_IMM9(A, B, 0);} else {LDREX(A, B);}
+#define LOCK_LDREXB(A, B)   if(dyn->nolock) {dyn->elided = 1; LDRB_IMM9(A, B, 0);} else {LDREXB(A, B);}
+#define LOCK_STREX(S, A, B) if(dyn->nolock) {STR_IMM9(A, B, 0);} else {STREX(S, A, B); CMPS_IMM8(S, 0); B_MARKLOCK(cNE);}
+#define LOCK_STREXB(S, A, B) if(dyn->nolock) {STRB_IMM9(A, B, 0);} else {STREXB(S, A, B); CMPS_IMM8(S, 0); B_MARKLOCK(cNE);}
+// after a native call that may have created a thread, in a block with plain LOCK'd operations:
+// leave EQ (to MARK) if the thread is not alone anymore, so the block is not used again
+#define CHECK_NOLOCK(s1)    \
+    if(dyn->nolock && dyn->elided) {    \
+        B_MARK(cEQ);        \
+        LDR_IMM9(s1, xEmu, offsetof(x86emu_t, context));            \
+        LDR_IMM9(s1, s1, offsetof(box86context_t, singlethread));   \
+        CMPS_IMM8(s1, 0);   \
+    }
+
 #define IFX(A)  if(dyn->insts && (dyn->insts[ninst].x86.need_flags&(A)))
 #define IFXX(A) if(dyn->insts && (dyn->insts[ninst].x86.need_flags==(A)))
 #define IFX2X(A, B) if(dyn->insts && (dyn->insts[ninst].x86.need_flags==(A) || dyn->insts[ninst].x86.need_flags==(B) || dyn->insts[ninst].x86.need_flags==((A)|(B))))
@@ -288,6 +316,7 @@
             LDR_IMM9(x3, xEmu, offsetof(x86emu_t, df)); \
             TSTS_REG_LSL_IMM5(x3, x3, 0);               \
             j32 = (GETMARKF)-(dyn->arm_size+8);         \
+            FIXUP(FIXUP_BRANCH, dyn->insts[ninst].markf);\
             Bcond(cEQ, j32);                            \
         }                                               \
         CALL_(UpdateFlags, -1, 0);                      \
@@ -310,6 +339,17 @@
 #ifndef BARRIER_NEXT
 #define BARRIER_NEXT(A)
 #endif
+// conditional jumps of hot blocks keep the fpu cache on the fall-through path (3), instead of a purge before them (2)
+#define BARRIER_JCC     BARRIER((dyn->tier>1)?3:2)
+#ifndef FUSECC
+#define FUSECC(cc)
+#endif
+// CPSR residency: the instruction leaves an equivalent of the x86 flags in the CPSR (only when nothing changes the CPSR after it)
+#define SETCPSR(A)  if(dyn->insts) dyn->insts[ninst].cpsr = A
+// the next instruction reads its condition from the CPSR, so the flags must be set even if they are not needed in x86emu_t
+#define CPSR_USED   (dyn->insts && dyn->insts[ninst+1].fused)
+// the condition of the instruction is read from the CPSR, no need to get the x86 flags
+#define CPSR_FUSED  (dyn->insts && dyn->insts[ninst].fused)
 #define UFLAG_OP1(A) if(dyn->insts && dyn->insts[ninst].x86.need_flags) {STR_IMM9(A, 0, offsetof(x86emu_t, op1));}
 #define UFLAG_OP2(A) if(dyn->insts && dyn->insts[ninst].x86.need_flags) {STR_IMM9(A, 0, offsetof(x86emu_t, op2));}
 #define UFLAG_OP12(A1, A2) if(dyn->insts && dyn->insts[ninst].x86.need_flags) {STR_IMM9(A1, 0, offsetof(x86emu_t, op1));STR_IMM9(A2, 0, offsetof(x86emu_t, op2));}
@@ -328,7 +368,7 @@
 #elif STEP == 2
 #define PASS2IF(A, B) if(A) dyn->insts[ninst].pass2choice = B; if(dyn->insts[ninst].pass2choice == B)
 #else
-#define PASS2IF(A, B) if(dyn->insts[ninst].pass2choice == B)
+#define PASS2IF(A, B) if(dyn->onepass && (A)) dyn->insts[ninst].pass2choice = B; if(dyn->insts[ninst].pass2choice == B)
 #endif
 
 void arm_epilog();
@@ -366,12 +406,17 @@ void* arm_linker(x86emu_t* emu, void** table, uintptr_t addr);
 #define geted16         STEPNAME(geted16_)
 #define jump_to_epilog  STEPNAME(jump_to_epilog_)
 #define jump_to_linker  STEPNAME(jump_to_linker_)
+#define jump_cond_purge STEPNAME(jump_cond_purge_)
+#define hot_counter     STEPNAME(hot_counter_)
+#define ibtc_jump       STEPNAME(ibtc_jump_)
 #define ret_to_epilog   STEPNAME(ret_to_epilog_)
 #define retn_to_epilog  STEPNAME(retn_to_epilog_)
+#define ret_inlined     STEPNAME(ret_inlined_)
 #define iret_to_epilog  STEPNAME(iret_to_epilog_)
 #define call_c          STEPNAME(call_c_)
 #define grab_fsdata     STEPNAME(grab_fsdata_)
 #define grab_tlsdata    STEPNAME(grab_tlsdata_)
+#define rep_movs        STEPNAME(rep_movs_)
 #define emit_cmp8       STEPNAME(emit_cmp8)
 #define emit_cmp16      STEPNAME(emit_cmp16)
 #define emit_cmp32      STEPNAME(emit_cmp32)
@@ -458,6 +503,8 @@ void* arm_linker(x86emu_t* emu, void** table, uintptr_t addr);
 #define fpu_popcache    STEPNAME(fpu_popcache)
 #define fpu_reset       STEPNAME(fpu_reset)
 #define fpu_purgecache  STEPNAME(fpu_purgecache)
+#define fpu_purgecache_jump STEPNAME(fpu_purgecache_jump)
+#define fpu_cached      STEPNAME(fpu_cached)
 #ifdef HAVE_TRACE
 #define fpu_reflectcache STEPNAME(fpu_reflectcache)
 #endif
@@ -483,12 +530,17 @@ uintptr_t geted16(dynarec_arm_t* dyn, uintptr_t addr, int ninst, uint8_t nextop,
 // generic x86 helper
 void jump_to_epilog(dynarec_arm_t* dyn, uintptr_t ip, int reg, int ninst);
 void jump_to_linker(dynarec_arm_t* dyn, uintptr_t ip, int reg, int ninst);
+void jump_cond_purge(dynarec_arm_t* dyn, int ninst, int no, uintptr_t ip);
+void hot_counter(dynarec_arm_t* dyn, uintptr_t ip, int ninst);
+void ibtc_jump(dynarec_arm_t* dyn, int ninst);
 void ret_to_epilog(dynarec_arm_t* dyn, int ninst);
 void retn_to_epilog(dynarec_arm_t* dyn, int ninst, int n);
+void ret_inlined(dynarec_arm_t* dyn, int ninst, int n);
 void iret_to_epilog(dynarec_arm_t* dyn, int ninst);
 void call_c(dynarec_arm_t* dyn, int ninst, void* fnc, int reg, int ret, uint32_t mask);
 void grab_fsdata(dynarec_arm_t* dyn, uintptr_t addr, int ninst, int reg);
 void grab_tlsdata(dynarec_arm_t* dyn, uintptr_t addr, int ninst, int reg);
+void rep_movs(dynarec_arm_t* dyn, int ninst, int s, int stos);
 void emit_lock(dynarec_arm_t* dyn, uintptr_t addr, int ninst);
 void emit_unlock(dynarec_arm_t* dyn, uintptr_t addr, int ninst);
 void emit_cmp8(dynarec_arm_t* dyn, int ninst, int s1, int s2, int s3, int s4);
@@ -598,6 +650,10 @@ int sse_get_reg_empty(dynarec_arm_t* dyn, int ninst, int s1, int a);
 void fpu_reset(dynarec_arm_t* dyn, int ninst);
 // purge the FPU cache (needs 3 scratch registers)
 void fpu_purgecache(dynarec_arm_t* dyn, int ninst, int s1, int s2, int s3);
+// purge the FPU cache for a side exit, the cache state is unchanged after (needs 3 scratch registers)
+void fpu_purgecache_jump(dynarec_arm_t* dyn, int ninst, int s1, int s2, int s3);
+// something in the FPU cache?
+int fpu_cached(dynarec_arm_t* dyn);
 #ifdef HAVE_TRACE
 void fpu_reflectcache(dynarec_arm_t* dyn, int ninst, int s1, int s2, int s3);
 #endif
@@ -629,7 +685,7 @@ uintptr_t dynarecF20F(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int nins
 uintptr_t dynarecF30F(dynarec_arm_t* dyn, uintptr_t addr, uintptr_t ip, int ninst, int* ok, int* need_epilog);
 
 // PUSH a x86/native couple of address in cstack, using s1, s2, s2+1
-void cstack_push(dynarec_arm_t* dyn, int ninst, uintptr_t x86ip, uintptr_t armip, int s1, int s2);
+void cstack_push(dynarec_arm_t* dyn, int ninst, uintptr_t x86ip, int s1, int s2);
 // POP a x86/native couple of address from cstack, and generate the jump is x86 address is s0, use s1, s2 and s2+1 as scratch
 void cstack_pop(dynarec_arm_t* dyn, int ninst, int s0, int s1, int s2);
 
@@ -645,6 +701,13 @@ void cstack_pop(dynarec_arm_t* dyn, int ninst, int s0, int s1, int s2);
 #define PASS3(A)   A
 #endif
 
+// record a relocation for the MOVW/MOVT pair about to be emitted (only used by the persistent cache)
+#if STEP < 3
+#define RELOC(T, R, A, E)
+#else
+#define RELOC(T, R, A, E)   if(box86_dynarec_diskcache) add_reloc(dyn, T, R, A, E)
+#endif
+
 #if STEP < 3
 #define MAYUSE(A)   (void)A
 #else
@@ -32,6 +32,8 @@ void arm_pass(dynarec_arm_t* dyn, uintptr_t addr)
     int need_epilog = 1;
     dyn->tablei = 0;
     dyn->sons_size = 0;
+    dyn->inline_ret = 0;
+    dyn->inline_id = 0;
     // Clean up (because there are multiple passes)
     dyn->state_flags = 0;
     fpu_reset(dyn, ninst);
@@ -44,7 +46,13 @@ void arm_pass(dynarec_arm_t* dyn, uintptr_t addr)
             NEW_BARRIER_INST;
         }
         NEW_INST;
+        if(dyn->insts) {
+            dyn->insts[ninst].inlined = dyn->inline_ret?dyn->inline_id:0;
+            dyn->insts[ninst].cpsr = 0;
+        }
         fpu_reset_scratch(dyn);
+        if(!ninst && dyn->hot)
+            hot_counter(dyn, ip, ninst);
 #ifdef HAVE_TRACE
         if(my_context->dec && box86_dynarec_trace) {
         if((trace_end == 0) 
@@ -65,9 +73,9 @@ void arm_pass(dynarec_arm_t* dyn, uintptr_t addr)
 
         INST_EPILOG;
 
-        if(dyn->insts && dyn->insts[ninst+1].x86.barrier) {
+        if(dyn->insts && dyn->insts[ninst+1].x86.barrier && dyn->insts[ninst+1].x86.barrier!=3) {
             fpu_purgecache(dyn, ninst, x1, x2, x3);
-            if(dyn->insts[ninst+1].x86.barrier!=2)
+            if(dyn->insts[ninst+1].x86.barrier==1)
                 dyn->state_flags = 0;
         }
         if(!ok && !need_epilog && dyn->insts && (addr < (dyn->start+dyn->isize))) {
@@ -78,10 +86,18 @@ void arm_pass(dynarec_arm_t* dyn, uintptr_t addr)
             if(next && ((next-addr)<15) && is_nops(dyn, addr, next-addr)) {
                 dynarec_log(LOG_DEBUG, "Extend block %p, %p -> %p (ninst=%d)\n", dyn, (void*)addr, (void*)next, ninst);
                 ok = 1;
+                ++dyn->extended;
+            } else if(dyn->tier>1 && next && ((next-addr)<TIER2_EXTEND) && is_nops(dyn, addr, next-addr)) {
+                // higher tier blocks also go over long alignment padding
+                dynarec_log(LOG_DEBUG, "Extend hot block %p, %p -> %p (ninst=%d)\n", dyn, (void*)addr, (void*)next, ninst);
+                ok = 1;
+                ++dyn->extended;
             } else if(next && (next-addr)<15) {
                 dynarec_log(LOG_DEBUG, "Cannot extend block %p -> %p (%02X %02X %02X %02X %02X)\n", (void*)addr, (void*)next, PK(0), PK(1), PK(2), PK(3), PK(4));
             }
         }
+        if(dyn->noinline && (addr-dyn->start)>dyn->inline_max)
+            ok = 0; // the function scanned for inlining is already too big
         if(ok<0)  {ok = 0; need_epilog=1;}
         ++ninst;
     }
@@ -1,6 +1,6 @@
 
 #define INIT    uintptr_t sav_addr=addr
-#define FINI    dyn->isize = addr-sav_addr
+#define FINI    dyn->isize = addr-sav_addr; dyn->lastip = ip
 #define MESSAGE(A, ...)  
 #define SETFLAGS(A, B)  
 #define READFLAGS(A)    
@@ -1,7 +1,7 @@
 #define INIT    
 #define FINI     \
     dyn->insts[ninst].x86.addr = addr; \
-    if(ninst) dyn->insts[ninst-1].x86.size = dyn->insts[ninst].x86.addr - dyn->insts[ninst-1].x86.addr;
+    if(ninst && !dyn->insts[ninst-1].x86.size) dyn->insts[ninst-1].x86.size = dyn->insts[ninst].x86.addr - dyn->insts[ninst-1].x86.addr;
 #define MESSAGE(A, ...)  
 #define EMIT(A)     
 #define READFLAGS(A)    dyn->insts[ninst].x86.use_flags = A
@@ -9,9 +9,10 @@
 #define JUMP(A)         dyn->insts[ninst].x86.jmp = A
 #define BARRIER(A)      dyn->insts[ninst].x86.barrier = A
 #define BARRIER_NEXT(A) if(ninst<dyn->size) dyn->insts[ninst+1].x86.barrier = A
+#define FUSECC(cc)      dyn->insts[ninst].fused = (ninst && dyn->insts[ninst-1].x86.state_flags==SF_SET && cpsr_cond(dyn->insts[ninst-1].cpsr, cc)!=-1)
 
 #define NEW_INST \
     dyn->insts[ninst].x86.addr = ip; \
-    if(ninst) dyn->insts[ninst-1].x86.size = dyn->insts[ninst].x86.addr - dyn->insts[ninst-1].x86.addr;
+    if(ninst && !dyn->insts[ninst-1].x86.size) dyn->insts[ninst-1].x86.size = dyn->insts[ninst].x86.addr - dyn->insts[ninst-1].x86.addr;
 #define INST_EPILOG 
 #define INST_NAME(name)  
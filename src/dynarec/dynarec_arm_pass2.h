@@ -6,4 +6,4 @@
 #define NEW_INST    if(ninst) {dyn->insts[ninst].address = (dyn->insts[ninst-1].address+dyn->insts[ninst-1].size);}
 #define INST_EPILOG dyn->insts[ninst].epilog = dyn->arm_size; 
 #define INST_NAME(name) 
-#define NEW_BARRIER_INST    if(ninst) ++dyn->sons_size
\ No newline at end of file
+#define NEW_BARRIER_INST    if(ninst && !dyn->insts[ninst].inlined) ++dyn->sons_size
\ No newline at end of file
@@ -1,14 +1,15 @@
 #define INIT    
-#define FINI
+#define FINI    if(dyn->onepass) dyn->insts[ninst].address = dyn->arm_size-dyn->insts[ninst].size2
 #define EMIT(A)     \
+    if(dyn->onepass && dyn->arm_size+4>dyn->scratch_cap) grow_scratch(dyn); \
     if(box86_dynarec_dump) {dynarec_log(LOG_NONE, "\t%08x\t%s\n", (A), arm_print(A));} \
     *(uint32_t*)(dyn->block) = A;       \
     dyn->block += 4; dyn->arm_size += 4;\
     dyn->insts[ninst].size2 += 4
 
 #define MESSAGE(A, ...)  if(box86_dynarec_dump) dynarec_log(LOG_NONE, __VA_ARGS__)
-#define NEW_INST        
-#define INST_EPILOG     
+#define NEW_INST        if(dyn->onepass) dyn->insts[ninst].address = dyn->arm_size
+#define INST_EPILOG     if(dyn->onepass) dyn->insts[ninst].epilog = dyn->arm_size
 #define INST_NAME(name) \
     if(box86_dynarec_dump) {\
         printf_x86_instruction(my_context->dec, &dyn->insts[ninst].x86, name); \
@@ -25,7 +26,7 @@
     }
 
 #define NEW_BARRIER_INST                            \
-    if(ninst) {                                     \
+    if(ninst && !dyn->insts[ninst].inlined) {       \
     dyn->sons_x86[dyn->sons_size] = (uintptr_t)ip;  \
     dyn->sons_arm[dyn->sons_size] = dyn->block;     \
     MESSAGE(LOG_DUMP, "----> potential Son here\n");\
@@ -2,9 +2,21 @@
 #define __DYNAREC_ARM_PRIVATE_H_
 
 #include "dynarec_private.h"
+#include "dynacache.h"
 
 typedef struct x86emu_s x86emu_t;
 
+// a forward reference in the arm code, fixed once the block is emitted (one pass mode)
+typedef struct dynafixup_s {
+    int                 offset;     // offset in the block of the opcode(s) to fix
+    int                 type;       // FIXUP_xxx
+    uintptr_t*          label;      // the arm offset the opcode refers to (address, epilog or mark of an instruction)
+} dynafixup_t;
+
+#define FIXUP_BRANCH    0   // B / Bcond, to the label
+#define FIXUP_MOV32     1   // MOVW/MOVT pair, absolute address of the label
+#define LABEL_NONE      ((uintptr_t)-1) // label not emitted yet
+
 typedef struct instruction_arm_s {
     instruction_x86_t   x86;
     uintptr_t           address;    // (start) address of the arm emited instruction
@@ -18,6 +30,9 @@ typedef struct instruction_arm_s {
     int                 pass2choice;// value for choices that are fixed on pass2 for pass3
     uintptr_t           natcall;
     int                 retn;
+    int                 inlined;    // id of the inlined function the instruction comes from (0 for the block itself)
+    int                 cpsr;       // x86 flags left in the CPSR by the instruction (CPSR_xxx), 0 if none
+    int                 fused;      // the instruction reads its condition from the CPSR left by the previous one
 } instruction_arm_t;
 
 typedef struct dynarec_arm_s {
@@ -32,6 +47,7 @@ typedef struct dynarec_arm_s {
     uintptr_t*          table;      // jump table
     int                 tablesz;    // size of the jump table
     int                 tablei;     // index
+    uintptr_t*          patch;      // slot of each jump table entry that can become a direct branch (pass3)
     int                 state_flags;// actual state for on-demand flags
     int                 x87cache[8];// cache status for the 8 x87 register behind the fpu stack
     int                 x87reg[8];  // reg used for x87cache entry
@@ -43,16 +59,49 @@ typedef struct dynarec_arm_s {
     int                 fpu_extra_qscratch; // some opcode need an extra quad scratch register
     int                 fpu_reg;    // x87/sse/mmx reg counter
     int                 nolinker;   // disable use of (smart) linker in the block
+    int                 tier;       // 1 for regular block, 2 for hot block recompilation
+    int                 hot;        // emit the hit counter in the block entry
+    int                 nolock;     // only one thread, LOCK'd operations are plain ones
+    int                 elided;     // some code relies on nolock (so the block will have to go when a thread is created)
+    int                 succflags;  // the flags liveness used the summary of another block (so the block can't go to the disk cache)
+    int                 noinline;   // don't inline any call (scan of a function to inline)
+    int                 inline_max; // maximum size of a function to inline (0 for no inlining)
+    uintptr_t           inline_ret; // return address of the function being inlined (0 if none)
+    int                 inline_id;  // number of functions inlined so far
+    int                 calls;      // number of CALL met (pass0, to find leaf functions)
+    uintptr_t           lastip;     // address of the last x86 instruction (pass0)
+    int                 extended;   // number of times the block went on after an end, over a padding (pass0)
     uintptr_t*          next;       // variable array of "next" jump address
     int                 next_sz;
     int                 next_cap;
     uintptr_t*          sons_x86;   // the x86 address of potential dynablock sons
     void**              sons_arm;   // the arm address of potential dynablock sons
     int                 sons_size;  // number of potential dynablock sons
+    dynareloc_t*        relocs;     // relocations of absolute values, for the persistent cache
+    int                 relocs_size;
+    int                 relocs_cap;
+    int                 onepass;    // pass3 emits in a growable scratch buffer, without pass2 (BOX86_DYNAREC_ONEPASS)
+    int                 scratch_cap;// size of the scratch buffer (one pass)
+    dynafixup_t*        fixups;     // forward references to fix (one pass)
+    int                 fixups_size;
+    int                 fixups_cap;
 } dynarec_arm_t;
 
+// what the CPSR holds after an instruction (see SETCPSR)
+#define CPSR_SUB        1       // NZCV of a 32bits SUB/CMP (C is the inverted x86 CF)
+#define CPSR_LOGIC      2       // NZ of a 32bits TEST/AND (x86 CF and OF are 0)
+
+#define TIER2_EXTEND    256     // maximum size of nop padding a hot block can go over
+#define TIER2_INLINE    64      // minimum size of the leaf functions a hot block inlines
+#define REP_BULK_MIN    64      // minimum size in bytes for REP MOVS/STOS/SCAS to use the bulk path
+#define REP_BULK_NATIVE 4096    // minimum size in bytes for REP MOVS/STOS/SCAS to call a native function
+
 void add_next(dynarec_arm_t *dyn, uintptr_t addr);
 uintptr_t get_closest_next(dynarec_arm_t *dyn, uintptr_t addr);
 int is_nops(dynarec_arm_t *dyn, uintptr_t addr, int n);
+int is_inlinable(dynarec_arm_t *dyn, uintptr_t addr, uintptr_t callee);
+void add_reloc(dynarec_arm_t *dyn, int type, uintptr_t ref, int addend, int extra);
+void add_fixup(dynarec_arm_t *dyn, int type, uintptr_t* label);
+void grow_scratch(dynarec_arm_t *dyn);
 
 #endif //__DYNAREC_ARM_PRIVATE_H_
\ No newline at end of file
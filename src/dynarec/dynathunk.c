@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#include "debug.h"
+#include "box86context.h"
+#include "emu/x86emu_private.h"
+#include "regs.h"
+#include "wrapper.h"
+#include "dynathunk.h"
+
+#include "khash.h"
+
+// Thunks are small native functions, with the wrapper_t prototype, built for one (signature, function) pair.
+// They read the args from the x86 stack and call the function directly, without the generic wrapper.
+// Only simple signatures are handled: 32bits integer or pointer args, and integer or no result.
+
+#define EMIT(A)     *(thunk++) = (uint32_t)(A)
+#include "arm_emitter.h"
+
+#define THUNK_CHUNK     4096    // thunks are allocated by chunks of dynarec memory
+#define THUNK_MAXSIZE   32      // in opcodes
+#define THUNK_MAXARGS   12
+
+typedef struct thunkinfo_s {
+    wrapper_t   w;
+    void*       fnc;
+} thunkinfo_t;
+
+KHASH_MAP_INIT_INT(thunks, thunkinfo_t)    // thunk -> wrapper and function
+KHASH_MAP_INIT_INT(fncthunks, uintptr_t)   // function -> thunk
+
+static pthread_mutex_t mutex_thunks = PTHREAD_MUTEX_INITIALIZER;
+static kh_thunks_t*    thunks = NULL;
+static kh_fncthunks_t* fncthunks = NULL;
+static uintptr_t       chunk = 0;
+static int             chunk_used = 0;
+
+static int thunkArgs(const char* sig)
+{
+    if(!sig || !strchr("vipuLlIU", sig[0]) || sig[1]!='F')
+        return -1;
+    if(!strcmp(sig+2, "v"))
+        return 0;
+    int n = 0;
+    for(const char* p=sig+2; *p; ++p, ++n)
+        if(!strchr("ipuLl", *p))
+            return -1;
+    return (n>THUNK_MAXARGS)?-1:n;
+}
+
+// emit the thunk, return the number of opcodes
+static int emitThunk(uint32_t* thunk, const char* sig, int nargs, void* fnc)
+{
+    uint32_t* start = thunk;
+    int stk = 0;
+    PUSH(xSP, (1<<4)|(1<<14));
+    MOV_REG(4, xEmu);
+    LDR_IMM9(x12, 4, offsetof(x86emu_t, regs[_SP]));
+    if(nargs>4) {
+        stk = ((nargs-4)*4+7)&~7;   // keep the stack 8 bytes aligned
+        SUB_IMM8(xSP, xSP, stk);
+        for(int i=4; i<nargs; ++i) {
+            LDR_IMM9(x3, x12, 4+i*4);
+            STR_IMM9(x3, xSP, (i-4)*4);
+        }
+    }
+    // with no args, r0 is still emu, some functions (like x86Syscall) rely on it
+    for(int i=((nargs>4)?4:nargs)-1; i>=0; --i) {
+        LDR_IMM9(i, x12, 4+i*4);
+    }
+    MOV32(x12, (uintptr_t)fnc);
+    BLX(x12);
+    if(stk) {
+        ADD_IMM8(xSP, xSP, stk);
+    }
+    if(sig[0]!='v') {
+        STR_IMM9(0, 4, offsetof(x86emu_t, regs[_AX]));
+    }
+    if(sig[0]=='I' || sig[0]=='U') {
+        STR_IMM9(1, 4, offsetof(x86emu_t, regs[_DX]));
+    }
+    POP(xSP, (1<<4)|(1<<15));
+    return thunk-start;
+}
+
+static wrapper_t buildThunk(wrapper_t w, const char* sig, int nargs, void* fnc)
+{
+    if(!chunk || chunk_used+THUNK_MAXSIZE*4>THUNK_CHUNK) {
+        chunk = AllocDynarecMap(THUNK_CHUNK, 0);
+        if(!chunk)
+            return NULL;
+        setDynarecMapOwner(chunk, THUNK_CHUNK, NULL);
+        chunk_used = 0;
+    }
+    uint32_t* thunk = (uint32_t*)(chunk+chunk_used);
+    int sz = emitThunk(thunk, sig, nargs, fnc);
+    __clear_cache(thunk, thunk+sz);
+    chunk_used += (sz*4+15)&~15;
+    int ret;
+    khint_t k = kh_put(thunks, thunks, (uintptr_t)thunk, &ret);
+    kh_value(thunks, k).w = w;
+    kh_value(thunks, k).fnc = fnc;
+    k = kh_put(fncthunks, fncthunks, (uintptr_t)fnc, &ret);
+    kh_value(fncthunks, k) = (uintptr_t)thunk;
+    return (wrapper_t)thunk;
+}
+
+wrapper_t DynaThunk(wrapper_t w, void* fnc)
+{
+    if(!box86_dynarec_thunks || !w || !fnc)
+        return w;
+    int nargs = thunkArgs(GetWrapperSignature(w));
+    if(nargs<0)
+        return w;
+    pthread_mutex_lock(&mutex_thunks);
+    if(!thunks) {
+        thunks = kh_init(thunks);
+        fncthunks = kh_init(fncthunks);
+    }
+    wrapper_t ret = NULL;
+    // the same function can be bridged more than once, reuse the thunk if the wrapper is the same
+    khint_t k = kh_get(fncthunks, fncthunks, (uintptr_t)fnc);
+    if(k!=kh_end(fncthunks)) {
+        khint_t kt = kh_get(thunks, thunks, kh_value(fncthunks, k));
+        if(kt!=kh_end(thunks) && kh_value(thunks, kt).w==w)
+            ret = (wrapper_t)kh_value(fncthunks, k);
+    }
+    if(!ret)
+        ret = buildThunk(w, GetWrapperSignature(w), nargs, fnc);
+    pthread_mutex_unlock(&mutex_thunks);
+    return ret?ret:w;
+}
+
+wrapper_t DynaThunkWrapper(wrapper_t w)
+{
+    if(!thunks)
+        return w;
+    pthread_mutex_lock(&mutex_thunks);
+    khint_t k = kh_get(thunks, thunks, (uintptr_t)w);
+    if(k!=kh_end(thunks))
+        w = kh_value(thunks, k).w;
+    pthread_mutex_unlock(&mutex_thunks);
+    return w;
+}
+
+void FiniDynaThunk()
+{
+    // the thunks memory itself goes with the dynarec map
+    pthread_mutex_lock(&mutex_thunks);
+    if(thunks) {
+        kh_destroy(thunks, thunks);
+        kh_destroy(fncthunks, fncthunks);
+        thunks = NULL;
+        fncthunks = NULL;
+    }
+    chunk = 0;
+    chunk_used = 0;
+    pthread_mutex_unlock(&mutex_thunks);
+}
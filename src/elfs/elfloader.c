@@ -29,6 +29,7 @@
 #include "box86stack.h"
 #ifdef DYNAREC
 #include "dynablock.h"
+#include "dynacache.h"
 #endif
 #include "../emu/x86emu_private.h"
 #include "x86tls.h"
@@ -68,6 +69,7 @@ void FreeElfHeader(elfheader_t** head)
         dynarec_log(LOG_INFO, "Free Dynarec block for %s\n", h->path);
         cleanDBFromAddressRange(my_context, h->text, h->textsz, 1);
     }
+    FreeDynaCache(h);
 #endif
     free(h->name);
     free(h->path);
@@ -1004,7 +1006,7 @@ dynablocklist_t* GetDynablocksFromAddress(box86context_t *context, uintptr_t add
     }*/
     if(box86_dynarec_forced) {
         addDBFromAddressRange(my_context, addr, 1, 1);
-        return my_context->dynmap[addr>>DYNAMAP_SHIFT]->dynablocks;
+        return getDynmap(my_context, addr>>DYNAMAP_SHIFT)->dynablocks;
     }
     //check if address is in an elf... if yes, grant a block (should I warn)
     Dl_info info;
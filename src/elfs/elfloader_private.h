@@ -3,6 +3,7 @@
 
 #ifdef DYNAREC
 typedef struct dynablocklist_s dynablocklist_t;
+typedef struct dynacache_s dynacache_t;
 #endif
 
 typedef struct library_s library_t;
@@ -82,6 +83,9 @@ struct elfheader_s {
 
     library_t   *lib;
     needed_libs_t *neededlibs;
+#ifdef DYNAREC
+    dynacache_t *dynacache; // persistent cache of translated blocks
+#endif
 };
 
 #define R_386_NONE	0
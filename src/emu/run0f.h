@@ -57,17 +57,12 @@
         _0f_0x14:                      /* UNPCKLPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            GX.ud[3] = EX->ud[1];
-            GX.ud[2] = GX.ud[1];
-            GX.ud[1] = EX->ud[0];
+            VX(GX, ud) = __builtin_shuffle(VX(GX, ud), VX(*EX, ud), (vx_ud){0, 4, 1, 5});
             NEXT;
         _0f_0x15:                      /* UNPCKHPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            GX.ud[0] = GX.ud[2];
-            GX.ud[1] = EX->ud[2];
-            GX.ud[2] = GX.ud[3];
-            GX.ud[3] = EX->ud[3];
+            VX(GX, ud) = __builtin_shuffle(VX(GX, ud), VX(*EX, ud), (vx_ud){2, 6, 3, 7});
             NEXT;
         _0f_0x16:                      /* MOVHPS Gx,Ex */
             nextop = F8;               /* MOVLHPS Gx,Ex (Ex==reg) */
@@ -248,97 +243,96 @@
         #define GOCOND(BASE, PREFIX, CONDITIONAL) \
         _0f_##BASE##_0:                          \
             PREFIX                              \
-            if(ACCESS_FLAG(F_OF))               \
+            if(LAZY_FLAG(F_OF))               \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_1:                          \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_OF))              \
+            if(!LAZY_FLAG(F_OF))              \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_2:                          \
             PREFIX                              \
-            if(ACCESS_FLAG(F_CF))               \
+            if(LAZY_FLAG(F_CF))               \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_3:                          \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_CF))              \
+            if(!LAZY_FLAG(F_CF))              \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_4:                          \
             PREFIX                              \
-            if(ACCESS_FLAG(F_ZF))               \
+            if(LAZY_FLAG(F_ZF))               \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_5:                          \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_ZF))              \
+            if(!LAZY_FLAG(F_ZF))              \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_6:                          \
             PREFIX                              \
-            if((ACCESS_FLAG(F_ZF) || ACCESS_FLAG(F_CF)))  \
+            if((LAZY_FLAG(F_ZF) || LAZY_FLAG(F_CF)))  \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_7:                          \
             PREFIX                              \
-            if(!(ACCESS_FLAG(F_ZF) || ACCESS_FLAG(F_CF))) \
+            if(!(LAZY_FLAG(F_ZF) || LAZY_FLAG(F_CF))) \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_8:                          \
             PREFIX                              \
-            if(ACCESS_FLAG(F_SF))               \
+            if(LAZY_FLAG(F_SF))               \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_9:                          \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_SF))              \
+            if(!LAZY_FLAG(F_SF))              \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_A:                          \
             PREFIX                              \
-            if(ACCESS_FLAG(F_PF))               \
+            if(LAZY_FLAG(F_PF))               \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_B:                          \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_PF))              \
+            if(!LAZY_FLAG(F_PF))              \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_C:                          \
             PREFIX                              \
-            if(ACCESS_FLAG(F_SF) != ACCESS_FLAG(F_OF))  \
+            if(LAZY_FLAG(F_SF) != LAZY_FLAG(F_OF))  \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_D:                          \
             PREFIX                              \
-            if(ACCESS_FLAG(F_SF) == ACCESS_FLAG(F_OF)) \
+            if(LAZY_FLAG(F_SF) == LAZY_FLAG(F_OF)) \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_E:                          \
             PREFIX                              \
-            if(ACCESS_FLAG(F_ZF) || (ACCESS_FLAG(F_SF) != ACCESS_FLAG(F_OF))) \
+            if(LAZY_FLAG(F_ZF) || (LAZY_FLAG(F_SF) != LAZY_FLAG(F_OF))) \
                 CONDITIONAL                     \
             NEXT;                              \
         _0f_##BASE##_F:                          \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_ZF) && (ACCESS_FLAG(F_SF) == ACCESS_FLAG(F_OF))) \
+            if(!LAZY_FLAG(F_ZF) && (LAZY_FLAG(F_SF) == LAZY_FLAG(F_OF))) \
                 CONDITIONAL                     \
             NEXT;
 
         GOCOND(0x40
             , nextop = F8;
             GET_ED;
-            CHECK_FLAGS(emu);
             , GD.dword[0] = ED->dword[0];
         )                               /* 0x40 -> 0x4F CMOVxx Gd,Ed */ // conditional move, no sign
         GOCOND(0x80
-            , tmp32s = F32S; CHECK_FLAGS(emu);
+            , tmp32s = F32S;
             , ip += tmp32s;
         )                               /* 0x80 -> 0x8F Jxx */
         GOCOND(0x90
-            , nextop = F8; CHECK_FLAGS(emu);
+            , nextop = F8;
             GET_EB;
             , EB->byte[0]=1; else EB->byte[0]=0;
         )                               /* 0x90 -> 0x9F SETxx Eb */
@@ -373,38 +367,32 @@
         _0f_0x54:                      /* ANDPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            for(int i=0; i<4; ++i)
-                GX.ud[i] &= EX->ud[i];
+            VX(GX, ud) &= VX(*EX, ud);
             NEXT;
         _0f_0x55:                      /* ANDNPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            for(int i=0; i<4; ++i)
-                GX.ud[i] = (~GX.ud[i]) & EX->ud[i];
+            VX(GX, ud) = ~VX(GX, ud) & VX(*EX, ud);
             NEXT;
         _0f_0x56:                      /* ORPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            for(int i=0; i<4; ++i)
-                GX.ud[i] |= EX->ud[i];
+            VX(GX, ud) |= VX(*EX, ud);
             NEXT;
         _0f_0x57:                      /* XORPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            for(int i=0; i<4; ++i)
-                GX.ud[i] ^= EX->ud[i];
+            VX(GX, ud) ^= VX(*EX, ud);
             NEXT;
         _0f_0x58:                      /* ADDPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            for(int i=0; i<4; ++i)
-                GX.f[i] += EX->f[i];
+            VX(GX, f) += VX(*EX, f);
             NEXT;
         _0f_0x59:                      /* MULPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            for(int i=0; i<4; ++i)
-                GX.f[i] *= EX->f[i];
+            VX(GX, f) *= VX(*EX, f);
             NEXT;
         _0f_0x5A:                      /* CVTPS2PD Gx, Ex */
             nextop = F8;
@@ -423,128 +411,82 @@
         _0f_0x5C:                      /* SUBPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            for(int i=0; i<4; ++i)
-                GX.f[i] -= EX->f[i];
+            VX(GX, f) -= VX(*EX, f);
             NEXT;
         _0f_0x5D:                      /* MINPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            for(int i=0; i<4; ++i) {
-                if (isnan(GX.f[i]) || isnan(EX->f[i]) || isless(EX->f[i], GX.f[i]))
-                    GX.f[i] = EX->f[i];
-            }
+            VX(GX, f) = vx_f_min(VX(GX, f), VX(*EX, f));
             NEXT;
         _0f_0x5E:                      /* DIVPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            for(int i=0; i<4; ++i)
-                GX.f[i] /= EX->f[i];
+            VX(GX, f) /= VX(*EX, f);
             NEXT;
         _0f_0x5F:                      /* MAXPS Gx, Ex */
             nextop = F8;
             GET_EX;
-            for(int i=0; i<4; ++i) {
-                if (isnan(GX.f[i]) || isnan(EX->f[i]) || isgreater(EX->f[i], GX.f[i]))
-                    GX.f[i] = EX->f[i];
-            }
+            VX(GX, f) = vx_f_max(VX(GX, f), VX(*EX, f));
             NEXT;
         _0f_0x60:                      /* PUNPCKLBW Gm, Em */
             nextop = F8;
             GET_EM;
-            GM.ub[7] = EM->ub[3];
-            GM.ub[6] = GM.ub[3];
-            GM.ub[5] = EM->ub[2];
-            GM.ub[4] = GM.ub[2];
-            GM.ub[3] = EM->ub[1];
-            GM.ub[2] = GM.ub[1];
-            GM.ub[1] = EM->ub[0];
+            VM(GM, ub) = __builtin_shuffle(VM(GM, ub), VM(*EM, ub), (vm_ub){0, 8, 1, 9, 2, 10, 3, 11});
             NEXT;
         _0f_0x61:                      /* PUNPCKLWD Gm, Em */
             nextop = F8;
             GET_EM;
-            GM.uw[3] = EM->uw[1];
-            GM.uw[2] = GM.uw[1];
-            GM.uw[1] = EM->uw[0];
+            VM(GM, uw) = __builtin_shuffle(VM(GM, uw), VM(*EM, uw), (vm_uw){0, 4, 1, 5});
             NEXT;
         _0f_0x62:                      /* PUNPCKLDQ Gm, Em */
             nextop = F8;
             GET_EM;
-            GM.ud[1] = EM->ud[0];
+            VM(GM, ud) = __builtin_shuffle(VM(GM, ud), VM(*EM, ud), (vm_ud){0, 2});
             NEXT;
         _0f_0x63:                      /* PACKSSWB Gm, Em */
             nextop = F8;
             GET_EM;
-            GM.sb[0] = (GM.sw[0] > 127) ? 127 : ((GM.sw[0] < -128) ? -128 : GM.sw[0]);
-            GM.sb[1] = (GM.sw[1] > 127) ? 127 : ((GM.sw[1] < -128) ? -128 : GM.sw[1]);
-            GM.sb[2] = (GM.sw[2] > 127) ? 127 : ((GM.sw[2] < -128) ? -128 : GM.sw[2]);
-            GM.sb[3] = (GM.sw[3] > 127) ? 127 : ((GM.sw[3] < -128) ? -128 : GM.sw[3]);
-            GM.sb[4] = (EM->sw[0] > 127) ? 127 : ((EM->sw[0] < -128) ? -128 : EM->sw[0]);
-            GM.sb[5] = (EM->sw[1] > 127) ? 127 : ((EM->sw[1] < -128) ? -128 : EM->sw[1]);
-            GM.sb[6] = (EM->sw[2] > 127) ? 127 : ((EM->sw[2] < -128) ? -128 : EM->sw[2]);
-            GM.sb[7] = (EM->sw[3] > 127) ? 127 : ((EM->sw[3] < -128) ? -128 : EM->sw[3]);
+            VM(GM, ub) = __builtin_shuffle((vm_ub)vm_sw_clamp(VM(GM, sw), -128, 127), (vm_ub)vm_sw_clamp(VM(*EM, sw), -128, 127), (vm_ub){0, 2, 4, 6, 8, 10, 12, 14});
             NEXT;
         _0f_0x64:                       /* PCMPGTB Gm,Em */
             nextop = F8;
             GET_EM;
-            for (int i = 0; i < 8; i++) {
-                GM.ub[i] = (GM.sb[i] > EM->sb[i]) ? 0xFF : 0;
-            }
+            VM(GM, ub) = (vm_ub)(VM(GM, sb) > VM(*EM, sb));
             NEXT;
         _0f_0x65:                       /* PCMPGTW Gm,Em */
             nextop = F8;
             GET_EM;
-            for (int i = 0; i < 4; i++) {
-                GM.uw[i] = (GM.sw[i] > EM->sw[i]) ? 0xFFFF : 0;
-            }
+            VM(GM, uw) = (vm_uw)(VM(GM, sw) > VM(*EM, sw));
             NEXT;
         _0f_0x66:                       /* PCMPGTD Gm,Em */
             nextop = F8;
             GET_EM;
-            for (int i = 0; i < 2; i++) {
-                GM.ud[i] = (GM.sd[i] > EM->sd[i]) ? 0xFFFFFFFF : 0;
-            }
+            VM(GM, ud) = (vm_ud)(VM(GM, sd) > VM(*EM, sd));
             NEXT;
         _0f_0x67:                       /* PACKUSWB Gm, Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<4; ++i)
-                GM.ub[i] = (GM.sw[i]<0)?0:((GM.sw[i]>0xff)?0xff:GM.sw[i]);
-            for(int i=0; i<4; ++i)
-                GM.ub[4+i] = (EM->sw[i]<0)?0:((EM->sw[i]>0xff)?0xff:EM->sw[i]);
+            VM(GM, ub) = __builtin_shuffle((vm_ub)vm_sw_clamp(VM(GM, sw), 0, 255), (vm_ub)vm_sw_clamp(VM(*EM, sw), 0, 255), (vm_ub){0, 2, 4, 6, 8, 10, 12, 14});
             NEXT;
         _0f_0x68:                       /* PUNPCKHBW Gm,Em */
             nextop = F8;
             GET_EM;
-            if(EM==&GM) {eam1 = GM; EM = &eam1;}   // copy is needed
-            for(int i=0; i<4; ++i)
-                GM.ub[2 * i] = GM.ub[i + 4];
-            for(int i=0; i<4; ++i)
-                GM.ub[2 * i + 1] = EM->ub[i + 4];
+            VM(GM, ub) = __builtin_shuffle(VM(GM, ub), VM(*EM, ub), (vm_ub){4, 12, 5, 13, 6, 14, 7, 15});
             NEXT;
         _0f_0x69:                       /* PUNPCKHWD Gm,Em */
             nextop = F8;
             GET_EM;
-            if(EM==&GM) {eam1 = GM; EM = &eam1;}   // copy is needed
-            for(int i=0; i<2; ++i)
-                GM.uw[2 * i] = GM.uw[i + 2];
-            for(int i=0; i<2; ++i)
-                GM.uw[2 * i + 1] = EM->uw[i + 2];
+            VM(GM, uw) = __builtin_shuffle(VM(GM, uw), VM(*EM, uw), (vm_uw){2, 6, 3, 7});
             NEXT;
         _0f_0x6A:                       /* PUNPCKHDQ Gm,Em */
             nextop = F8;
             GET_EM;
-            if(EM==&GM) {eam1 = GM; EM = &eam1;}   // copy is needed
-            GM.ud[0] = GM.ud[1];
-            GM.ud[1] = EM->ud[1];
+            VM(GM, ud) = __builtin_shuffle(VM(GM, ud), VM(*EM, ud), (vm_ud){1, 3});
             NEXT;
         _0f_0x6B:                       /* PACKSSDW Gm,Em */
             nextop = F8;
             GET_EM;
-            if(EM==&GM) {eam1 = GM; EM = &eam1;}   // copy is needed
-            for(int i=0; i<2; ++i)
-                GM.sw[i] = (GM.sd[i]<-32768)?-32768:((GM.sd[i]>32767)?32767:GM.sd[i]);
-            for(int i=0; i<2; ++i)
-                GM.sw[2+i] = (EM->sd[i]<-32768)?-32768:((EM->sd[i]>32767)?32767:EM->sd[i]);
+            VM(GM, uw) = __builtin_shuffle((vm_uw)vm_sd_clamp(VM(GM, sd), -32768, 32767), (vm_uw)vm_sd_clamp(VM(*EM, sd), -32768, 32767), (vm_uw){0, 2, 4, 6});
             NEXT;
 
         _0f_0x6E:                      /* MOVD Gm, Ed */
@@ -561,9 +503,7 @@
             nextop = F8;
             GET_EM;
             tmp8u = F8;
-            if(EM==&GM) {eam1 = GM; EM = &eam1;}   // copy is needed
-            for(int i=0; i<4; ++i)
-                GM.uw[i] = EM->uw[(tmp8u>>(i*2))&3];
+            VM(GM, uw) = __builtin_shuffle(VM(*EM, uw), (vm_uw){tmp8u&3, (tmp8u>>2)&3, (tmp8u>>4)&3, tmp8u>>6});
             NEXT;
         _0f_0x71:  /* GRP */
             nextop = F8;
@@ -574,18 +514,18 @@
                     if(tmp8u>15)
                         {EM->q = 0;}
                     else
-                        for (int i=0; i<4; ++i) EM->uw[i] >>= tmp8u;
+                        VM(*EM, uw) >>= tmp8u;
                     break;
                 case 4:                 /* PSRAW Em, Ib */
                     tmp8u = F8;
-                    for (int i=0; i<4; ++i) EM->sw[i] >>= tmp8u;
+                    VM(*EM, sw) >>= (tmp8u>15)?15:tmp8u;
                     break;
                 case 6:                 /* PSLLW Em, Ib */
                     tmp8u = F8;
                     if(tmp8u>15)
                         {EM->q = 0;}
                     else
-                        for (int i=0; i<4; ++i) EM->uw[i] <<= tmp8u;
+                        VM(*EM, uw) <<= tmp8u;
                     break;
                 default:
                     goto _default;
@@ -600,18 +540,18 @@
                     if(tmp8u>31)
                         {EM->q = 0;}
                     else
-                        for (int i=0; i<2; ++i) EM->ud[i] >>= tmp8u;
+                        VM(*EM, ud) >>= tmp8u;
                     break;
                 case 4:                 /* PSRAD Em, Ib */
                     tmp8u = F8;
-                    for (int i=0; i<2; ++i) EM->sd[i] >>= tmp8u;
+                    VM(*EM, sd) >>= (tmp8u>31)?31:tmp8u;
                     break;
                 case 6:                 /* PSLLD Em, Ib */
                     tmp8u = F8;
                     if(tmp8u>31)
                         {EM->q = 0;}
                     else
-                        for (int i=0; i<2; ++i) EM->ud[i] <<= tmp8u;
+                        VM(*EM, ud) <<= tmp8u;
                     break;
                 default:
                     goto _default;
@@ -642,23 +582,17 @@
         _0f_0x74:                       /* PCMPEQB Gm,Em */
             nextop = F8;
             GET_EM;
-            for (int i = 0; i < 8; i++) {
-                GM.ub[i] = (GM.sb[i] == EM->sb[i]) ? 0xFF : 0;
-            }
+            VM(GM, ub) = (vm_ub)(VM(GM, ub) == VM(*EM, ub));
             NEXT;
         _0f_0x75:                       /* PCMPEQW Gm,Em */
             nextop = F8;
             GET_EM;
-            for (int i = 0; i < 4; i++) {
-                GM.uw[i] = (GM.sw[i] == EM->sw[i]) ? 0xFFFF : 0;
-            }
+            VM(GM, uw) = (vm_uw)(VM(GM, uw) == VM(*EM, uw));
             NEXT;
         _0f_0x76:                       /* PCMPEQD Gm,Em */
             nextop = F8;
             GET_EM;
-            for (int i = 0; i < 2; i++) {
-                GM.ud[i] = (GM.sd[i] == EM->sd[i]) ? 0xFFFFFFFF : 0;
-            }
+            VM(GM, ud) = (vm_ud)(VM(GM, ud) == VM(*EM, ud));
             NEXT;
         _0f_0x77:                      /* EMMS */
             // empty MMX, FPU now usable
@@ -799,7 +733,7 @@
             nextop = F8;
             GET_EB;
             cmp8(emu, R_AL, EB->byte[0]);
-            if(ACCESS_FLAG(F_ZF)) {
+            if(LAZY_FLAG(F_ZF)) {
                 EB->byte[0] = GB;
             } else {
                 R_AL = EB->byte[0];
@@ -809,7 +743,7 @@
             nextop = F8;
             GET_ED;
             cmp32(emu, R_EAX, ED->dword[0]);
-            if(ACCESS_FLAG(F_ZF)) {
+            if(LAZY_FLAG(F_ZF)) {
                 ED->dword[0] = GD.dword[0];
             } else {
                 R_EAX = ED->dword[0];
@@ -1021,14 +955,7 @@
             nextop = F8;
             GET_EX;
             tmp8u = F8;
-            for(int i=0; i<2; ++i) {
-                eax1.ud[i] = GX.ud[(tmp8u>>(i*2))&3];
-            }
-            for(int i=2; i<4; ++i) {
-                eax1.ud[i] = EX->ud[(tmp8u>>(i*2))&3];
-            }
-            GX.q[0] = eax1.q[0];
-            GX.q[1] = eax1.q[1];
+            VX(GX, ud) = __builtin_shuffle(VX(GX, ud), VX(*EX, ud), (vx_ud){tmp8u&3, (tmp8u>>2)&3, 4+((tmp8u>>4)&3), 4+(tmp8u>>6)});
             NEXT;
         _0f_0xC7:                      /* CMPXCHG8B Gq */
             CHECK_FLAGS(emu);
@@ -1062,23 +989,17 @@
             nextop = F8;
             GET_EM;
             if(EM->q>15)
-                GM.q=0; 
-            else {
-                tmp8u = EM->ub[0];
-                for(int i=0; i<4; ++i)
-                    GM.uw[i] >>= tmp8u;
-            }
+                GM.q=0;
+            else
+                VM(GM, uw) >>= EM->ub[0];
             NEXT;
         _0f_0xD2:                   /* PSRLD Gm,Em */
             nextop = F8;
             GET_EM;
             if(EM->q>31)
                 GM.q=0;
-            else {
-                tmp8u = EM->ub[0];
-                for(int i=0; i<2; ++i)
-                    GM.ud[i] >>= tmp8u;
-            }
+            else
+                VM(GM, ud) >>= EM->ub[0];
             NEXT;
         _0f_0xD3:                   /* PSRLQ Gm,Em */
             nextop = F8;
@@ -1093,10 +1014,7 @@
         _0f_0xD5:                   /* PMULLW Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<4; ++i) {
-                tmp32s = (int32_t)GM.sw[i] * EM->sw[i];
-                GM.sw[i] = tmp32s;
-            }
+            VM(GM, uw) *= VM(*EM, uw);
             NEXT;
 
         _0f_0xD7:                   /* PMOVMSKB Gd,Em */
@@ -1113,24 +1031,17 @@
         _0f_0xD8:                   /* PSUBUSB Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<8; ++i) {
-                tmp32s = (int32_t)GM.ub[i] - EM->ub[i];
-                GM.ub[i] = (tmp32s < 0) ? 0 : tmp32s;
-            }
+            VM(GM, ub) = vm_ub_subus(VM(GM, ub), VM(*EM, ub));
             NEXT;
         _0f_0xD9:                   /* PSUBUSW Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<4; ++i) {
-                tmp32s = (int32_t)GM.uw[i] - EM->uw[i];
-                GM.uw[i] = (tmp32s < 0) ? 0 : tmp32s;
-            }
+            VM(GM, uw) = vm_uw_subus(VM(GM, uw), VM(*EM, uw));
             NEXT;
         _0f_0xDA:                   /* PMINUB Gm,Em */
             nextop = F8;
             GET_EM;
-            for (int i=0; i<8; ++i)
-                GM.ub[i] = (GM.ub[i]<EM->ub[i])?GM.ub[i]:EM->ub[i];
+            VM(GM, ub) = vm_ub_min(VM(GM, ub), VM(*EM, ub));
             NEXT;
         _0f_0xDB:                   /* PAND Gm,Em */
             nextop = F8;
@@ -1140,24 +1051,17 @@
         _0f_0xDC:                   /* PADDUSB Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<8; ++i) {
-                tmp32u = (uint32_t)GM.ub[i] + EM->ub[i];
-                GM.ub[i] = (tmp32u>255) ? 255 : tmp32u;
-            }
+            VM(GM, ub) = vm_ub_addus(VM(GM, ub), VM(*EM, ub));
             NEXT;
         _0f_0xDD:                   /* PADDUSW Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<4; ++i) {
-                tmp32u = (uint32_t)GM.uw[i] + EM->uw[i];
-                GM.uw[i] = (tmp32u>65535) ? 65535 : tmp32u;
-            }
+            VM(GM, uw) = vm_uw_addus(VM(GM, uw), VM(*EM, uw));
             NEXT;
         _0f_0xDE:                   /* PMAXUB Gm,Em */
             nextop = F8;
             GET_EM;
-            for (int i=0; i<8; ++i)
-                GM.ub[i] = (GM.ub[i]>EM->ub[i])?GM.ub[i]:EM->ub[i];
+            VM(GM, ub) = vm_ub_max(VM(GM, ub), VM(*EM, ub));
             NEXT;
         _0f_0xDF:                   /* PANDN Gm,Em */
             nextop = F8;
@@ -1167,55 +1071,32 @@
         _0f_0xE0:                   /* PAVGB Gm, Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<8; ++i)
-                    GM.ub[i] = ((uint32_t)GM.ub[i]+EM->ub[i]+1)>>1;
+            VM(GM, ub) = vm_ub_avg(VM(GM, ub), VM(*EM, ub));
             NEXT;
         _0f_0xE1:                   /* PSRAW Gm, Em */
             nextop = F8;
             GET_EM;
-            if(EM->q>15)
-                tmp8u = 16;
-            else
-                tmp8u = EM->ub[0];
-            for(int i=0; i<4; ++i)
-                GM.sw[i] >>= tmp8u;
+            VM(GM, sw) >>= (EM->q>15)?15:EM->ub[0];
             NEXT;
         _0f_0xE2:                   /* PSRAD Gm, Em */
             nextop = F8;
             GET_EM;
-            if(EM->q>31) {
-                for(int i=0; i<2; ++i)
-                    GM.sd[i] = (GM.sd[i]<0)?-1:0;
-            } else {
-                tmp8u = EM->ub[0];
-                for(int i=0; i<2; ++i)
-                    GM.sd[i] >>= tmp8u;
-            }
+            VM(GM, sd) >>= (EM->q>31)?31:EM->ub[0];
             NEXT;
-        _0f_0xE3:                   /* PSRAQ Gm, Em */
+        _0f_0xE3:                   /* PAVGW Gm, Em */
             nextop = F8;
             GET_EM;
-            if(EM->q>63)
-                tmp8u = 64;
-            else
-                tmp8u = EM->ub[0];
-            GM.sq >>= tmp8u;
+            VM(GM, uw) = vm_uw_avg(VM(GM, uw), VM(*EM, uw));
             NEXT;
         _0f_0xE4:                   /* PMULHUW Gm, Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<4; ++i) {
-                tmp32u = (int32_t)GM.uw[i] * EM->uw[i];
-                GM.uw[i] = (tmp32u>>16)&0xffff;
-            }
+            VM(GM, uw) = vm_mulhu(VM(GM, uw), VM(*EM, uw));
             NEXT;
         _0f_0xE5:                   /* PMULHW Gm, Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<4; ++i) {
-                tmp32s = (int32_t)GM.sw[i] * EM->sw[i];
-                GM.uw[i] = (tmp32s>>16)&0xffff;
-            }
+            VM(GM, sw) = vm_mulhs(VM(GM, sw), VM(*EM, sw));
             NEXT;
 
         _0f_0xE7:                   /* MOVNTQ Em,Gm */
@@ -1228,24 +1109,17 @@
         _0f_0xE8:                   /* PSUBSB Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<8; ++i) {
-                tmp32s = (int32_t)GM.sb[i] - EM->sb[i];
-                GM.sb[i] = (tmp32s>127)?127:((tmp32s<-128)?-128:tmp32s);
-            }
+            VM(GM, sb) = vm_sb_subs(VM(GM, sb), VM(*EM, sb));
             NEXT;
         _0f_0xE9:                   /* PSUBSW Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<4; ++i) {
-                tmp32s = (int32_t)GM.sw[i] - EM->sw[i];
-                GM.sw[i] = (tmp32s>32767)?32767:((tmp32s<-32768)?-32768:tmp32s);
-            }
+            VM(GM, sw) = vm_sw_subs(VM(GM, sw), VM(*EM, sw));
             NEXT;
         _0f_0xEA:                   /* PMINSW Gm,Em */
             nextop = F8;
             GET_EM;
-            for (int i=0; i<4; ++i)
-                GM.sw[i] = (GM.sw[i]<EM->sw[i])?GM.sw[i]:EM->sw[i];
+            VM(GM, sw) = vm_sw_min(VM(GM, sw), VM(*EM, sw));
             NEXT;
         _0f_0xEB:                   /* POR Gm, Em */
             nextop = F8;
@@ -1255,24 +1129,17 @@
         _0f_0xEC:                   /* PADDSB Gm, Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<8; ++i) {
-                tmp32s = (int32_t)GM.sb[i] + EM->sb[i];
-                GM.sb[i] = (tmp32s>127)?127:((tmp32s<-128)?-128:tmp32s);
-            }
+            VM(GM, sb) = vm_sb_adds(VM(GM, sb), VM(*EM, sb));
             NEXT;
         _0f_0xED:                   /* PADDSW Gm, Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<4; ++i) {
-                tmp32s = (int32_t)GM.sw[i] + EM->sw[i];
-                GM.sw[i] = (tmp32s>32767)?32767:((tmp32s<-32768)?-32768:tmp32s);
-            }
+            VM(GM, sw) = vm_sw_adds(VM(GM, sw), VM(*EM, sw));
             NEXT;
         _0f_0xEE:                   /* PMAXSW Gm,Em */
             nextop = F8;
             GET_EM;
-            for (int i=0; i<4; ++i)
-                GM.sw[i] = (GM.sw[i]>EM->sw[i])?GM.sw[i]:EM->sw[i];
+            VM(GM, sw) = vm_sw_max(VM(GM, sw), VM(*EM, sw));
             NEXT;
         _0f_0xEF:                   /* PXOR Gm, Em */
             nextop = F8;
@@ -1284,23 +1151,17 @@
             nextop = F8;
             GET_EM;
             if(EM->q>15)
-                GM.q = 0;
-            else {
-                tmp8u = EM->ub[0];
-                for(int i=0; i<4; ++i)
-                    GM.sw[i] <<= tmp8u;
-            }
+                GM.q=0;
+            else
+                VM(GM, uw) <<= EM->ub[0];
             NEXT;
         _0f_0xF2:                   /* PSLLD Gm, Em */
             nextop = F8;
             GET_EM;
             if(EM->q>31)
-                GM.q = 0;
-            else {
-                tmp8u = EM->ub[0];
-                for(int i=0; i<2; ++i)
-                    GM.sd[i] <<= tmp8u;
-            }
+                GM.q=0;
+            else
+                VM(GM, ud) <<= EM->ub[0];
             NEXT;
         _0f_0xF3:                   /* PSLLQ Gm, Em */
             nextop = F8;
@@ -1315,13 +1176,7 @@
         _0f_0xF5:                   /* PMADDWD Gm, Em */
             nextop = F8;
             GET_EM;
-            for (int i=0; i<2; ++i) {
-                int offset = i * 2;
-
-                tmp32s = (int32_t)GM.sw[offset + 0] * EM->sw[offset + 0];
-                tmp32s2 = (int32_t)GM.sw[offset + 1] * EM->sw[offset + 1];
-                GM.sd[i] = tmp32s + tmp32s2;
-            }
+            VM(GM, sd) = vm_madd(VM(GM, sw), VM(*EM, sw));
             NEXT;
         _0f_0xF6:                   /* PSADBW Gm, Em */
             nextop = F8;
@@ -1343,37 +1198,31 @@
         _0f_0xF8:                   /* PSUBB Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<8; ++i)
-                GM.sb[i] -= EM->sb[i];
+            VM(GM, ub) -= VM(*EM, ub);
             NEXT;
         _0f_0xF9:                   /* PSUBW Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<4; ++i)
-                GM.sw[i] -= EM->sw[i];
+            VM(GM, uw) -= VM(*EM, uw);
             NEXT;
         _0f_0xFA:                   /* PSUBD Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<2; ++i)
-                GM.sd[i] -= EM->sd[i];
+            VM(GM, ud) -= VM(*EM, ud);
             NEXT;
 
         _0f_0xFC:                   /* PADDB Gm, Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<8; ++i)
-                GM.sb[i] += EM->sb[i];
+            VM(GM, ub) += VM(*EM, ub);
             NEXT;
         _0f_0xFD:                   /* PADDW Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<4; ++i)
-                GM.sw[i] += EM->sw[i];
+            VM(GM, uw) += VM(*EM, uw);
             NEXT;
         _0f_0xFE:                   /* PADDD Gm,Em */
             nextop = F8;
             GET_EM;
-            for(int i=0; i<2; ++i)
-                GM.sd[i] += EM->sd[i];
+            VM(GM, ud) += VM(*EM, ud);
             NEXT;
@@ -100,15 +100,7 @@
         nextop = F8;
         GET_EX;
         tmp8u = F8;
-        if(&GX==EX) {
-            for (int i=0; i<4; ++i)
-                eax1.uw[i] = EX->uw[(tmp8u>>(i*2))&3];
-            GX.q[0] = eax1.q[0];
-        } else {
-            for (int i=0; i<4; ++i)
-                GX.uw[i] = EX->uw[(tmp8u>>(i*2))&3];
-            GX.q[1] = EX->q[1];
-        }
+        VX(GX, uw) = __builtin_shuffle(VX(*EX, uw), (vx_uw){tmp8u&3, (tmp8u>>2)&3, (tmp8u>>4)&3, tmp8u>>6, 4, 5, 6, 7});
         break;
 
     case 0x7C:  /* HADDPS Gx, Ex */
@@ -128,87 +120,87 @@
     #define GOCOND(BASE, PREFIX, CONDITIONAL)   \
     case BASE+0:                                \
         PREFIX                                  \
-        if(ACCESS_FLAG(F_OF))                   \
+        if(LAZY_FLAG(F_OF))                   \
             CONDITIONAL                         \
         break;                                  \
     case BASE+1:                                \
         PREFIX                                  \
-        if(!ACCESS_FLAG(F_OF))                  \
+        if(!LAZY_FLAG(F_OF))                  \
             CONDITIONAL                         \
         break;                                  \
     case BASE+2:                                \
         PREFIX                                  \
-        if(ACCESS_FLAG(F_CF))                   \
+        if(LAZY_FLAG(F_CF))                   \
             CONDITIONAL                         \
         break;                                  \
     case BASE+3:                                \
         PREFIX                                  \
-        if(!ACCESS_FLAG(F_CF))                  \
+        if(!LAZY_FLAG(F_CF))                  \
             CONDITIONAL                         \
         break;                                  \
     case BASE+4:                                \
         PREFIX                                  \
-        if(ACCESS_FLAG(F_ZF))                   \
+        if(LAZY_FLAG(F_ZF))                   \
             CONDITIONAL                         \
         break;                                  \
     case BASE+5:                                \
         PREFIX                                  \
-        if(!ACCESS_FLAG(F_ZF))                  \
+        if(!LAZY_FLAG(F_ZF))                  \
             CONDITIONAL                         \
         break;                                  \
     case BASE+6:                                \
         PREFIX                                  \
-        if((ACCESS_FLAG(F_ZF) || ACCESS_FLAG(F_CF)))  \
+        if((LAZY_FLAG(F_ZF) || LAZY_FLAG(F_CF)))  \
             CONDITIONAL                         \
         break;                                  \
     case BASE+7:                                \
         PREFIX                                  \
-        if(!(ACCESS_FLAG(F_ZF) || ACCESS_FLAG(F_CF))) \
+        if(!(LAZY_FLAG(F_ZF) || LAZY_FLAG(F_CF))) \
             CONDITIONAL                         \
         break;                                  \
     case BASE+8:                                \
         PREFIX                                  \
-        if(ACCESS_FLAG(F_SF))                   \
+        if(LAZY_FLAG(F_SF))                   \
             CONDITIONAL                         \
         break;                                  \
     case BASE+9:                                \
         PREFIX                                  \
-        if(!ACCESS_FLAG(F_SF))                  \
+        if(!LAZY_FLAG(F_SF))                  \
             CONDITIONAL                         \
         break;                                  \
     case BASE+0xA:                              \
         PREFIX                                  \
-        if(ACCESS_FLAG(F_PF))                   \
+        if(LAZY_FLAG(F_PF))                   \
             CONDITIONAL                         \
         break;                                  \
     case BASE+0xB:                              \
         PREFIX                                  \
-        if(!ACCESS_FLAG(F_PF))                  \
+        if(!LAZY_FLAG(F_PF))                  \
             CONDITIONAL                         \
         break;                                  \
     case BASE+0xC:                              \
         PREFIX                                  \
-        if(ACCESS_FLAG(F_SF) != ACCESS_FLAG(F_OF))  \
+        if(LAZY_FLAG(F_SF) != LAZY_FLAG(F_OF))  \
             CONDITIONAL                         \
         break;                                  \
     case BASE+0xD:                              \
         PREFIX                                  \
-        if(ACCESS_FLAG(F_SF) == ACCESS_FLAG(F_OF)) \
+        if(LAZY_FLAG(F_SF) == LAZY_FLAG(F_OF)) \
             CONDITIONAL                         \
         break;                                  \
     case BASE+0xE:                              \
         PREFIX                                  \
-        if(ACCESS_FLAG(F_ZF) || (ACCESS_FLAG(F_SF) != ACCESS_FLAG(F_OF))) \
+        if(LAZY_FLAG(F_ZF) || (LAZY_FLAG(F_SF) != LAZY_FLAG(F_OF))) \
             CONDITIONAL                         \
         break;                                  \
     case BASE+0xF:                              \
         PREFIX                                  \
-        if(!ACCESS_FLAG(F_ZF) && (ACCESS_FLAG(F_SF) == ACCESS_FLAG(F_OF))) \
+        if(!LAZY_FLAG(F_ZF) && (LAZY_FLAG(F_SF) == LAZY_FLAG(F_OF))) \
             CONDITIONAL                         \
         break;
         
     GOCOND(0x80
-        , tmp32s = F32S; CHECK_FLAGS(emu);
+        , tmp32s = F32S;
         , ip += tmp32s;
     )                               /* 0x80 -> 0x8F Jxx */
         
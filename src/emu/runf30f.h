@@ -140,15 +140,7 @@
         nextop = F8;
         GET_EX;
         tmp8u = F8;
-        if(&GX==EX) {
-            for (int i=0; i<4; ++i)
-                eax1.uw[4+i] = EX->uw[4+((tmp8u>>(i*2))&3)];
-            GX.q[1] = eax1.q[1];
-        } else {
-            for (int i=0; i<4; ++i)
-                GX.uw[4+i] = EX->uw[4+((tmp8u>>(i*2))&3)];
-            GX.q[0] = EX->q[0];
-        }
+        VX(GX, uw) = __builtin_shuffle(VX(*EX, uw), (vx_uw){0, 1, 2, 3, 4+(tmp8u&3), 4+((tmp8u>>2)&3), 4+((tmp8u>>4)&3), 4+(tmp8u>>6)});
         break;
 
     case 0x7E:  /* MOVQ Gx, Ex */
@@ -22,6 +22,9 @@
 #include "wrapper.h"
 #include "box86context.h"
 #include "librarian.h"
+#ifdef DYNAREC
+#include "dynaevict.h"
+#endif
 
 #include <elf.h>
 #include "elfloader.h"
@@ -80,6 +83,9 @@ void x86Int3(x86emu_t* emu)
             RESET_FLAGS(emu);
             wrapper_t w = (wrapper_t)addr;
             addr = Fetch32(emu);
+            #ifdef DYNAREC
+            dynablock_t* native = DynaNativeEnter(__builtin_return_address(0));
+            #endif
             /* This party can be used to trace only 1 specific lib (but it is quite slow)
             elfheader_t *h = FindElfAddress(my_context, *(uintptr_t*)(R_ESP));
             int have_trace = 0;
@@ -282,6 +288,9 @@ void x86Int3(x86emu_t* emu)
                 pthread_mutex_unlock(&emu->context->mutex_trace);
             } else
                 w(emu, addr);
+            #ifdef DYNAREC
+            DynaNativeLeave(native);
+            #endif
         }
         return;
     }
@@ -296,31 +296,6 @@ uint32_t adc32(x86emu_t *emu, uint32_t d, uint32_t s)
 	return res;
 }
 
-/****************************************************************************
-REMARKS:
-Implements the CMP instruction and side effects.
-****************************************************************************/
-uint8_t cmp8(x86emu_t *emu, uint8_t d, uint8_t s)
-{
-	uint32_t res;   /* all operands in native machine order */
-	uint32_t bc;
-
-	RESET_FLAGS(emu);
-
-	res = d - s;
-	CLEAR_FLAG(F_CF);
-	CONDITIONAL_SET_FLAG(res & 0x80, F_SF);
-	CONDITIONAL_SET_FLAG((res & 0xff) == 0, F_ZF);
-	CONDITIONAL_SET_FLAG(PARITY(res & 0xff), F_PF);
-
-	/* calculate the borrow chain.  See note at top */
-	bc = (res & (~d | s)) | (~d & s);
-	CONDITIONAL_SET_FLAG(bc & 0x80, F_CF);
-	CONDITIONAL_SET_FLAG(XOR2(bc >> 6), F_OF);
-	CONDITIONAL_SET_FLAG(bc & 0x8, F_AF);
-	return d;
-}
-
 /****************************************************************************
 REMARKS:
 Implements the CMP instruction and side effects.
@@ -345,30 +320,6 @@ uint16_t cmp16(x86emu_t *emu, uint16_t d, uint16_t s)
 	return d;
 }
 
-/****************************************************************************
-REMARKS:
-Implements the CMP instruction and side effects.
-****************************************************************************/
-uint32_t cmp32(x86emu_t *emu, uint32_t d, uint32_t s)
-{
-	uint32_t res;   /* all operands in native machine order */
-	uint32_t bc;
-
-	RESET_FLAGS(emu);
-
-	res = d - s;
-	CONDITIONAL_SET_FLAG(res & 0x80000000, F_SF);
-	CONDITIONAL_SET_FLAG(!res, F_ZF);
-	CONDITIONAL_SET_FLAG(PARITY(res & 0xff), F_PF);
-
-	/* calculate the borrow chain.  See note at top */
-	bc = (res & (~d | s)) | (~d & s);
-	CONDITIONAL_SET_FLAG(bc & 0x80000000, F_CF);
-	CONDITIONAL_SET_FLAG(XOR2(bc >> 30), F_OF);
-	CONDITIONAL_SET_FLAG(bc & 0x8, F_AF);
-	return d;
-}
-
 /****************************************************************************
 REMARKS:
 Implements the DAA instruction and side effects.
@@ -714,7 +665,7 @@ uint8_t rol8(x86emu_t *emu, uint8_t d, uint8_t s)
 	if((cnt = s % 8) != 0) {
 	d = (d << cnt) + ((d >> (8 - cnt)) & ((1 << cnt) - 1));
 	}
-	RESET_FLAGS(emu);
+	CHECK_FLAGS(emu);
 
 	/* OF flag is set if s == 1; OF = CF _XOR_ MSB of result */
 	if(s == 1) {
@@ -741,7 +692,7 @@ uint16_t rol16(x86emu_t *emu, uint16_t d, uint8_t s)
 	if((cnt = s % 16) != 0) {
 	d = (d << cnt) + ((d >> (16 - cnt)) & ((1 << cnt) - 1));
 	}
-	RESET_FLAGS(emu);
+	CHECK_FLAGS(emu);
 
 	/* OF flag is set if s == 1; OF = CF _XOR_ MSB of result */
 	if(s == 1) {
@@ -768,7 +719,7 @@ uint32_t rol32(x86emu_t *emu, uint32_t d, uint8_t s)
 	if((cnt = s % 32) != 0) {
 	d = (d << cnt) + ((d >> (32 - cnt)) & ((1 << cnt) - 1));
 	}
-	RESET_FLAGS(emu);
+	CHECK_FLAGS(emu);
 
 	/* OF flag is set if s == 1; OF = CF _XOR_ MSB of result */
 	if(s == 1) {
@@ -795,7 +746,7 @@ uint8_t ror8(x86emu_t *emu, uint8_t d, uint8_t s)
 	if((cnt = s % 8) != 0) {
 	d = (d << (8 - cnt)) + ((d >> (cnt)) & ((1 << (8 - cnt)) - 1));
 	}
-	RESET_FLAGS(emu);
+	CHECK_FLAGS(emu);
 
 	/* OF flag is set if s == 1; OF = MSB _XOR_ (M-1)SB of result */
 	if(s == 1) {
@@ -822,7 +773,7 @@ uint16_t ror16(x86emu_t *emu, uint16_t d, uint8_t s)
 	if((cnt = s % 16) != 0) {
 	d = (d << (16 - cnt)) + ((d >> (cnt)) & ((1 << (16 - cnt)) - 1));
 	}
-	RESET_FLAGS(emu);
+	CHECK_FLAGS(emu);
 
 	/* OF flag is set if s == 1; OF = MSB _XOR_ (M-1)SB of result */
 	if(s == 1) {
@@ -849,7 +800,7 @@ uint32_t ror32(x86emu_t *emu, uint32_t d, uint8_t s)
 	if((cnt = s % 32) != 0) {
 	d = (d << (32 - cnt)) + ((d >> (cnt)) & ((1 << (32 - cnt)) - 1));
 	}
-	RESET_FLAGS(emu);
+	CHECK_FLAGS(emu);
 
 	/* OF flag is set if s == 1; OF = MSB _XOR_ (M-1)SB of result */
 	if(s == 1) {
@@ -869,7 +820,7 @@ Implements the SHLD instruction and side effects.
 uint16_t shld16 (x86emu_t *emu, uint16_t d, uint16_t fill, uint8_t s)
 {
 	unsigned int cnt, res, cf;
-	RESET_FLAGS(emu);
+	CHECK_FLAGS(emu);
 
 	s = s&0x1f;
 	cnt = s % 16;
@@ -912,7 +863,7 @@ Implements the SHLD instruction and side effects.
 uint32_t shld32 (x86emu_t *emu, uint32_t d, uint32_t fill, uint8_t s)
 {
 	unsigned int cnt, res, cf;
-	RESET_FLAGS(emu);
+	CHECK_FLAGS(emu);
 
 	s = s&0x1f;
 	cnt = s % 32;
@@ -942,7 +893,7 @@ Implements the SHRD instruction and side effects.
 uint16_t shrd16 (x86emu_t *emu, uint16_t d, uint16_t fill, uint8_t s)
 {
 	unsigned int cnt, res, cf;
-	RESET_FLAGS(emu);
+	CHECK_FLAGS(emu);
 
 	s = s&0x1f;
 	cnt = s % 16;
@@ -990,7 +941,7 @@ Implements the SHRD instruction and side effects.
 uint32_t shrd32 (x86emu_t *emu, uint32_t d, uint32_t fill, uint8_t s)
 {
 	unsigned int cnt, res, cf;
-	RESET_FLAGS(emu);
+	CHECK_FLAGS(emu);
 
 	s = s&0x1f;
 	cnt = s % 32;
@@ -1090,25 +1041,6 @@ uint32_t sbb32(x86emu_t *emu, uint32_t d, uint32_t s)
 	return res;
 }
 
-/****************************************************************************
-REMARKS:
-Implements the TEST instruction and side effects.
-****************************************************************************/
-void test8(x86emu_t *emu, uint8_t d, uint8_t s)
-{
-    uint32_t res;   /* all operands in native machine order */
-	RESET_FLAGS(emu);
-
-    res = d & s;
-
-	CLEAR_FLAG(F_OF);
-	CONDITIONAL_SET_FLAG(res & 0x80, F_SF);
-	CONDITIONAL_SET_FLAG(res == 0, F_ZF);
-	CONDITIONAL_SET_FLAG(PARITY(res & 0xff), F_PF);
-    /* AF == dont care */
-	CLEAR_FLAG(F_CF);
-}
-
 /****************************************************************************
 REMARKS:
 Implements the TEST instruction and side effects.
@@ -1128,25 +1060,6 @@ void test16(x86emu_t *emu, uint16_t d, uint16_t s)
 	CLEAR_FLAG(F_CF);
 }
 
-/****************************************************************************
-REMARKS:
-Implements the TEST instruction and side effects.
-****************************************************************************/
-void test32(x86emu_t *emu, uint32_t d, uint32_t s)
-{
-	uint32_t res;   /* all operands in native machine order */
-	RESET_FLAGS(emu);
-
-	res = d & s;
-
-	CLEAR_FLAG(F_OF);
-	CONDITIONAL_SET_FLAG(res & 0x80000000, F_SF);
-	CONDITIONAL_SET_FLAG(res == 0, F_ZF);
-	CONDITIONAL_SET_FLAG(PARITY(res & 0xff), F_PF);
-	/* AF == dont care */
-	CLEAR_FLAG(F_CF);
-}
-
 /****************************************************************************
 REMARKS:
 Implements the IDIV instruction and side effects.
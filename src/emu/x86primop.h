@@ -86,9 +86,31 @@ static inline uint32_t and32(x86emu_t *emu, uint32_t d, uint32_t s)
 
 	return emu->res;
 }
-uint8_t      cmp8  (x86emu_t *emu, uint8_t d, uint8_t s);
+/****************************************************************************
+REMARKS:
+Implements the CMP instruction and side effects.
+****************************************************************************/
+static inline uint8_t cmp8(x86emu_t *emu, uint8_t d, uint8_t s)
+{
+	emu->res = d - s;
+	emu->op1 = d;
+	emu->op2 = s;
+	emu->df = d_cmp8;
+	return d;
+}
 uint16_t     cmp16 (x86emu_t *emu, uint16_t d, uint16_t s);
-uint32_t     cmp32 (x86emu_t *emu, uint32_t d, uint32_t s);
+/****************************************************************************
+REMARKS:
+Implements the CMP instruction and side effects.
+****************************************************************************/
+static inline uint32_t cmp32(x86emu_t *emu, uint32_t d, uint32_t s)
+{
+	emu->res = d - s;
+	emu->op1 = d;
+	emu->op2 = s;
+	emu->df = d_cmp32;
+	return d;
+}
 uint8_t      daa8  (x86emu_t *emu, uint8_t d);
 uint8_t      das8  (x86emu_t *emu, uint8_t d);
 /****************************************************************************
@@ -97,6 +119,7 @@ Implements the DEC instruction and side effects.
 ****************************************************************************/
 static inline uint8_t dec8(x86emu_t *emu, uint8_t d)
 {
+	KEEP_CF(emu);	// CF is not changed
     emu->res = d - 1;
 	emu->op1 = d;
 	emu->df = d_dec8;
@@ -109,6 +132,7 @@ Implements the DEC instruction and side effects.
 ****************************************************************************/
 static inline uint16_t dec16(x86emu_t *emu, uint16_t d)
 {
+	KEEP_CF(emu);	// CF is not changed
     emu->res = d - 1;
 	emu->op1 = d;
 	emu->df = d_dec16;
@@ -122,6 +146,7 @@ Implements the DEC instruction and side effects.
 ****************************************************************************/
 static inline uint32_t dec32(x86emu_t *emu, uint32_t d)
 {
+	KEEP_CF(emu);	// CF is not changed
     emu->res = d - 1;
 	emu->op1 = d;
 	emu->df = d_dec32;
@@ -135,6 +160,7 @@ Implements the INC instruction and side effects.
 ****************************************************************************/
 static inline uint8_t inc8(x86emu_t *emu, uint8_t d)
 {
+	KEEP_CF(emu);	// CF is not changed
 	emu->res = d + 1;
 	emu->op1 = d;
 	emu->df = d_inc8;
@@ -147,6 +173,7 @@ Implements the INC instruction and side effects.
 ****************************************************************************/
 static inline uint16_t inc16(x86emu_t *emu, uint16_t d)
 {
+	KEEP_CF(emu);	// CF is not changed
 	emu->res = d + 1;
 	emu->op1 = d;
 	emu->df = d_inc16;
@@ -159,14 +186,7 @@ Implements the INC instruction and side effects.
 ****************************************************************************/
 static inline uint32_t inc32(x86emu_t *emu, uint32_t d)
 {
-	if(emu->df == d_shr32) {
-		// workaround for some wine trickery
-		uint32_t cnt = emu->op2;
-        if (cnt > 0) {
-            uint32_t cc = emu->op1 & (1 << (cnt - 1));
-			CONDITIONAL_SET_FLAG(cc, F_CF);
-		}
-	}
+	KEEP_CF(emu);	// CF is not changed
 	emu->res = d + 1;
 	emu->op1 = d;
 	emu->df = d_inc32;
@@ -295,10 +315,10 @@ Implements the SHL instruction and side effects.
 ****************************************************************************/
 static inline uint8_t shl8(x86emu_t *emu, uint8_t d, uint8_t s)
 {
+	s &= 0x1f;
+	if(!s) return d;	// flags are not changed
 	emu->df = d_shl8;
 	emu->op1 = d;
-
-	s &= 0x1f;
 	emu->op2 = s;
 	emu->res = d << s;
 
@@ -311,10 +331,10 @@ Implements the SHL instruction and side effects.
 ****************************************************************************/
 static inline uint16_t shl16(x86emu_t *emu, uint16_t d, uint8_t s)
 {
+	s &= 0x1f;
+	if(!s) return d;	// flags are not changed
 	emu->df = d_shl16;
 	emu->op1 = d;
-
-	s &= 0x1f;
 	emu->op2 = s;
 	emu->res = d << s;
 	return (uint16_t)emu->res;
@@ -326,10 +346,10 @@ Implements the SHL instruction and side effects.
 ****************************************************************************/
 static inline uint32_t shl32(x86emu_t *emu, uint32_t d, uint8_t s)
 {
+	s &= 0x1f;
+	if(!s) return d;	// flags are not changed
 	emu->df = d_shl32;
 	emu->op1 = d;
-
-	s &= 0x1f;
 	emu->op2 = s;
 	emu->res = d << s;
 
@@ -342,10 +362,10 @@ Implements the SHR instruction and side effects.
 ****************************************************************************/
 static inline uint8_t shr8(x86emu_t *emu, uint8_t d, uint8_t s)
 {
+	s &= 0x1f;
+	if(!s) return d;	// flags are not changed
 	emu->df = d_shr8;
 	emu->op1 = d;
-
-	s &= 0x1f;
 	emu->op2 = s;
 	emu->res = d >> s;
 
@@ -358,10 +378,10 @@ Implements the SHR instruction and side effects.
 ****************************************************************************/
 static inline uint16_t shr16(x86emu_t *emu, uint16_t d, uint8_t s)
 {
+	s &= 0x1f;
+	if(!s) return d;	// flags are not changed
 	emu->df = d_shr16;
 	emu->op1 = d;
-
-	s &= 0x1f;
 	emu->op2 = s;
 	emu->res = d >> s;
 
@@ -374,12 +394,10 @@ Implements the SHR instruction and side effects.
 ****************************************************************************/
 static inline uint32_t shr32(x86emu_t *emu, uint32_t d, uint8_t s)
 {
-	RESET_FLAGS(emu);	// TODO: Defered this one?
-
+	s &= 0x1f;
+	if(!s) return d;	// flags are not changed
 	emu->df = d_shr32;
 	emu->op1 = d;
-
-	s &= 0x1f;
 	emu->op2 = s;
 	emu->res = d >> s;
 
@@ -392,10 +410,10 @@ Implements the SAR instruction and side effects.
 ****************************************************************************/
 static inline uint8_t sar8(x86emu_t *emu, uint8_t d, uint8_t s)
 {
+	s &= 0x1f;
+	if(!s) return d;	// flags are not changed
 	emu->df = d_sar8;
 	emu->op1 = d;
-
-	s &= 0x1f;
 	emu->op2 = s;
 	emu->res = (uint8_t)(((int8_t)d)>>s);
 
@@ -408,10 +426,10 @@ Implements the SAR instruction and side effects.
 ****************************************************************************/
 static inline uint16_t sar16(x86emu_t *emu, uint16_t d, uint8_t s)
 {
+	s &= 0x1f;
+	if(!s) return d;	// flags are not changed
 	emu->df = d_sar16;
 	emu->op1 = d;
-
-	s &= 0x1f;
 	emu->op2 = s;
 	emu->res = (uint16_t)(((int16_t)d)>>s);
 
@@ -424,10 +442,10 @@ Implements the SAR instruction and side effects.
 ****************************************************************************/
 static inline uint32_t sar32(x86emu_t *emu, uint32_t d, uint8_t s)
 {
+	s &= 0x1f;
+	if(!s) return d;	// flags are not changed
 	emu->df = d_sar32;
 	emu->op1 = d;
-
-	s &= 0x1f;
 	emu->op2 = s;
 	emu->res = (uint32_t)(((int32_t)d)>>s);
 
@@ -473,9 +491,25 @@ static inline uint32_t sub32(x86emu_t *emu, uint32_t d, uint32_t s)
 	return emu->res;
 }
 
-void         test8  (x86emu_t *emu, uint8_t d, uint8_t s);
+/****************************************************************************
+REMARKS:
+Implements the TEST instruction and side effects.
+****************************************************************************/
+static inline void test8(x86emu_t *emu, uint8_t d, uint8_t s)
+{
+	emu->res = d & s;
+	emu->df = d_tst8;
+}
 void         test16 (x86emu_t *emu, uint16_t d, uint16_t s);
-void         test32 (x86emu_t *emu, uint32_t d, uint32_t s);
+/****************************************************************************
+REMARKS:
+Implements the TEST instruction and side effects.
+****************************************************************************/
+static inline void test32(x86emu_t *emu, uint32_t d, uint32_t s)
+{
+	emu->res = d & s;
+	emu->df = d_tst32;
+}
 /****************************************************************************
 REMARKS:
 Implements the XOR instruction and side effects.
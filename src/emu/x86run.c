@@ -15,6 +15,7 @@
 #include "x86emu_private.h"
 #include "x86run_private.h"
 #include "x86primop.h"
+#include "x86simd.h"
 #include "x86trace.h"
 #include "x87emu_private.h"
 #include "box86context.h"
@@ -43,6 +44,9 @@ int Run(x86emu_t *emu, int step)
     double d;
     float f;
     int64_t ll;
+#ifndef DYNAREC
+    int emu_locked = 0;
+#endif
     sse_regs_t *opex, eax1;
     mmx_regs_t *opem, eam1;
 
@@ -186,6 +190,31 @@ _trace:
 #else
     #define NEXT    goto *baseopcodes[(R_EIP=ip, opcode=F8)]
 #endif
+#ifdef HAVE_TRACE
+#define FUSION  (box86_fusion && !my_context->dec)
+#else
+#define FUSION  box86_fusion
+#endif
+// a CMP/TEST/DEC followed by a Jcc (BOX86_FUSION): the Jcc is done here, on the operands of the defered flags (that are kept)
+#define FUSE(K)                                                 \
+    if(FUSION) {                                                \
+        tmp8u = PK(0);                                          \
+        if((tmp8u&0xf0)==0x70) {                                \
+            tmp32s = *(int8_t*)(ip+1);                          \
+            ip += 2;                                            \
+        } else if(tmp8u==0x0F && (PK(1)&0xf0)==0x80) {          \
+            tmp8u = PK(1);                                      \
+            tmp32s = *(int32_t*)(ip+2);                         \
+            ip += 6;                                            \
+        } else {                                                \
+            FUSION_COUNT(K, 16);                                \
+            NEXT;                                               \
+        }                                                       \
+        FUSION_COUNT(K, tmp8u&15);                              \
+        if(FusedCond(emu, tmp8u&15))                            \
+            ip += tmp32s;                                       \
+    }                                                           \
+    NEXT
 
 #include "modrm.h"
 
@@ -235,28 +264,28 @@ _trace:
             nextop = F8;
             GET_EB;
             cmp8(emu, EB->byte[0], GB);
-            NEXT;
+            FUSE(FUSE_CMP8);
         _0x39:
             nextop = F8;
             GET_ED;
             cmp32(emu, ED->dword[0], GD.dword[0]);
-            NEXT;
+            FUSE(FUSE_CMP32);
         _0x3A:
             nextop = F8;
             GET_EB;
             cmp8(emu, GB, EB->byte[0]);
-            NEXT;
+            FUSE(FUSE_CMP8);
         _0x3B:
             nextop = F8;
             GET_ED;
             cmp32(emu, GD.dword[0], ED->dword[0]);
-            NEXT;
+            FUSE(FUSE_CMP32);
         _0x3C:
             cmp8(emu, R_AL, F8);
-            NEXT;
+            FUSE(FUSE_CMP8);
         _0x3D:
             cmp32(emu, R_EAX, F32);
-            NEXT;
+            FUSE(FUSE_CMP32);
 
         _0x06:                      /* PUSH ES */
             Push(emu, emu->segs[_ES]);    // even if a segment is a 16bits, a 32bits push/pop is done
@@ -335,7 +364,7 @@ _trace:
         _0x4F:                      /* DEC Reg */
             tmp8u = opcode&7;
             emu->regs[tmp8u].dword[0] = dec32(emu, emu->regs[tmp8u].dword[0]);
-            NEXT;
+            FUSE(FUSE_DEC);
         _0x54:                      /* PUSH ESP */
             tmp32u = R_ESP;
             Push(emu, tmp32u);
@@ -391,6 +420,7 @@ _trace:
             nextop = F8;
             GET_EW;
             // faking to always happy...
+            CHECK_FLAGS(emu);
             SET_FLAG(F_ZF);
             NEXT;
         _0x64:                      /* FS: */
@@ -469,86 +499,86 @@ _trace:
         #define GOCOND(BASE, PREFIX, CONDITIONAL) \
         _##BASE##_0:                            \
             PREFIX                              \
-            if(ACCESS_FLAG(F_OF))               \
+            if(LAZY_FLAG(F_OF))               \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_1:                            \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_OF))              \
+            if(!LAZY_FLAG(F_OF))              \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_2:                            \
             PREFIX                              \
-            if(ACCESS_FLAG(F_CF))               \
+            if(LAZY_FLAG(F_CF))               \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_3:                            \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_CF))              \
+            if(!LAZY_FLAG(F_CF))              \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_4:                            \
             PREFIX                              \
-            if(ACCESS_FLAG(F_ZF))               \
+            if(LAZY_FLAG(F_ZF))               \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_5:                            \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_ZF))              \
+            if(!LAZY_FLAG(F_ZF))              \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_6:                            \
             PREFIX                              \
-            if((ACCESS_FLAG(F_ZF) || ACCESS_FLAG(F_CF)))  \
+            if((LAZY_FLAG(F_ZF) || LAZY_FLAG(F_CF)))  \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_7:                            \
             PREFIX                              \
-            if(!(ACCESS_FLAG(F_ZF) || ACCESS_FLAG(F_CF))) \
+            if(!(LAZY_FLAG(F_ZF) || LAZY_FLAG(F_CF))) \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_8:                            \
             PREFIX                              \
-            if(ACCESS_FLAG(F_SF))               \
+            if(LAZY_FLAG(F_SF))               \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_9:                            \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_SF))              \
+            if(!LAZY_FLAG(F_SF))              \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_A:                            \
             PREFIX                              \
-            if(ACCESS_FLAG(F_PF))               \
+            if(LAZY_FLAG(F_PF))               \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_B:                            \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_PF))              \
+            if(!LAZY_FLAG(F_PF))              \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_C:                            \
             PREFIX                              \
-            if(ACCESS_FLAG(F_SF) != ACCESS_FLAG(F_OF))  \
+            if(LAZY_FLAG(F_SF) != LAZY_FLAG(F_OF))  \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_D:                            \
             PREFIX                              \
-            if(ACCESS_FLAG(F_SF) == ACCESS_FLAG(F_OF)) \
+            if(LAZY_FLAG(F_SF) == LAZY_FLAG(F_OF)) \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_E:                            \
             PREFIX                              \
-            if(ACCESS_FLAG(F_ZF) || (ACCESS_FLAG(F_SF) != ACCESS_FLAG(F_OF))) \
+            if(LAZY_FLAG(F_ZF) || (LAZY_FLAG(F_SF) != LAZY_FLAG(F_OF))) \
                 CONDITIONAL                     \
             NEXT;                              \
         _##BASE##_F:                            \
             PREFIX                              \
-            if(!ACCESS_FLAG(F_ZF) && (ACCESS_FLAG(F_SF) == ACCESS_FLAG(F_OF))) \
+            if(!LAZY_FLAG(F_ZF) && (LAZY_FLAG(F_SF) == LAZY_FLAG(F_OF))) \
                 CONDITIONAL                     \
             NEXT;
         GOCOND(0x70
-            ,   tmp8s = F8S; CHECK_FLAGS(emu);
+            ,   tmp8s = F8S;
             ,   ip += tmp8s;
             )                           /* Jxx Ib */
         #undef GOCOND
@@ -567,7 +597,7 @@ _trace:
                 case 4: EB->byte[0] = and8(emu, EB->byte[0], tmp8u); break;
                 case 5: EB->byte[0] = sub8(emu, EB->byte[0], tmp8u); break;
                 case 6: EB->byte[0] = xor8(emu, EB->byte[0], tmp8u); break;
-                case 7:               cmp8(emu, EB->byte[0], tmp8u); break;
+                case 7:               cmp8(emu, EB->byte[0], tmp8u); FUSE(FUSE_CMP8);
             }
             NEXT;
         _0x81:                      /* GRP Ed,Id */
@@ -589,19 +619,19 @@ _trace:
                 case 4: ED->dword[0] = and32(emu, ED->dword[0], tmp32u); break;
                 case 5: ED->dword[0] = sub32(emu, ED->dword[0], tmp32u); break;
                 case 6: ED->dword[0] = xor32(emu, ED->dword[0], tmp32u); break;
-                case 7:                cmp32(emu, ED->dword[0], tmp32u); break;
+                case 7:                cmp32(emu, ED->dword[0], tmp32u); FUSE(FUSE_CMP32);
             }
             NEXT;
         _0x84:                      /* TEST Eb,Gb */
             nextop = F8;
             GET_EB;
             test8(emu, EB->byte[0], GB);
-            NEXT;
+            FUSE(FUSE_TEST8);
         _0x85:                      /* TEST Ed,Gd */
             nextop = F8;
             GET_ED;
             test32(emu, ED->dword[0], GD.dword[0]);
-            NEXT;
+            FUSE(FUSE_TEST32);
         _0x86:                      /* XCHG Eb,Gb */
             nextop = F8;
 #ifdef DYNAREC
@@ -619,13 +649,15 @@ _trace:
             // dynarec use need it's own mecanism
 #else
             GET_EB;
-            if((nextop&0xC0)!=0xC0)
-                pthread_mutex_lock(&emu->context->mutex_lock); // XCHG always LOCK (but when accessing memory only)
-            tmp8u = GB;
-            GB = EB->byte[0];
-            EB->byte[0] = tmp8u;
-            if((nextop&0xC0)!=0xC0)
-                pthread_mutex_unlock(&emu->context->mutex_lock);
+            if((nextop&0xC0)==0xC0) {
+                tmp8u = GB;
+                GB = EB->byte[0];
+                EB->byte[0] = tmp8u;
+            } else {
+                // XCHG always LOCK (but when accessing memory only)
+                LOCK_XCHG(emu, EB, uint8_t, tmp8u, GB);
+                GB = tmp8u;
+            }
 #endif                
             NEXT;
         _0x87:                      /* XCHG Ed,Gd */
@@ -650,13 +682,15 @@ _trace:
             }
 #else
             GET_ED;
-            if((nextop&0xC0)!=0xC0)
-                pthread_mutex_lock(&emu->context->mutex_lock); // XCHG always LOCK (but when accessing memory only)
-            tmp32u = GD.dword[0];
-            GD.dword[0] = ED->dword[0];
-            ED->dword[0] = tmp32u;
-            if((nextop&0xC0)!=0xC0)
-                pthread_mutex_unlock(&emu->context->mutex_lock);
+            if((nextop&0xC0)==0xC0) {
+                tmp32u = GD.dword[0];
+                GD.dword[0] = ED->dword[0];
+                ED->dword[0] = tmp32u;
+            } else {
+                // XCHG always LOCK (but when accessing memory only)
+                LOCK_XCHG(emu, ED, uint32_t, tmp32u, GD.dword[0]);
+                GD.dword[0] = tmp32u;
+            }
 #endif
             NEXT;
         _0x88:                      /* MOV Eb,Gb */
@@ -736,6 +770,7 @@ _trace:
             RESET_FLAGS(emu);
             NEXT;
         _0x9E:                      /* SAHF */
+            CHECK_FLAGS(emu);   // OF is not changed
             tmp8u = emu->regs[_AX].byte[1];
             CONDITIONAL_SET_FLAG(tmp8u&0x01, F_CF);
             CONDITIONAL_SET_FLAG(tmp8u&0x04, F_PF);
@@ -792,10 +827,10 @@ _trace:
             NEXT;
         _0xA8:                      /* TEST AL, Ib */
             test8(emu, R_AL, F8);
-            NEXT;
+            FUSE(FUSE_TEST8);
         _0xA9:                      /* TEST EAX, Id */
             test32(emu, R_EAX, F32);
-            NEXT;
+            FUSE(FUSE_TEST32);
         _0xAA:                      /* STOSB */
             tmp8s = ACCESS_FLAG(F_DF)?-1:+1;
             *(uint8_t*)R_EDI = R_AL;
@@ -1049,17 +1084,15 @@ _trace:
             NEXT;
 
         _0xE0:                      /* LOOPNZ */
-            CHECK_FLAGS(emu);
             tmp8s = F8S;
             --R_ECX; // don't update flags
-            if(R_ECX && !ACCESS_FLAG(F_ZF))
+            if(R_ECX && !LAZY_FLAG(F_ZF))
                 ip += tmp8s;
             NEXT;
         _0xE1:                      /* LOOPZ */
-            CHECK_FLAGS(emu);
             tmp8s = F8S;
             --R_ECX; // don't update flags
-            if(R_ECX && ACCESS_FLAG(F_ZF))
+            if(R_ECX && LAZY_FLAG(F_ZF))
                 ip += tmp8s;
             NEXT;
         _0xE2:                      /* LOOP */
@@ -1429,7 +1462,7 @@ _trace:
                 case 0: 
                 case 1:                 /* TEST Eb,Ib */
                     test8(emu, EB->byte[0], F8);
-                    break;
+                    FUSE(FUSE_TEST8);
                 case 2:                 /* NOT Eb */
                     EB->byte[0] = not8(emu, EB->byte[0]);
                     break;
@@ -1457,7 +1490,7 @@ _trace:
                 case 0: 
                 case 1:                 /* TEST Ed,Id */
                     test32(emu, ED->dword[0], F32);
-                    break;
+                    FUSE(FUSE_TEST32);
                 case 2:                 /* NOT Ed */
                     ED->dword[0] = not32(emu, ED->dword[0]);
                     break;
@@ -164,9 +164,13 @@ void RunLock(x86emu_t *emu)
     uint8_t opcode = F8;
     uint8_t nextop;
     reg32_t *oped;
-    uint8_t tmp8u;
+    uint8_t tmp8u, tmp8u2;
 #ifdef DYNAREC
-    uint8_t tmp8u2;
+    lock_flags_t lock_flags;
+#else
+    int emu_locked = 0;
+    uint32_t tmp32u3;
+    uint64_t tmp64u, tmp64u2, tmp64u3;
 #endif
     uint32_t tmp32u, tmp32u2;
     int32_t tmp32s;
@@ -176,7 +180,9 @@ void RunLock(x86emu_t *emu)
         case B+0: \
             nextop = F8;               \
             GET_EB;             \
+            LOCK_FLAGS_SAVE(emu, lock_flags);   \
             do {                \
+            LOCK_FLAGS_RESTORE(emu, lock_flags);\
             tmp8u = arm_lock_read_b(EB);     \
             tmp8u = OP##8(emu, tmp8u, GB);  \
             } while (arm_lock_write_b(EB, tmp8u));   \
@@ -184,7 +190,9 @@ void RunLock(x86emu_t *emu)
         case B+1: \
             nextop = F8;               \
             GET_ED;             \
+            LOCK_FLAGS_SAVE(emu, lock_flags);   \
             do {                \
+            LOCK_FLAGS_RESTORE(emu, lock_flags);\
             tmp32u = arm_lock_read_d(ED);     \
             tmp32u = OP##32(emu, tmp32u, GD.dword[0]);  \
             } while (arm_lock_write_d(ED, tmp32u));   \
@@ -210,40 +218,28 @@ void RunLock(x86emu_t *emu)
         case B+0: \
             nextop = F8;               \
             GET_EB;             \
-            pthread_mutex_lock(&emu->context->mutex_lock);\
-            EB->byte[0] = OP##8(emu, EB->byte[0], GB);  \
-            pthread_mutex_unlock(&emu->context->mutex_lock);\
+            LOCK_RMW(emu, EB, uint8_t, tmp8u, tmp8u2, tmp8u2 = OP##8(emu, tmp8u, GB));  \
             break;                              \
         case B+1: \
             nextop = F8;               \
             GET_ED;             \
-            pthread_mutex_lock(&emu->context->mutex_lock);\
-            ED->dword[0] = OP##32(emu, ED->dword[0], GD.dword[0]); \
-            pthread_mutex_unlock(&emu->context->mutex_lock);\
+            LOCK_RMW(emu, ED, uint32_t, tmp32u, tmp32u2, tmp32u2 = OP##32(emu, tmp32u, GD.dword[0])); \
             break;                              \
         case B+2: \
             nextop = F8;               \
             GET_EB;                   \
-            pthread_mutex_lock(&emu->context->mutex_lock);\
             GB = OP##8(emu, GB, EB->byte[0]); \
-            pthread_mutex_unlock(&emu->context->mutex_lock);\
             break;                              \
         case B+3: \
             nextop = F8;               \
             GET_ED;         \
-            pthread_mutex_lock(&emu->context->mutex_lock);\
             GD.dword[0] = OP##32(emu, GD.dword[0], ED->dword[0]); \
-            pthread_mutex_unlock(&emu->context->mutex_lock);\
             break;                              \
         case B+4: \
-            pthread_mutex_lock(&emu->context->mutex_lock);\
             R_AL = OP##8(emu, R_AL, F8); \
-            pthread_mutex_unlock(&emu->context->mutex_lock);\
             break;                              \
         case B+5: \
-            pthread_mutex_lock(&emu->context->mutex_lock);\
             R_EAX = OP##32(emu, R_EAX, F32); \
-            pthread_mutex_unlock(&emu->context->mutex_lock);\
             break;
 #endif
         GO(0x00, add)                   /* ADD 0x00 -> 0x05 */
@@ -266,7 +262,7 @@ void RunLock(x86emu_t *emu)
                     do {
                         tmp8u = arm_lock_read_b(EB);
                         cmp8(emu, R_AL, tmp8u);
-                        if(ACCESS_FLAG(F_ZF)) {
+                        if(LAZY_FLAG(F_ZF)) {
                             tmp32s = arm_lock_write_b(EB, GB);
                         } else {
                             R_AL = tmp8u;
@@ -274,14 +270,9 @@ void RunLock(x86emu_t *emu)
                         }
                     } while(tmp32s);
 #else
-                    pthread_mutex_lock(&emu->context->mutex_lock);
-                    cmp8(emu, R_AL, EB->byte[0]);
-                    if(ACCESS_FLAG(F_ZF)) {
-                        EB->byte[0] = GB;
-                    } else {
-                        R_AL = EB->byte[0];
-                    }
-                    pthread_mutex_unlock(&emu->context->mutex_lock);
+                    LOCK_RMW(emu, EB, uint8_t, tmp8u, tmp8u2, cmp8(emu, R_AL, tmp8u); tmp8u2 = LAZY_FLAG(F_ZF)?GB:tmp8u);
+                    if(!LAZY_FLAG(F_ZF))
+                        R_AL = tmp8u;
 #endif
                     break;
                 case 0xB1:                      /* CMPXCHG Ed,Gd */
@@ -291,7 +282,7 @@ void RunLock(x86emu_t *emu)
                     do {
                         tmp32u = arm_lock_read_d(ED);
                         cmp32(emu, R_EAX, tmp32u);
-                        if(ACCESS_FLAG(F_ZF)) {
+                        if(LAZY_FLAG(F_ZF)) {
                             tmp32s = arm_lock_write_d(ED, GD.dword[0]);
                         } else {
                             R_EAX = tmp32u;
@@ -299,14 +290,9 @@ void RunLock(x86emu_t *emu)
                         }
                     } while(tmp32s);
 #else
-                    pthread_mutex_lock(&emu->context->mutex_lock);
-                    cmp32(emu, R_EAX, ED->dword[0]);
-                    if(ACCESS_FLAG(F_ZF)) {
-                        ED->dword[0] = GD.dword[0];
-                    } else {
-                        R_EAX = ED->dword[0];
-                    }
-                    pthread_mutex_unlock(&emu->context->mutex_lock);
+                    LOCK_RMW(emu, ED, uint32_t, tmp32u, tmp32u2, cmp32(emu, R_EAX, tmp32u); tmp32u2 = LAZY_FLAG(F_ZF)?GD.dword[0]:tmp32u);
+                    if(!LAZY_FLAG(F_ZF))
+                        R_EAX = tmp32u;
 #endif
                     break;
                 case 0xB3:                      /* BTR Ed,Gd */
@@ -332,13 +318,11 @@ void RunLock(x86emu_t *emu)
                         }
                     } while(tmp32s);
 #else
-                    pthread_mutex_lock(&emu->context->mutex_lock);
-                    if(ED->dword[0] & (1<<tmp8u)) {
+                    LOCK_RMW(emu, ED, uint32_t, tmp32u, tmp32u2, tmp32u2 = tmp32u&~(1<<tmp8u));
+                    if(tmp32u & (1<<tmp8u))
                         SET_FLAG(F_CF);
-                        ED->dword[0] ^= (1<<tmp8u);
-                    } else
+                    else
                         CLEAR_FLAG(F_CF);
-                    pthread_mutex_unlock(&emu->context->mutex_lock);
 #endif
                     break;
                 case 0xBA:                      
@@ -359,12 +343,12 @@ void RunLock(x86emu_t *emu)
                             else
                                 CLEAR_FLAG(F_CF);
 #else
-                            pthread_mutex_lock(&emu->context->mutex_lock);
+                            LOCK_EMU(emu, ED, 4);
                             if(ED->dword[0] & (1<<tmp8u))
                                 SET_FLAG(F_CF);
                             else
                                 CLEAR_FLAG(F_CF);
-                            pthread_mutex_unlock(&emu->context->mutex_lock);
+                            UNLOCK_EMU(emu, ED, 4);
 #endif
                             break;
                         case 6:             /* BTR Ed, Ib */
@@ -389,13 +373,11 @@ void RunLock(x86emu_t *emu)
                                 }
                             } while(tmp32s);
 #else
-                            pthread_mutex_lock(&emu->context->mutex_lock);
-                            if(ED->dword[0] & (1<<tmp8u)) {
+                            LOCK_RMW(emu, ED, uint32_t, tmp32u, tmp32u2, tmp32u2 = tmp32u&~(1<<tmp8u));
+                            if(tmp32u & (1<<tmp8u))
                                 SET_FLAG(F_CF);
-                                ED->dword[0] ^= (1<<tmp8u);
-                            } else
+                            else
                                 CLEAR_FLAG(F_CF);
-                            pthread_mutex_unlock(&emu->context->mutex_lock);
 #endif
                             break;
 
@@ -425,13 +407,11 @@ void RunLock(x86emu_t *emu)
                         tmp32u ^= (1<<tmp8u);
                     } while(arm_lock_write_d(ED, tmp32u));
 #else
-                    pthread_mutex_lock(&emu->context->mutex_lock);
-                    if(ED->dword[0] & (1<<tmp8u))
+                    LOCK_RMW(emu, ED, uint32_t, tmp32u, tmp32u2, tmp32u2 = tmp32u^(1<<tmp8u));
+                    if(tmp32u & (1<<tmp8u))
                         SET_FLAG(F_CF);
                     else
                         CLEAR_FLAG(F_CF);
-                    ED->dword[0] ^= (1<<tmp8u);
-                    pthread_mutex_unlock(&emu->context->mutex_lock);
 #endif
                     break;
                 case 0xC0:                      /* XADD Gb,Eb */
@@ -444,11 +424,8 @@ void RunLock(x86emu_t *emu)
                     } while (arm_lock_write_b(EB, tmp8u2));
                     GB = tmp8u;
 #else
-                    pthread_mutex_lock(&emu->context->mutex_lock);
-                    tmp8u = add8(emu, EB->byte[0], GB);
-                    GB = EB->byte[0];
-                    EB->byte[0] = tmp8u;
-                    pthread_mutex_unlock(&emu->context->mutex_lock);
+                    LOCK_RMW(emu, EB, uint8_t, tmp8u, tmp8u2, tmp8u2 = add8(emu, tmp8u, GB));
+                    GB = tmp8u;
 #endif
                     break;
                 case 0xC1:                      /* XADD Gd,Ed */
@@ -461,11 +438,8 @@ void RunLock(x86emu_t *emu)
                     } while(arm_lock_write_d(ED, tmp32u2));
                     GD.dword[0] = tmp32u;
 #else
-                    pthread_mutex_lock(&emu->context->mutex_lock);
-                    tmp32u = add32(emu, ED->dword[0], GD.dword[0]);
-                    GD.dword[0] = ED->dword[0];
-                    ED->dword[0] = tmp32u;
-                    pthread_mutex_unlock(&emu->context->mutex_lock);
+                    LOCK_RMW(emu, ED, uint32_t, tmp32u, tmp32u2, tmp32u2 = add32(emu, tmp32u, GD.dword[0]));
+                    GD.dword[0] = tmp32u;
 #endif
                     break;
                 case 0xC7:                      /* CMPXCHG8B Gq */
@@ -512,19 +486,15 @@ void RunLock(x86emu_t *emu)
                         }
                     } while(tmp32s);
 #else
-                    pthread_mutex_lock(&emu->context->mutex_lock);
-                    tmp32u = ED->dword[0];
-                    tmp32u2= ED->dword[1];
-                    if(R_EAX == tmp32u && R_EDX == tmp32u2) {
+                    tmp64u3 = ((uint64_t)R_EDX)<<32 | R_EAX;
+                    LOCK_RMW(emu, ED, uint64_t, tmp64u, tmp64u2, tmp64u2 = (tmp64u==tmp64u3)?(((uint64_t)R_ECX)<<32 | R_EBX):tmp64u);
+                    if(tmp64u == tmp64u3) {
                         SET_FLAG(F_ZF);
-                        ED->dword[0] = R_EBX;
-                        ED->dword[1] = R_ECX;
                     } else {
                         CLEAR_FLAG(F_ZF);
-                        R_EAX = tmp32u;
-                        R_EDX = tmp32u2;
+                        R_EAX = tmp64u&0xffffffff;
+                        R_EDX = tmp64u>>32;
                     }
-                    pthread_mutex_unlock(&emu->context->mutex_lock);
 #endif
                     break;
                 default:
@@ -547,26 +517,24 @@ void RunLock(x86emu_t *emu)
             switch((nextop>>3)&7) {
                 case 0: do { tmp32u2 = arm_lock_read_d(ED);} while(arm_lock_write_d(ED, add32(emu, tmp32u2, tmp32u))); break;
                 case 1: do { tmp32u2 = arm_lock_read_d(ED);} while(arm_lock_write_d(ED,  or32(emu, tmp32u2, tmp32u))); break;
-                case 2: do { tmp32u2 = arm_lock_read_d(ED);} while(arm_lock_write_d(ED, adc32(emu, tmp32u2, tmp32u))); break;
-                case 3: do { tmp32u2 = arm_lock_read_d(ED);} while(arm_lock_write_d(ED, sbb32(emu, tmp32u2, tmp32u))); break;
+                case 2: LOCK_FLAGS_SAVE(emu, lock_flags); do { LOCK_FLAGS_RESTORE(emu, lock_flags); tmp32u2 = arm_lock_read_d(ED);} while(arm_lock_write_d(ED, adc32(emu, tmp32u2, tmp32u))); break;
+                case 3: LOCK_FLAGS_SAVE(emu, lock_flags); do { LOCK_FLAGS_RESTORE(emu, lock_flags); tmp32u2 = arm_lock_read_d(ED);} while(arm_lock_write_d(ED, sbb32(emu, tmp32u2, tmp32u))); break;
                 case 4: do { tmp32u2 = arm_lock_read_d(ED);} while(arm_lock_write_d(ED, and32(emu, tmp32u2, tmp32u))); break;
                 case 5: do { tmp32u2 = arm_lock_read_d(ED);} while(arm_lock_write_d(ED, sub32(emu, tmp32u2, tmp32u))); break;
                 case 6: do { tmp32u2 = arm_lock_read_d(ED);} while(arm_lock_write_d(ED, xor32(emu, tmp32u2, tmp32u))); break;
                 case 7:                cmp32(emu, ED->dword[0], tmp32u); break;
             }
 #else
-            pthread_mutex_lock(&emu->context->mutex_lock);
             switch((nextop>>3)&7) {
-                case 0: ED->dword[0] = add32(emu, ED->dword[0], tmp32u); break;
-                case 1: ED->dword[0] =  or32(emu, ED->dword[0], tmp32u); break;
-                case 2: ED->dword[0] = adc32(emu, ED->dword[0], tmp32u); break;
-                case 3: ED->dword[0] = sbb32(emu, ED->dword[0], tmp32u); break;
-                case 4: ED->dword[0] = and32(emu, ED->dword[0], tmp32u); break;
-                case 5: ED->dword[0] = sub32(emu, ED->dword[0], tmp32u); break;
-                case 6: ED->dword[0] = xor32(emu, ED->dword[0], tmp32u); break;
+                case 0: LOCK_RMW(emu, ED, uint32_t, tmp32u2, tmp32u3, tmp32u3 = add32(emu, tmp32u2, tmp32u)); break;
+                case 1: LOCK_RMW(emu, ED, uint32_t, tmp32u2, tmp32u3, tmp32u3 =  or32(emu, tmp32u2, tmp32u)); break;
+                case 2: LOCK_RMW(emu, ED, uint32_t, tmp32u2, tmp32u3, tmp32u3 = adc32(emu, tmp32u2, tmp32u)); break;
+                case 3: LOCK_RMW(emu, ED, uint32_t, tmp32u2, tmp32u3, tmp32u3 = sbb32(emu, tmp32u2, tmp32u)); break;
+                case 4: LOCK_RMW(emu, ED, uint32_t, tmp32u2, tmp32u3, tmp32u3 = and32(emu, tmp32u2, tmp32u)); break;
+                case 5: LOCK_RMW(emu, ED, uint32_t, tmp32u2, tmp32u3, tmp32u3 = sub32(emu, tmp32u2, tmp32u)); break;
+                case 6: LOCK_RMW(emu, ED, uint32_t, tmp32u2, tmp32u3, tmp32u3 = xor32(emu, tmp32u2, tmp32u)); break;
                 case 7:                cmp32(emu, ED->dword[0], tmp32u); break;
             }
-            pthread_mutex_unlock(&emu->context->mutex_lock);
 #endif
             break;
         case 0x86:                      /* XCHG Eb,Gb */
@@ -593,9 +561,7 @@ void RunLock(x86emu_t *emu)
                         tmp32u = arm_lock_read_d(ED);
                     } while(arm_lock_write_d(ED, inc32(emu, tmp32u)));
 #else
-                    pthread_mutex_lock(&emu->context->mutex_lock);
-                    ED->dword[0] = inc32(emu, ED->dword[0]);
-                    pthread_mutex_unlock(&emu->context->mutex_lock);
+                    LOCK_RMW(emu, ED, uint32_t, tmp32u, tmp32u2, tmp32u2 = inc32(emu, tmp32u));
 #endif
                     break;
                 case 1:                 /* DEC Ed */
@@ -604,9 +570,7 @@ void RunLock(x86emu_t *emu)
                         tmp32u = arm_lock_read_d(ED);
                     } while(arm_lock_write_d(ED, dec32(emu, tmp32u)));
 #else
-                    pthread_mutex_lock(&emu->context->mutex_lock);
-                    ED->dword[0] = dec32(emu, ED->dword[0]);
-                    pthread_mutex_unlock(&emu->context->mutex_lock);
+                    LOCK_RMW(emu, ED, uint32_t, tmp32u, tmp32u2, tmp32u2 = dec32(emu, tmp32u));
 #endif
                     break;
                 default:
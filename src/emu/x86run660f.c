@@ -11,6 +11,7 @@
 #include "x86emu_private.h"
 #include "x86run_private.h"
 #include "x86primop.h"
+#include "x86simd.h"
 #include "x86trace.h"
 #include "box86context.h"
 
@@ -88,88 +89,87 @@ void Run660F(x86emu_t *emu)
     #define GOCOND(BASE, PREFIX, CONDITIONAL) \
     _6f_##BASE##_0:                          \
         PREFIX                              \
-        if(ACCESS_FLAG(F_OF))               \
+        if(LAZY_FLAG(F_OF))               \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_1:                          \
         PREFIX                              \
-        if(!ACCESS_FLAG(F_OF))              \
+        if(!LAZY_FLAG(F_OF))              \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_2:                          \
         PREFIX                              \
-        if(ACCESS_FLAG(F_CF))               \
+        if(LAZY_FLAG(F_CF))               \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_3:                          \
         PREFIX                              \
-        if(!ACCESS_FLAG(F_CF))              \
+        if(!LAZY_FLAG(F_CF))              \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_4:                          \
         PREFIX                              \
-        if(ACCESS_FLAG(F_ZF))               \
+        if(LAZY_FLAG(F_ZF))               \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_5:                          \
         PREFIX                              \
-        if(!ACCESS_FLAG(F_ZF))              \
+        if(!LAZY_FLAG(F_ZF))              \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_6:                          \
         PREFIX                              \
-        if((ACCESS_FLAG(F_ZF) || ACCESS_FLAG(F_CF)))  \
+        if((LAZY_FLAG(F_ZF) || LAZY_FLAG(F_CF)))  \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_7:                          \
         PREFIX                              \
-        if(!(ACCESS_FLAG(F_ZF) || ACCESS_FLAG(F_CF))) \
+        if(!(LAZY_FLAG(F_ZF) || LAZY_FLAG(F_CF))) \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_8:                          \
         PREFIX                              \
-        if(ACCESS_FLAG(F_SF))               \
+        if(LAZY_FLAG(F_SF))               \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_9:                          \
         PREFIX                              \
-        if(!ACCESS_FLAG(F_SF))              \
+        if(!LAZY_FLAG(F_SF))              \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_A:                          \
         PREFIX                              \
-        if(ACCESS_FLAG(F_PF))               \
+        if(LAZY_FLAG(F_PF))               \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_B:                          \
         PREFIX                              \
-        if(!ACCESS_FLAG(F_PF))              \
+        if(!LAZY_FLAG(F_PF))              \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_C:                          \
         PREFIX                              \
-        if(ACCESS_FLAG(F_SF) != ACCESS_FLAG(F_OF))  \
+        if(LAZY_FLAG(F_SF) != LAZY_FLAG(F_OF))  \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_D:                          \
         PREFIX                              \
-        if(ACCESS_FLAG(F_SF) == ACCESS_FLAG(F_OF)) \
+        if(LAZY_FLAG(F_SF) == LAZY_FLAG(F_OF)) \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_E:                          \
         PREFIX                              \
-        if(ACCESS_FLAG(F_ZF) || (ACCESS_FLAG(F_SF) != ACCESS_FLAG(F_OF))) \
+        if(LAZY_FLAG(F_ZF) || (LAZY_FLAG(F_SF) != LAZY_FLAG(F_OF))) \
             CONDITIONAL                     \
         NEXT;                              \
     _6f_##BASE##_F:                          \
         PREFIX                              \
-        if(!ACCESS_FLAG(F_ZF) && (ACCESS_FLAG(F_SF) == ACCESS_FLAG(F_OF))) \
+        if(!LAZY_FLAG(F_ZF) && (LAZY_FLAG(F_SF) == LAZY_FLAG(F_OF))) \
             CONDITIONAL                     \
         NEXT;
 
     GOCOND(0x40
         , nextop = F8;
-        CHECK_FLAGS(emu);
         GET_EW;
         , GW.word[0] = EW->word[0];
     )                               /* 0x40 -> 0x4F CMOVxx Gw,Ew */ // conditional move, no sign
@@ -294,13 +294,7 @@ void Run660F(x86emu_t *emu)
             case 0x00:  /* PSHUFB */
                 nextop = F8;
                 GET_EX;
-                eax1 = GX;
-                for (int i=0; i<16; ++i) {
-                    if(EX->ub[i]&128)
-                        GX.ub[i] = 0;
-                    else
-                        GX.ub[i] = eax1.ub[EX->ub[i]&15];
-                }
+                VX(GX, ub) = vx_pshufb(VX(GX, ub), VX(*EX, ub));
                 break;
             case 0x01:  /* PHADDW Gx, Ex */
                 nextop = F8;
@@ -479,38 +473,32 @@ void Run660F(x86emu_t *emu)
     _6f_0x54:                      /* ANDPD Gx, Ex */
         nextop = F8;
         GET_EX;
-        GX.q[0] &= EX->q[0];
-        GX.q[1] &= EX->q[1];
+        VX(GX, q) &= VX(*EX, q);
         NEXT;
     _6f_0x55:                      /* ANDNPD Gx, Ex */
         nextop = F8;
         GET_EX;
-        GX.q[0] = (~GX.q[0]) & EX->q[0];
-        GX.q[1] = (~GX.q[1]) & EX->q[1];
+        VX(GX, q) = ~VX(GX, q) & VX(*EX, q);
         NEXT;
     _6f_0x56:                      /* ORPD Gx, Ex */
         nextop = F8;
         GET_EX;
-        GX.q[0] |= EX->q[0];
-        GX.q[1] |= EX->q[1];
+        VX(GX, q) |= VX(*EX, q);
         NEXT;
     _6f_0x57:                      /* XORPD Gx, Ex */
         nextop = F8;
         GET_EX;
-        GX.q[0] ^= EX->q[0];
-        GX.q[1] ^= EX->q[1];
+        VX(GX, q) ^= VX(*EX, q);
         NEXT;
     _6f_0x58:                      /* ADDPD Gx, Ex */
         nextop = F8;
         GET_EX;
-        GX.d[0] += EX->d[0];
-        GX.d[1] += EX->d[1];
+        VX(GX, d) += VX(*EX, d);
         NEXT;
     _6f_0x59:                      /* MULPD Gx, Ex */
         nextop = F8;
         GET_EX;
-        GX.d[0] *= EX->d[0];
-        GX.d[1] *= EX->d[1];
+        VX(GX, d) *= VX(*EX, d);
         NEXT;
     _6f_0x5A:                      /* CVTPD2PS Gx, Ex */
         nextop = F8;
@@ -530,149 +518,86 @@ void Run660F(x86emu_t *emu)
     _6f_0x5C:                      /* SUBPD Gx, Ex */
         nextop = F8;
         GET_EX;
-        GX.d[0] -= EX->d[0];
-        GX.d[1] -= EX->d[1];
+        VX(GX, d) -= VX(*EX, d);
         NEXT;
     _6f_0x5D:                      /* MINPD Gx, Ex */
         nextop = F8;
         GET_EX;
-        if (isnan(GX.d[0]) || isnan(EX->d[0]) || isless(EX->d[0], GX.d[0]))
-            GX.d[0] = EX->d[0];
-        if (isnan(GX.d[1]) || isnan(EX->d[1]) || isless(EX->d[1], GX.d[1]))
-            GX.d[1] = EX->d[1];
+        VX(GX, d) = vx_d_min(VX(GX, d), VX(*EX, d));
         NEXT;
     _6f_0x5E:                      /* DIVPD Gx, Ex */
         nextop = F8;
         GET_EX;
-        GX.d[0] /= EX->d[0];
-        GX.d[1] /= EX->d[1];
+        VX(GX, d) /= VX(*EX, d);
         NEXT;
     _6f_0x5F:                      /* MAXPD Gx, Ex */
         nextop = F8;
         GET_EX;
-        if (isnan(GX.d[0]) || isnan(EX->d[0]) || isgreater(EX->d[0], GX.d[0]))
-            GX.d[0] = EX->d[0];
-        if (isnan(GX.d[1]) || isnan(EX->d[1]) || isgreater(EX->d[1], GX.d[1]))
-            GX.d[1] = EX->d[1];
+        VX(GX, d) = vx_d_max(VX(GX, d), VX(*EX, d));
         NEXT;
 
     _6f_0x60:  /* PUNPCKLBW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=7; i>0; --i)  // 0 is untouched
-            GX.ub[2 * i] = GX.ub[i];
-        if(&GX==EX)
-            for(int i=0; i<8; ++i)
-                GX.ub[2 * i + 1] = GX.ub[2 * i];
-        else 
-            for(int i=0; i<8; ++i)
-                GX.ub[2 * i + 1] = EX->ub[i];
+        VX(GX, ub) = __builtin_shuffle(VX(GX, ub), VX(*EX, ub), (vx_ub){0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23});
         NEXT;
     _6f_0x61:  /* PUNPCKLWD Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=3; i>0; --i)
-            GX.uw[2 * i] = GX.uw[i];
-        if(&GX==EX)
-            for(int i=0; i<4; ++i)
-                GX.uw[2 * i + 1] = GX.uw[2 * i];
-        else
-            for(int i=0; i<4; ++i)
-                GX.uw[2 * i + 1] = EX->uw[i];
+        VX(GX, uw) = __builtin_shuffle(VX(GX, uw), VX(*EX, uw), (vx_uw){0, 8, 1, 9, 2, 10, 3, 11});
         NEXT;
     _6f_0x62:  /* PUNPCKLDQ Gx,Ex */
         nextop = F8;
         GET_EX;
-        GX.ud[3] = EX->ud[1];
-        GX.ud[2] = GX.ud[1];
-        GX.ud[1] = EX->ud[0];
+        VX(GX, ud) = __builtin_shuffle(VX(GX, ud), VX(*EX, ud), (vx_ud){0, 4, 1, 5});
         NEXT;
     _6f_0x63:  /* PACKSSWB Gx,Ex */
         nextop = F8;
         GET_EX;
-        if(&GX==EX) {
-            for(int i=0; i<8; ++i)
-                GX.sb[i] = (EX->sw[i]<-128)?-128:((EX->sw[i]>127)?127:EX->sw[i]);
-            GX.q[1] = GX.q[0];
-        } else {
-            for(int i=0; i<8; ++i)
-                GX.sb[i] = (GX.sw[i]<-128)?-128:((GX.sw[i]>127)?127:GX.sw[i]);
-            for(int i=0; i<8; ++i)
-                GX.sb[8+i] = (EX->sw[i]<-128)?-128:((EX->sw[i]>127)?127:EX->sw[i]);
-        }
+        VX(GX, ub) = __builtin_shuffle((vx_ub)vx_sw_clamp(VX(GX, sw), -128, 127), (vx_ub)vx_sw_clamp(VX(*EX, sw), -128, 127),
+                (vx_ub){0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30});
         NEXT;
     _6f_0x64:  /* PCMPGTB Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<16; ++i)
-            GX.ub[i] = (GX.sb[i]>EX->sb[i])?0xFF:0x00;
+        VX(GX, ub) = (vx_ub)(VX(GX, sb) > VX(*EX, sb));
         NEXT;
     _6f_0x65:  /* PCMPGTW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i)
-            GX.uw[i] = (GX.sw[i]>EX->sw[i])?0xFFFF:0x0000;
+        VX(GX, uw) = (vx_uw)(VX(GX, sw) > VX(*EX, sw));
         NEXT;
     _6f_0x66:  /* PCMPGTD Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<4; ++i)
-            GX.ud[i] = (GX.sd[i]>EX->sd[i])?0xFFFFFFFF:0x00000000;
+        VX(GX, ud) = (vx_ud)(VX(GX, sd) > VX(*EX, sd));
         NEXT;
     _6f_0x67:  /* PACKUSWB Gx,Ex */
         nextop = F8;
         GET_EX;
-        if(&GX==EX) {
-            for(int i=0; i<8; ++i)
-                GX.ub[i] = (EX->sw[i]<0)?0:((EX->sw[i]>0xff)?0xff:EX->sw[i]);
-            GX.q[1] = GX.q[0];
-        } else {
-            for(int i=0; i<8; ++i)
-                GX.ub[i] = (GX.sw[i]<0)?0:((GX.sw[i]>0xff)?0xff:GX.sw[i]);
-            for(int i=0; i<8; ++i)
-                GX.ub[8+i] = (EX->sw[i]<0)?0:((EX->sw[i]>0xff)?0xff:EX->sw[i]);
-        }
+        VX(GX, ub) = __builtin_shuffle((vx_ub)vx_sw_clamp(VX(GX, sw), 0, 255), (vx_ub)vx_sw_clamp(VX(*EX, sw), 0, 255),
+                (vx_ub){0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30});
         NEXT;
     _6f_0x68:  /* PUNPCKHBW Gx,Ex */
         nextop = F8;
         GET_EX;
-        if(EX==&GX) {eax1 = GX; EX = &eax1;}   // copy is needed
-        for(int i=0; i<8; ++i)
-            GX.ub[2 * i] = GX.ub[i + 8];
-        for(int i=0; i<8; ++i)
-            GX.ub[2 * i + 1] = EX->ub[i + 8];
+        VX(GX, ub) = __builtin_shuffle(VX(GX, ub), VX(*EX, ub), (vx_ub){8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31});
         NEXT;
     _6f_0x69:  /* PUNPCKHWD Gx,Ex */
         nextop = F8;
         GET_EX;
-        if(EX==&GX) {eax1 = GX; EX = &eax1;}   // copy is needed
-        for(int i=0; i<4; ++i)
-            GX.uw[2 * i] = GX.uw[i + 4];
-        for(int i=0; i<4; ++i)
-            GX.uw[2 * i + 1] = EX->uw[i + 4];
+        VX(GX, uw) = __builtin_shuffle(VX(GX, uw), VX(*EX, uw), (vx_uw){4, 12, 5, 13, 6, 14, 7, 15});
         NEXT;
     _6f_0x6A:  /* PUNPCKHDQ Gx,Ex */
         nextop = F8;
         GET_EX;
-        // no copy needed if &GX==EX
-        GX.ud[0] = GX.ud[2];
-        GX.ud[1] = EX->ud[2];
-        GX.ud[2] = GX.ud[3];
-        GX.ud[3] = EX->ud[3];
+        VX(GX, ud) = __builtin_shuffle(VX(GX, ud), VX(*EX, ud), (vx_ud){2, 6, 3, 7});
         NEXT;
     _6f_0x6B:  /* PACKSSDW Gx,Ex */
         nextop = F8;
         GET_EX;
-        if(&GX==EX) {
-            for(int i=0; i<4; ++i)
-                GX.sw[i] = (EX->sd[i]<-32768)?-32768:((EX->sd[i]>32767)?32767:EX->sd[i]);
-            GX.q[1] = GX.q[0];
-        } else {
-            for(int i=0; i<4; ++i)
-                GX.sw[i] = (GX.sd[i]<-32768)?-32768:((GX.sd[i]>32767)?32767:GX.sd[i]);
-            for(int i=0; i<4; ++i)
-                GX.sw[4+i] = (EX->sd[i]<-32768)?-32768:((EX->sd[i]>32767)?32767:EX->sd[i]);
-        }
+        VX(GX, uw) = __builtin_shuffle((vx_uw)vx_sd_clamp(VX(GX, sd), -32768, 32767), (vx_uw)vx_sd_clamp(VX(*EX, sd), -32768, 32767),
+                (vx_uw){0, 2, 4, 6, 8, 10, 12, 14});
         NEXT;
     _6f_0x6C:  /* PUNPCKLQDQ Gx,Ex */
         nextop = F8;
@@ -701,9 +626,7 @@ void Run660F(x86emu_t *emu)
         nextop = F8;
         GET_EX;
         tmp8u = F8;
-        if(EX==&GX) {eax1 = GX; EX = &eax1;}   // copy is needed
-        for (int i=0; i<4; ++i)
-            GX.ud[i] = EX->ud[(tmp8u>>(i*2))&3];
+        VX(GX, ud) = __builtin_shuffle(VX(*EX, ud), (vx_ud){tmp8u&3, (tmp8u>>2)&3, (tmp8u>>4)&3, tmp8u>>6});
         NEXT;
     _6f_0x71:  /* GRP */
         nextop = F8;
@@ -714,18 +637,18 @@ void Run660F(x86emu_t *emu)
                 if(tmp8u>15)
                     {EX->q[0] = EX->q[1] = 0;}
                 else
-                    for (int i=0; i<8; ++i) EX->uw[i] >>= tmp8u;
+                    VX(*EX, uw) >>= tmp8u;
                 break;
             case 4:                 /* PSRAW Ex, Ib */
                 tmp8u = F8;
-                for (int i=0; i<8; ++i) EX->sw[i] >>= tmp8u;
+                VX(*EX, sw) >>= (tmp8u>15)?15:tmp8u;
                 break;
             case 6:                 /* PSLLW Ex, Ib */
                 tmp8u = F8;
                 if(tmp8u>15)
                     {EX->q[0] = EX->q[1] = 0;}
                 else
-                    for (int i=0; i<8; ++i) EX->uw[i] <<= tmp8u;
+                    VX(*EX, uw) <<= tmp8u;
                 break;
             default:
                 goto _default;
@@ -740,18 +663,18 @@ void Run660F(x86emu_t *emu)
                 if(tmp8u>31)
                     {EX->q[0] = EX->q[1] = 0;}
                 else
-                    for (int i=0; i<4; ++i) EX->ud[i] >>= tmp8u;
+                    VX(*EX, ud) >>= tmp8u;
                 break;
             case 4:                 /* PSRAD Ex, Ib */
                 tmp8u = F8;
-                for (int i=0; i<4; ++i) EX->sd[i] >>= tmp8u;
+                VX(*EX, sd) >>= (tmp8u>31)?31:tmp8u;
                 break;
             case 6:                 /* PSLLD Ex, Ib */
                 tmp8u = F8;
                 if(tmp8u>31)
                     {EX->q[0] = EX->q[1] = 0;}
                 else
-                    for (int i=0; i<4; ++i) EX->ud[i] <<= tmp8u;
+                    VX(*EX, ud) <<= tmp8u;
                 break;
             default:
                 goto _default;
@@ -766,7 +689,7 @@ void Run660F(x86emu_t *emu)
                 if(tmp8u>63)
                     {EX->q[0] = EX->q[1] = 0;}
                 else
-                    {EX->q[0] >>= tmp8u; EX->q[1] >>= tmp8u;}
+                    {VX(*EX, q) >>= tmp8u;}
                 break;
             case 3:                 /* PSRLDQ Ex, Ib */
                 tmp8u = F8;
@@ -788,7 +711,7 @@ void Run660F(x86emu_t *emu)
                 if(tmp8u>63)
                     {EX->q[0] = EX->q[1] = 0;}
                 else
-                    {EX->q[0] <<= tmp8u; EX->q[1] <<= tmp8u;}
+                    {VX(*EX, q) <<= tmp8u;}
                 break;
             case 7:                 /* PSLLDQ Ex, Ib */
                 tmp8u = F8;
@@ -812,20 +735,17 @@ void Run660F(x86emu_t *emu)
     _6f_0x74:  /* PCMPEQB Gx,Ex */
         nextop = F8;
         GET_EX;
-        for (int i=0; i<16; ++i)
-            GX.ub[i] = (GX.ub[i]==EX->ub[i])?0xff:0;
+        VX(GX, ub) = (vx_ub)(VX(GX, ub) == VX(*EX, ub));
         NEXT;
     _6f_0x75:  /* PCMPEQW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for (int i=0; i<8; ++i)
-            GX.uw[i] = (GX.uw[i]==EX->uw[i])?0xffff:0;
+        VX(GX, uw) = (vx_uw)(VX(GX, uw) == VX(*EX, uw));
         NEXT;
     _6f_0x76:  /* PCMPEQD Gx,Ex */
         nextop = F8;
         GET_EX;
-        for (int i=0; i<4; ++i)
-            GX.ud[i] = (GX.ud[i]==EX->ud[i])?0xffffffff:0;
+        VX(GX, ud) = (vx_ud)(VX(GX, ud) == VX(*EX, ud));
         NEXT;
 
     _6f_0x7C:  /* HADDPD Gx, Ex */
@@ -1109,38 +1029,34 @@ void Run660F(x86emu_t *emu)
         GET_EX;
         if(EX->q[0]>15)
             {GX.q[0] = GX.q[1] = 0;}
-        else 
-            {tmp8u=EX->ub[0]; for (int i=0; i<8; ++i) GX.uw[i] >>= tmp8u;}
+        else
+            VX(GX, uw) >>= EX->ub[0];
         NEXT;
     _6f_0xD2:  /* PSRLD Gx, Ex */
         nextop = F8;
         GET_EX;
         if(EX->q[0]>31)
             {GX.q[0] = GX.q[1] = 0;}
-        else 
-            {tmp8u=EX->ub[0]; for (int i=0; i<4; ++i) GX.ud[i] >>= tmp8u;}
+        else
+            VX(GX, ud) >>= EX->ub[0];
         NEXT;
     _6f_0xD3:  /* PSRLQ Gx, Ex */
         nextop = F8;
         GET_EX;
         if(EX->q[0]>63)
             {GX.q[0] = GX.q[1] = 0;}
-        else 
-            {tmp8u=EX->ub[0]; for (int i=0; i<2; ++i) GX.q[i] >>= tmp8u;}
+        else
+            VX(GX, q) >>= EX->ub[0];
         NEXT;
     _6f_0xD4:  /* PADDQ Gx,Ex */
         nextop = F8;
         GET_EX;
-        GX.sq[0] += EX->sq[0];
-        GX.sq[1] += EX->sq[1];
+        VX(GX, q) += VX(*EX, q);
         NEXT;
     _6f_0xD5:  /* PMULLW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i) {
-            tmp32s = (int32_t)GX.sw[i] * EX->sw[i];
-            GX.sw[i] = tmp32s&0xffff;
-        }
+        VX(GX, uw) *= VX(*EX, uw);
         NEXT;
     _6f_0xD6:  /* MOVQ Ex,Gx */
         nextop = F8;
@@ -1163,100 +1079,72 @@ void Run660F(x86emu_t *emu)
     _6f_0xD8:  /* PSUBUSB Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<16; ++i) {
-            tmp16s = (int16_t)GX.ub[i] - EX->ub[i];
-            GX.ub[i] = (tmp16s<0)?0:tmp16s;
-        }
+        VX(GX, ub) = vx_ub_subus(VX(GX, ub), VX(*EX, ub));
         NEXT;
     _6f_0xD9:  /* PSUBUSW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i) {
-            tmp32s = (int32_t)GX.uw[i] - EX->uw[i];
-            GX.uw[i] = (tmp32s<0)?0:tmp32s;
-        }
+        VX(GX, uw) = vx_uw_subus(VX(GX, uw), VX(*EX, uw));
         NEXT;
     _6f_0xDA:  /* PMINUB Gx, Ex */
         nextop = F8;
         GET_EX;
-        for (int i=0; i<16; ++i)
-            if(EX->ub[i]<GX.ub[i]) GX.ub[i] = EX->ub[i];
+        VX(GX, ub) = vx_ub_min(VX(GX, ub), VX(*EX, ub));
         NEXT;
     _6f_0xDB:  /* PAND Gx,Ex */
         nextop = F8;
         GET_EX;
-        GX.q[0] &= EX->q[0];
-        GX.q[1] &= EX->q[1];
+        VX(GX, q) &= VX(*EX, q);
         NEXT;
     _6f_0xDC:  /* PADDUSB Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<16; ++i) {
-            tmp16s = (int16_t)GX.ub[i] + EX->ub[i];
-            GX.ub[i] = (tmp16s>255)?255:tmp16s;
-        }
+        VX(GX, ub) = vx_ub_addus(VX(GX, ub), VX(*EX, ub));
         NEXT;
     _6f_0xDD:  /* PADDUSW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i) {
-            tmp32s = (int32_t)GX.uw[i] + EX->uw[i];
-            GX.uw[i] = (tmp32s>65535)?65535:tmp32s;
-        }
+        VX(GX, uw) = vx_uw_addus(VX(GX, uw), VX(*EX, uw));
         NEXT;
     _6f_0xDE:  /* PMAXUB Gx, Ex */
         nextop = F8;
         GET_EX;
-        for (int i=0; i<16; ++i)
-            if(EX->ub[i]>GX.ub[i]) GX.ub[i] = EX->ub[i];
+        VX(GX, ub) = vx_ub_max(VX(GX, ub), VX(*EX, ub));
         NEXT;
     _6f_0xDF:  /* PANDN Gx,Ex */
         nextop = F8;
         GET_EX;
-        GX.q[0] = (~(GX.q[0])) & EX->q[0];
-        GX.q[1] = (~(GX.q[1])) & EX->q[1];
+        VX(GX, q) = ~VX(GX, q) & VX(*EX, q);
         NEXT;
     _6f_0xE0:  /* PAVGB Gx, Ex */
         nextop = F8;
         GET_EX;
-        for (int i=0; i<16; ++i)
-            GX.ub[i] = ((uint16_t)GX.ub[i] + EX->ub[i] + 1)>>1;
+        VX(GX, ub) = vx_ub_avg(VX(GX, ub), VX(*EX, ub));
         NEXT;
     _6f_0xE1:  /* PSRAW Gx, Ex */
         nextop = F8;
         GET_EX;
-        tmp8u=(EX->q[0]>15)?16:EX->ub[0];
-        for (int i=0; i<8; ++i) 
-            GX.sw[i] >>= tmp8u;
+        VX(GX, sw) >>= (EX->q[0]>15)?15:EX->ub[0];
         NEXT;
     _6f_0xE2:  /* PSRAD Gx, Ex */
         nextop = F8;
         GET_EX;
-        tmp8u=(EX->q[0]>31)?32:EX->ub[0];
-        for (int i=0; i<4; ++i)
-            GX.sd[i] >>= tmp8u;
+        VX(GX, sd) >>= (EX->q[0]>31)?31:EX->ub[0];
         NEXT;
     _6f_0xE3:  /* PAVGW Gx, Ex */
         nextop = F8;
         GET_EX;
-        for (int i=0; i<8; ++i)
-            GX.uw[i] = ((uint32_t)GX.uw[i] + EX->uw[i] + 1)>>1;
+        VX(GX, uw) = vx_uw_avg(VX(GX, uw), VX(*EX, uw));
         NEXT;
     _6f_0xE4:  /* PMULHUW Gx, Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i) {
-            tmp32u = (uint32_t)GX.uw[i] * EX->uw[i];
-            GX.uw[i] = (tmp32u>>16)&0xffff;
-        }
+        VX(GX, uw) = vx_mulhu(VX(GX, uw), VX(*EX, uw));
         NEXT;
     _6f_0xE5:  /* PMULHW Gx, Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i) {
-            tmp32s = (int32_t)GX.sw[i] * EX->sw[i];
-            GX.uw[i] = (tmp32s>>16)&0xffff;
-        }
+        VX(GX, sw) = vx_mulhs(VX(GX, sw), VX(*EX, sw));
         NEXT;
     _6f_0xE6:  /* CVTTPD2DQ Gx, Ex */
         nextop = F8;
@@ -1274,62 +1162,42 @@ void Run660F(x86emu_t *emu)
     _6f_0xE8:  /* PSUBSB Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<16; ++i) {
-            tmp16s = (int16_t)GX.sb[i] - EX->sb[i];
-            GX.sb[i] = (tmp16s<-128)?-128:((tmp16s>127)?127:tmp16s);
-        }
+        VX(GX, sb) = vx_sb_subs(VX(GX, sb), VX(*EX, sb));
         NEXT;
     _6f_0xE9:  /* PSUBSW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i) {
-            tmp32s = (int32_t)GX.sw[i] - EX->sw[i];
-            GX.sw[i] = (tmp32s>32767)?32767:((tmp32s<-32768)?-32768:tmp32s);
-        }
+        VX(GX, sw) = vx_sw_subs(VX(GX, sw), VX(*EX, sw));
         NEXT;
     _6f_0xEA:  /* PMINSW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for (int i=0; i<8; ++i)
-            GX.sw[i] = (GX.sw[i]<EX->sw[i])?GX.sw[i]:EX->sw[i];
+        VX(GX, sw) = vx_sw_min(VX(GX, sw), VX(*EX, sw));
         NEXT;
     _6f_0xEB:  /* POR Gx,Ex */
         nextop = F8;
         GET_EX;
-        GX.ud[0] |= EX->ud[0];
-        GX.ud[1] |= EX->ud[1];
-        GX.ud[2] |= EX->ud[2];
-        GX.ud[3] |= EX->ud[3];
+        VX(GX, q) |= VX(*EX, q);
         NEXT;
     _6f_0xEC:  /* PADDSB Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<16; ++i) {
-            tmp16s = (int16_t)GX.sb[i] + EX->sb[i];
-            GX.sb[i] = (tmp16s>127)?127:((tmp16s<-128)?-128:tmp16s);
-        }
+        VX(GX, sb) = vx_sb_adds(VX(GX, sb), VX(*EX, sb));
         NEXT;
     _6f_0xED:  /* PADDSW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i) {
-            tmp32s = (int32_t)GX.sw[i] + EX->sw[i];
-            GX.sw[i] = (tmp32s>32767)?32767:((tmp32s<-32768)?-32768:tmp32s);
-        }
+        VX(GX, sw) = vx_sw_adds(VX(GX, sw), VX(*EX, sw));
         NEXT;
     _6f_0xEE:  /* PMAXSW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i)
-            GX.sw[i] = (GX.sw[i]>EX->sw[i])?GX.sw[i]:EX->sw[i];
+        VX(GX, sw) = vx_sw_max(VX(GX, sw), VX(*EX, sw));
         NEXT;
     _6f_0xEF:  /* PXOR Gx,Ex */
         nextop = F8;
         GET_EX;
-        GX.ud[0] ^= EX->ud[0];
-        GX.ud[1] ^= EX->ud[1];
-        GX.ud[2] ^= EX->ud[2];
-        GX.ud[3] ^= EX->ud[3];
+        VX(GX, q) ^= VX(*EX, q);
         NEXT;
 
     _6f_0xF1:  /* PSLLW Gx, Ex */
@@ -1337,24 +1205,24 @@ void Run660F(x86emu_t *emu)
         GET_EX;
         if(EX->q[0]>15)
             {GX.q[0] = GX.q[1] = 0;}
-        else 
-            {tmp8u=EX->ub[0]; for (int i=0; i<8; ++i) GX.uw[i] <<= tmp8u;}
+        else
+            VX(GX, uw) <<= EX->ub[0];
         NEXT;
     _6f_0xF2:  /* PSLLD Gx, Ex */
         nextop = F8;
         GET_EX;
         if(EX->q[0]>31)
             {GX.q[0] = GX.q[1] = 0;}
-        else 
-            {tmp8u=EX->ub[0]; for (int i=0; i<4; ++i) GX.ud[i] <<= tmp8u;}
+        else
+            VX(GX, ud) <<= EX->ub[0];
         NEXT;
     _6f_0xF3:  /* PSLLQ Gx, Ex */
         nextop = F8;
         GET_EX;
         if(EX->q[0]>63)
             {GX.q[0] = GX.q[1] = 0;}
-        else 
-            {tmp8u=EX->q[0]; for (int i=0; i<2; ++i) GX.q[i] <<= tmp8u;}
+        else
+            VX(GX, q) <<= EX->ub[0];
         NEXT;
     _6f_0xF4:  /* PMULUDQ Gx,Ex */
         nextop = F8;
@@ -1365,8 +1233,7 @@ void Run660F(x86emu_t *emu)
     _6f_0xF5:  /* PMADDWD Gx,Ex */
         nextop = F8;
         GET_EX;
-        for (int i=0; i<4; ++i)
-            GX.sd[i] = (int32_t)(GX.sw[i*2+0])*EX->sw[i*2+0] + (int32_t)(GX.sw[i*2+1])*EX->sw[i*2+1];
+        VX(GX, sd) = vx_madd(VX(GX, sw), VX(*EX, sw));
         NEXT;
     _6f_0xF6:  /* PSADBW Gx, Ex */
         nextop = F8;
@@ -1392,48 +1259,37 @@ void Run660F(x86emu_t *emu)
     _6f_0xF8:  /* PSUBB Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<16; ++i)
-            GX.sb[i] -= EX->sb[i];
+        VX(GX, ub) -= VX(*EX, ub);
         NEXT;
     _6f_0xF9:  /* PSUBW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i)
-            GX.sw[i] -= EX->sw[i];
+        VX(GX, uw) -= VX(*EX, uw);
         NEXT;
     _6f_0xFA:  /* PSUBD Gx,Ex */
         nextop = F8;
         GET_EX;
-        GX.sd[0] -= EX->sd[0];
-        GX.sd[1] -= EX->sd[1];
-        GX.sd[2] -= EX->sd[2];
-        GX.sd[3] -= EX->sd[3];
+        VX(GX, ud) -= VX(*EX, ud);
         NEXT;
     _6f_0xFB:  /* PSUBQ Gx,Ex */
         nextop = F8;
         GET_EX;
-        GX.sq[0] -= EX->sq[0];
-        GX.sq[1] -= EX->sq[1];
+        VX(GX, q) -= VX(*EX, q);
         NEXT;
     _6f_0xFC:  /* PADDB Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<16; ++i)
-            GX.sb[i] += EX->sb[i];
+        VX(GX, ub) += VX(*EX, ub);
         NEXT;
     _6f_0xFD:  /* PADDW Gx,Ex */
         nextop = F8;
         GET_EX;
-        for(int i=0; i<8; ++i)
-            GX.sw[i] += EX->sw[i];
+        VX(GX, uw) += VX(*EX, uw);
         NEXT;
     _6f_0xFE:  /* PADDD Gx,Ex */
         nextop = F8;
         GET_EX;
-        GX.sd[0] += EX->sd[0];
-        GX.sd[1] += EX->sd[1];
-        GX.sd[2] += EX->sd[2];
-        GX.sd[3] += EX->sd[3];
+        VX(GX, ud) += VX(*EX, ud);
         NEXT;
  
     _fini:
@@ -685,6 +685,132 @@ void UpdateFlags(x86emu_t *emu)
     RESET_FLAGS(emu);
 }
 
+uint32_t LazyFlag(x86emu_t *emu, int flag)
+{
+    uint32_t cc;
+    #define MSB8    0x80
+    #define MSB16   0x8000
+    #define MSB32   0x80000000
+    #define MASK8   0xff
+    #define MASK16  0xffff
+    #define MASK32  0xffffffff
+    #define OF8     6
+    #define OF16    14
+    #define OF32    30
+    // same formulas as UpdateFlags
+    #define GOADD(S, CARRY)                                                             \
+        case d_add##S:                                                                  \
+            switch(flag) {                                                              \
+                case F_CF: return CARRY;                                                \
+                case F_ZF: return (emu->res & MASK##S) == 0;                            \
+                case F_SF: return (emu->res & MSB##S)?1:0;                              \
+                case F_PF: return PARITY(emu->res & 0xff);                              \
+                case F_OF: cc = (emu->op1 & emu->op2) | ((~emu->res) & (emu->op1 | emu->op2)); \
+                           return XOR2(cc >> OF##S);                                    \
+            }                                                                           \
+            break;
+    #define GOSUB(S, D)                                                                 \
+        case D##S:                                                                      \
+            switch(flag) {                                                              \
+                case F_CF: cc = (emu->res & (~emu->op1 | emu->op2)) | (~emu->op1 & emu->op2); \
+                           return (cc & MSB##S)?1:0;                                    \
+                case F_ZF: return (emu->res & MASK##S) == 0;                            \
+                case F_SF: return (emu->res & MSB##S)?1:0;                              \
+                case F_PF: return PARITY(emu->res & 0xff);                              \
+                case F_OF: cc = (emu->res & (~emu->op1 | emu->op2)) | (~emu->op1 & emu->op2); \
+                           return XOR2(cc >> OF##S);                                    \
+            }                                                                           \
+            break;
+    #define GOLOGIC(S, D)                                                               \
+        case D##S:                                                                      \
+            switch(flag) {                                                              \
+                case F_CF: return 0;                                                    \
+                case F_OF: return 0;                                                    \
+                case F_ZF: return emu->res == 0;                                        \
+                case F_SF: return (emu->res & MSB##S)?1:0;                              \
+                case F_PF: return PARITY(emu->res & 0xff);                              \
+            }                                                                           \
+            break;
+    #define GOINCDEC(S, D, CHAIN)                                                       \
+        case D##S:                                                                      \
+            switch(flag) {                                                              \
+                case F_CF: return ACCESS_FLAG(F_CF);                                    \
+                case F_ZF: return (emu->res & MASK##S) == 0;                            \
+                case F_SF: return (emu->res & MSB##S)?1:0;                              \
+                case F_PF: return PARITY(emu->res & 0xff);                              \
+                case F_OF: cc = CHAIN; return XOR2(cc >> OF##S);                        \
+            }                                                                           \
+            break;
+    switch(emu->df) {
+        GOADD(8, (emu->res & 0x100)?1:0)
+        GOADD(16, (emu->res & 0x10000)?1:0)
+        GOADD(32, emu->res < emu->op1)
+        GOSUB(8, d_sub)
+        GOSUB(16, d_sub)
+        GOSUB(32, d_sub)
+        GOSUB(8, d_cmp)
+        GOSUB(16, d_cmp)
+        GOSUB(32, d_cmp)
+        GOLOGIC(8, d_and)
+        GOLOGIC(16, d_and)
+        GOLOGIC(32, d_and)
+        GOLOGIC(8, d_or)
+        GOLOGIC(16, d_or)
+        GOLOGIC(32, d_or)
+        GOLOGIC(8, d_xor)
+        GOLOGIC(16, d_xor)
+        GOLOGIC(32, d_xor)
+        GOLOGIC(8, d_tst)
+        GOLOGIC(16, d_tst)
+        GOLOGIC(32, d_tst)
+        GOINCDEC(8, d_inc, (1 & emu->op1) | ((~emu->res) & (1 | emu->op1)))
+        GOINCDEC(16, d_inc, (1 & emu->op1) | ((~emu->res) & (1 | emu->op1)))
+        GOINCDEC(32, d_inc, (1 & emu->op1) | ((~emu->res) & (1 | emu->op1)))
+        GOINCDEC(8, d_dec, (emu->res & (~emu->op1 | 1)) | (~emu->op1 & 1))
+        GOINCDEC(16, d_dec, (emu->res & (~emu->op1 | 1)) | (~emu->op1 & 1))
+        GOINCDEC(32, d_dec, (emu->res & (~emu->op1 | 1)) | (~emu->op1 & 1))
+        default:
+            break;
+    }
+    #undef GOADD
+    #undef GOSUB
+    #undef GOLOGIC
+    #undef GOINCDEC
+    #undef MSB8
+    #undef MSB16
+    #undef MSB32
+    #undef MASK8
+    #undef MASK16
+    #undef MASK32
+    #undef OF8
+    #undef OF16
+    #undef OF32
+    // other operations or flags: all the flags are evaluated
+    UpdateFlags(emu);
+    return ACCESS_FLAG(flag);
+}
+
+uint64_t fusion_hits[FUSE_LAST][17] = {0};
+
+void PrintFusionStats()
+{
+    static const char* pairs[FUSE_LAST] = {"CMP Eb", "CMP Ed", "TEST Eb", "TEST Ed", "DEC Reg"};
+    static const char* conds[16] = {"O", "NO", "B", "AE", "Z", "NZ", "BE", "A", "S", "NS", "P", "NP", "L", "GE", "LE", "G"};
+    char buff[512];
+    for(int k=0; k<FUSE_LAST; ++k) {
+        uint64_t total = 0;
+        int l = 0;
+        buff[0] = '\0';
+        for(int i=0; i<16; ++i)
+            if(fusion_hits[k][i]) {
+                total += fusion_hits[k][i];
+                l += snprintf(buff+l, sizeof(buff)-l, " J%s:%llu", conds[i], (unsigned long long)fusion_hits[k][i]);
+            }
+        if(total || fusion_hits[k][16])
+            printf_log(LOG_NONE, "Fusion %s+Jcc: %llu fused, %llu not followed by a Jcc,%s\n", pairs[k],
+                (unsigned long long)total, (unsigned long long)fusion_hits[k][16], total?buff:" no Jcc");
+    }
+}
 
 void PackFlags(x86emu_t* emu)
 {
@@ -752,6 +878,33 @@ uintptr_t GetSegmentBaseEmu(x86emu_t* emu, int seg)
     return emu->segs_offs[seg];
 }
 
+#ifndef DYNAREC
+#define LOCK_STRIPE(p)  (((uintptr_t)(p)>>6)&(LOCK_STRIPES-1))
+// lock the cache line(s) of the size bytes at p (always in the same order), return 0 if nothing was needed
+int LockEmu(x86emu_t* emu, void* p, int size)
+{
+    if(emu->context->singlethread)
+        return 0;
+    int s1 = LOCK_STRIPE(p);
+    int s2 = LOCK_STRIPE((uintptr_t)p+size-1);
+    if(s2<s1) {
+        int tmp = s1; s1 = s2; s2 = tmp;
+    }
+    pthread_mutex_lock(&emu->context->mutex_lock[s1]);
+    if(s2!=s1)
+        pthread_mutex_lock(&emu->context->mutex_lock[s2]);
+    return 1;
+}
+void UnlockEmu(x86emu_t* emu, void* p, int size)
+{
+    int s1 = LOCK_STRIPE(p);
+    int s2 = LOCK_STRIPE((uintptr_t)p+size-1);
+    if(s2!=s1)
+        pthread_mutex_unlock(&emu->context->mutex_lock[s2]);
+    pthread_mutex_unlock(&emu->context->mutex_lock[s1]);
+}
+#endif
+
 
 const char* getAddrFunctionName(uintptr_t addr)
 {
@@ -193,6 +193,131 @@ void UpdateFlags(x86emu_t *emu);
 
 #define CHECK_FLAGS(emu) if(emu->df) UpdateFlags(emu)
 #define RESET_FLAGS(emu) emu->df = d_none
+// a single flag, the defered flags are only evaluated for it (and stay defered) for the common operations
+uint32_t LazyFlag(x86emu_t *emu, int flag);
+#define LAZY_FLAG(F)    (emu->df?LazyFlag(emu, F):ACCESS_FLAG(F))
+// for the operations that don't change CF, so it's not lost when their own defered flags replace the pending ones
+#define KEEP_CF(emu)    if(emu->df) emu->flags[F_CF] = LazyFlag(emu, F_CF)
+// condition cc (low nibble of the Jcc opcode) from the flags, the same tests as the Jcc handlers
+static inline int FlagsCond(x86emu_t *emu, int cc)
+{
+    int r;
+    switch(cc>>1) {
+        case 0: r = LAZY_FLAG(F_OF); break;
+        case 1: r = LAZY_FLAG(F_CF); break;
+        case 2: r = LAZY_FLAG(F_ZF); break;
+        case 3: r = LAZY_FLAG(F_ZF) || LAZY_FLAG(F_CF); break;
+        case 4: r = LAZY_FLAG(F_SF); break;
+        case 5: r = LAZY_FLAG(F_PF); break;
+        case 6: r = LAZY_FLAG(F_SF) != LAZY_FLAG(F_OF); break;
+        default: r = LAZY_FLAG(F_ZF) || (LAZY_FLAG(F_SF) != LAZY_FLAG(F_OF)); break;
+    }
+    return r ^ (cc&1);
+}
+// same, but straight from the operands of a defered CMP/TEST/DEC (the ones fused with a Jcc, BOX86_FUSION)
+static inline int FusedCond(x86emu_t *emu, int cc)
+{
+    int r;
+    uint32_t msb = (emu->df==d_cmp8 || emu->df==d_tst8)?0x80:0x80000000;
+    switch(emu->df) {
+        case d_cmp8:
+        case d_cmp32:
+            switch(cc>>1) {
+                case 1: r = emu->op1 < emu->op2; break;
+                case 2: r = emu->op1 == emu->op2; break;
+                case 3: r = emu->op1 <= emu->op2; break;
+                case 4: r = (emu->res & msb)?1:0; break;
+                case 6: r = (emu->op1^msb) < (emu->op2^msb); break;
+                case 7: r = (emu->op1^msb) <= (emu->op2^msb); break;
+                default: return FlagsCond(emu, cc);
+            }
+            break;
+        case d_tst8:
+        case d_tst32:
+            switch(cc>>1) {
+                case 0:
+                case 1: r = 0; break;
+                case 2:
+                case 3: r = emu->res == 0; break;
+                case 4:
+                case 6: r = (emu->res & msb)?1:0; break;
+                case 7: r = (emu->res == 0) || (emu->res & msb); break;
+                default: return FlagsCond(emu, cc);
+            }
+            break;
+        case d_dec32:
+            switch(cc>>1) {
+                case 2: r = emu->res == 0; break;
+                case 4: r = emu->res >> 31; break;
+                default: return FlagsCond(emu, cc);
+            }
+            break;
+        default:
+            return FlagsCond(emu, cc);
+    }
+    return r ^ (cc&1);
+}
+enum {
+    FUSE_CMP8,
+    FUSE_CMP32,
+    FUSE_TEST8,
+    FUSE_TEST32,
+    FUSE_DEC,
+    FUSE_LAST
+};
+// hits of each fused pair, by condition, [16] counts the CMP/TEST/DEC not followed by a Jcc (BOX86_FUSION=2)
+extern uint64_t fusion_hits[FUSE_LAST][17];
+#define FUSION_COUNT(K, I)  if(box86_fusion>1) __sync_fetch_and_add(&fusion_hits[K][I], 1)
+// flags state a retried LOCK'd operation starts again from: ADC/SBB read the CF that the failed try has set
+typedef struct lock_flags_s {
+    defered_flags_t df;
+    uint32_t        op1, op2, res;
+    int             cf;
+} lock_flags_t;
+#define LOCK_FLAGS_SAVE(emu, S)     do { (S).df = (emu)->df; (S).op1 = (emu)->op1; (S).op2 = (emu)->op2; (S).res = (emu)->res; (S).cf = ACCESS_FLAG(F_CF); } while(0)
+#define LOCK_FLAGS_RESTORE(emu, S)  do { (emu)->df = (S).df; (emu)->op1 = (S).op1; (emu)->op2 = (S).op2; (emu)->res = (S).res; ACCESS_FLAG(F_CF) = (S).cf; } while(0)
+#ifndef DYNAREC
+// LOCK'd operations: a naturally aligned operand uses the host atomics, the other ones take the mutex of the cache line(s)
+// they are on. Nothing is needed while there is only one thread (BOX86_LOCKELISION). The caller needs an int emu_locked
+int LockEmu(x86emu_t* emu, void* p, int size);
+void UnlockEmu(x86emu_t* emu, void* p, int size);
+#define LOCK_EMU(emu, A, S)     emu_locked = LockEmu(emu, A, S)
+#define UNLOCK_EMU(emu, A, S)   if(emu_locked) UnlockEmu(emu, A, S)
+#define LOCK_ALIGNED(emu, A, T) (!((uintptr_t)(A)&(sizeof(T)-1)) && !(emu)->context->singlethread)
+// read-modify-write of the T at A: O is the value read, OP computes the new value N from it (and can be run more than once)
+#define LOCK_RMW(emu, A, T, O, N, OP)   \
+    do {                                \
+        if(LOCK_ALIGNED(emu, A, T)) {   \
+            lock_flags_t lock_flags;    \
+            int lock_try = 0;           \
+            LOCK_FLAGS_SAVE(emu, lock_flags); \
+            O = __atomic_load_n((T*)(A), __ATOMIC_RELAXED); \
+            do {                        \
+                if(lock_try++)          \
+                    LOCK_FLAGS_RESTORE(emu, lock_flags); \
+                OP;                     \
+            } while(!__atomic_compare_exchange_n((T*)(A), &O, N, 1, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)); \
+        } else {                        \
+            LOCK_EMU(emu, A, sizeof(T));\
+            O = *(T*)(A);               \
+            OP;                         \
+            *(T*)(A) = N;               \
+            UNLOCK_EMU(emu, A, sizeof(T)); \
+        }                               \
+    } while(0)
+// exchange of the T at A: O is the value read, N the one written
+#define LOCK_XCHG(emu, A, T, O, N)      \
+    do {                                \
+        if(LOCK_ALIGNED(emu, A, T)) {   \
+            O = __atomic_exchange_n((T*)(A), N, __ATOMIC_SEQ_CST); \
+        } else {                        \
+            LOCK_EMU(emu, A, sizeof(T));\
+            O = *(T*)(A);               \
+            *(T*)(A) = N;               \
+            UNLOCK_EMU(emu, A, sizeof(T)); \
+        }                               \
+    } while(0)
+#endif
 
 void Run67(x86emu_t *emu);
 void Run0F(x86emu_t *emu);
@@ -0,0 +1,123 @@
+#ifndef __X86SIMD_H_
+#define __X86SIMD_H_
+
+#include <stdint.h>
+
+// Packed MMX/SSE operations with GCC vector extensions, so the interpreter uses host SIMD (NEON on ARM, SSE on x86 hosts)
+// instead of a loop on the lanes. Only integer and exact float operations are here: the result is the same as a per-lane
+// computation, bit for bit (GCC only uses NEON for float vectors with -funsafe-math-optimizations, VFP is used otherwise).
+
+// vm_* are 64bits (MMX), vx_* are 128bits (SSE). The *_a types are the ones used to access the registers:
+// mmx_regs_t/sse_regs_t are packed, so not aligned, and are also accessed through the unions
+#define GO(N, T, S)                                                             \
+    typedef T N __attribute__((vector_size(S)));                                \
+    typedef T N##_a __attribute__((vector_size(S), aligned(1), may_alias));
+GO(vm_ub, uint8_t, 8)
+GO(vm_sb, int8_t, 8)
+GO(vm_uw, uint16_t, 8)
+GO(vm_sw, int16_t, 8)
+GO(vm_ud, uint32_t, 8)
+GO(vm_sd, int32_t, 8)
+GO(vx_ub, uint8_t, 16)
+GO(vx_sb, int8_t, 16)
+GO(vx_uw, uint16_t, 16)
+GO(vx_sw, int16_t, 16)
+GO(vx_ud, uint32_t, 16)
+GO(vx_sd, int32_t, 16)
+GO(vx_q, uint64_t, 16)
+GO(vx_sq, int64_t, 16)
+GO(vx_f, float, 16)
+GO(vx_d, double, 16)
+#undef GO
+
+// the lanes of a MMX / SSE register (an lvalue), T is the name of the union member (ub, sw, f...)
+#define VM(R, T)    (*(vm_##T##_a*)&(R))
+#define VX(R, T)    (*(vx_##T##_a*)&(R))
+
+// unsigned saturation and average
+#define GO(V)                                                                   \
+static inline V V##_addus(V a, V b) { V r = a + b; return r | (V)(r < a); }     \
+static inline V V##_subus(V a, V b) { return (a - b) & (V)(a >= b); }          \
+static inline V V##_avg(V a, V b) { return (a | b) - ((a ^ b) >> 1); }
+GO(vm_ub)
+GO(vm_uw)
+GO(vx_ub)
+GO(vx_uw)
+#undef GO
+
+// signed saturation (computed with wrapping unsigned lanes, then fixed where it overflowed)
+#define GO(V, U, B, MAX)                                                        \
+static inline V V##_adds(V a, V b)                                              \
+{                                                                               \
+    V r = (V)((U)a + (U)b);                                                     \
+    V m = ((a ^ r) & (b ^ r)) >> (B-1);                                         \
+    return (r & ~m) | (((a >> (B-1)) ^ MAX) & m);                               \
+}                                                                               \
+static inline V V##_subs(V a, V b)                                              \
+{                                                                               \
+    V r = (V)((U)a - (U)b);                                                     \
+    V m = ((a ^ b) & (a ^ r)) >> (B-1);                                         \
+    return (r & ~m) | (((a >> (B-1)) ^ MAX) & m);                               \
+}
+GO(vm_sb, vm_ub, 8, 0x7f)
+GO(vm_sw, vm_uw, 16, 0x7fff)
+GO(vx_sb, vx_ub, 8, 0x7f)
+GO(vx_sw, vx_uw, 16, 0x7fff)
+#undef GO
+
+// min / max / clamp, with a mask
+#define GO(V, T)                                                                \
+static inline V V##_min(V a, V b) { V m = (V)(a < b); return (a & m) | (b & ~m); } \
+static inline V V##_max(V a, V b) { V m = (V)(a > b); return (a & m) | (b & ~m); } \
+static inline V V##_clamp(V a, T lo, T hi)                                      \
+{                                                                               \
+    V m = (V)(a > hi);                                                          \
+    a = (a & ~m) | (hi & m);                                                    \
+    m = (V)(a < lo);                                                            \
+    return (a & ~m) | (lo & m);                                                 \
+}
+GO(vm_ub, uint8_t)
+GO(vm_sw, int16_t)
+GO(vm_sd, int32_t)
+GO(vx_ub, uint8_t)
+GO(vx_sw, int16_t)
+GO(vx_sd, int32_t)
+#undef GO
+
+// 16bits multiplications with a 32bits result: even and odd lanes are done separately in 32bits lanes
+#define GO(P)                                                                   \
+static inline P##_sw P##_mulhs(P##_sw a, P##_sw b)                              \
+{                                                                               \
+    P##_sd ae = (P##_sd)((P##_ud)a << 16) >> 16, ao = (P##_sd)a >> 16;          \
+    P##_sd be = (P##_sd)((P##_ud)b << 16) >> 16, bo = (P##_sd)b >> 16;          \
+    return (P##_sw)((((P##_ud)(ae * be)) >> 16) | ((P##_ud)(ao * bo) & 0xffff0000)); \
+}                                                                               \
+static inline P##_uw P##_mulhu(P##_uw a, P##_uw b)                              \
+{                                                                               \
+    P##_ud ae = (P##_ud)a & 0xffff, ao = (P##_ud)a >> 16;                       \
+    P##_ud be = (P##_ud)b & 0xffff, bo = (P##_ud)b >> 16;                       \
+    return (P##_uw)(((ae * be) >> 16) | ((ao * bo) & 0xffff0000));              \
+}                                                                               \
+static inline P##_sd P##_madd(P##_sw a, P##_sw b)                               \
+{                                                                               \
+    P##_sd ae = (P##_sd)((P##_ud)a << 16) >> 16, ao = (P##_sd)a >> 16;          \
+    P##_sd be = (P##_sd)((P##_ud)b << 16) >> 16, bo = (P##_sd)b >> 16;          \
+    return (P##_sd)((P##_ud)(ae * be) + (P##_ud)(ao * bo));                     \
+}
+GO(vm)
+GO(vx)
+#undef GO
+
+// x86 MINPS/MAXPS/MINPD/MAXPD: the 2nd operand if not (a < b) (or a > b), so also if one is a NaN
+static inline vx_f vx_f_min(vx_f a, vx_f b) { vx_sd m = a < b; return (vx_f)(((vx_sd)a & m) | ((vx_sd)b & ~m)); }
+static inline vx_f vx_f_max(vx_f a, vx_f b) { vx_sd m = a > b; return (vx_f)(((vx_sd)a & m) | ((vx_sd)b & ~m)); }
+static inline vx_d vx_d_min(vx_d a, vx_d b) { vx_sq m = a < b; return (vx_d)(((vx_sq)a & m) | ((vx_sq)b & ~m)); }
+static inline vx_d vx_d_max(vx_d a, vx_d b) { vx_sq m = a > b; return (vx_d)(((vx_sq)a & m) | ((vx_sq)b & ~m)); }
+
+// PSHUFB: the lane is 0 if bit 7 of the index is set
+static inline vx_ub vx_pshufb(vx_ub a, vx_ub idx)
+{
+    return __builtin_shuffle(a, idx & 15) & ~(vx_ub)((vx_sb)idx >> 7);
+}
+
+#endif //__X86SIMD_H_
@@ -36,6 +36,7 @@
 #include "callback.h"
 #include "signals.h"
 #include "x86tls.h"
+#include "threads.h"
 
 #ifndef __NR_socketcall
 #ifndef SYS_RECVMMSG
@@ -302,7 +303,7 @@ int clone_fn(void* arg)
 
 void EXPORT x86Syscall(x86emu_t *emu)
 {
-    RESET_FLAGS(emu);
+    CHECK_FLAGS(emu);
     uint32_t s = R_EAX;
     printf_log(LOG_DEBUG, "%p: Calling syscall 0x%02X (%d) %p %p %p %p %p", (void*)R_EIP, s, s, (void*)R_EBX, (void*)R_ECX, (void*)R_EDX, (void*)R_ESI, (void*)R_EDI); 
     // check wrapper first
@@ -488,6 +489,8 @@ void EXPORT x86Syscall(x86emu_t *emu)
                 }
                 SetESP(newemu, (uintptr_t)stack_base - size_to_copy);*/
                 void* mystack = (R_EBX&CLONE_VM)?malloc(1024*1024):NULL;  // stack for own process... memory leak, but no practical way to remove it
+                if(R_EBX&CLONE_VM)
+                    emuthread_add(emu); // a new thread, not a new process
                 int ret = clone(clone_fn, (void*)((R_EBX&CLONE_VM)?((uintptr_t)mystack+1024*1024):0), R_EBX, newemu, R_ESI, R_EDI, R_EBP);
                 //int r = syscall(__NR_clone, R_EBX, (R_EBX&CLONE_VM)?((uintptr_t)mystack):0, R_EDX, R_ESI, NULL);  // cannot use that syscall in C: how to setup the stack?!
                 R_EAX = ret;
@@ -25,17 +25,31 @@ typedef struct atfork_fnc_s {
 #ifdef DYNAREC
 typedef struct dynablocklist_s dynablocklist_t;
 typedef struct mmaplist_s      mmaplist_t;
+typedef struct nativeindex_s   nativeindex_t;
+typedef struct dynablock_s     dynablock_t;
 typedef struct dynmap_s {
     dynablocklist_t* dynablocks;    // the dynabockist of the block
+    uint32_t        dirtygen;       // SMC generation of the last time the page was unprotected
+    uint16_t        faults;         // write faults on the page
+    uint8_t         writable;       // page is not protected
+    uint8_t         hot;            // too many faults, page is not protected anymore (blocks are checked by hash)
 } dynmap_t;
-#define DYNAMAP_SIZE (1<<20)
+#define SMC_HOTPAGE 8   // number of write faults before a page is left unprotected
+#define SMC_LINE    64  // granularity of the hash of the blocks
 #define DYNAMAP_SHIFT 12
+// dynmap is in 2 levels: tables of DYNAMAP_L2SIZE entries (so 4M of memory each), allocated when needed
+#define DYNAMAP_L2SHIFT 10
+#define DYNAMAP_L2SIZE (1<<DYNAMAP_L2SHIFT)
+#define DYNAMAP_L1SIZE (1<<(32-DYNAMAP_SHIFT-DYNAMAP_L2SHIFT))
 #endif
 
 typedef void* (*procaddess_t)(const char* name);
 typedef void* (*vkprocaddess_t)(void* instance, const char* name);
 
 #define MAX_SIGNAL 64
+#ifndef DYNAREC
+#define LOCK_STRIPES 64 // mutexes of the LOCK'd operations
+#endif
 
 typedef struct tlsdatasize_s {
     int32_t     tlssize;
@@ -70,6 +84,7 @@ typedef struct box86context_s {
     int                 trace_tid;
 
     uint32_t            sel_serial;     // will be increment each time selectors changes
+    int                 singlethread;   // no second emulated thread started yet, so LOCK'd operations can be plain ones (BOX86_LOCKELISION)
 #ifdef DYNAREC
     int                 trace_dynarec;
     pthread_mutex_t     mutex_dyndump;
@@ -119,7 +134,7 @@ typedef struct box86context_s {
     pthread_mutex_t     mutex_once2;
     pthread_mutex_t     mutex_trace;
     #ifndef DYNAREC
-    pthread_mutex_t     mutex_lock;     // dynarec build will use their own mecanism
+    pthread_mutex_t     mutex_lock[LOCK_STRIPES];   // LOCK'd operations that can't use atomics, by cache line. dynarec build will use their own mecanism
     #endif
     pthread_mutex_t     mutex_tls;
     pthread_mutex_t     mutex_thread;
@@ -173,7 +188,8 @@ typedef struct box86context_s {
     pthread_mutex_t     mutex_mmap;
     mmaplist_t          *mmaplist;
     int                 mmapsize;
-    dynmap_t*           dynmap[DYNAMAP_SIZE];  // 4G of memory mapped by 4K block
+    nativeindex_t       *nativeindex;   // sorted index of mmaplist chunks, to find the dynablock of a native address
+    dynmap_t**          dynmap[DYNAMAP_L1SIZE]; // 4G of memory mapped by 4K block, use getDynmap to access
 #endif
 #ifndef NOALIGN
     kh_fts_t            *ftsmap;
@@ -215,12 +231,29 @@ int AddTLSPartition(box86context_t* context, int tlssize);
 // the nolinker specified if static map or dynamic (can be deleted) has to be used
 uintptr_t AllocDynarecMap(int size, int nolinker);
 void FreeDynarecMap(uintptr_t addr, uint32_t size);
-
+// mark the range of a map as owned by db (or NULL), and get back the dynablock owning a native address (signal safe)
+void setDynarecMapOwner(uintptr_t addr, uint32_t size, dynablock_t* db);
+dynablock_t* getDynarecMapOwner(uintptr_t addr);
+// print usage and fragmentation of the dynarec map
+void PrintDynarecMapStats();
+
+// get the dynmap of a 4K block index (addr>>DYNAMAP_SHIFT), no lock needed
+static inline dynmap_t* getDynmap(box86context_t* context, uintptr_t idx)
+{
+    dynmap_t** table = context->dynmap[idx>>DYNAMAP_L2SHIFT];
+    return table?table[idx&(DYNAMAP_L2SIZE-1)]:NULL;
+}
 void addDBFromAddressRange(box86context_t* context, uintptr_t addr, uintptr_t size, int nolinker);
 void cleanDBFromAddressRange(box86context_t* context, uintptr_t addr, uintptr_t size, int destroy);
 
-void protectDB(uintptr_t addr, uintptr_t size);
+// return 0 if some page of the range is left writable (hot page), so the blocks there need to be tested on each use
+int protectDB(uintptr_t addr, uintptr_t size);
 void unprotectDB(uintptr_t addr, uintptr_t size);
+// handle a write fault on protected code
+void faultDB(uintptr_t addr);
+// current SMC generation, and check if a page may have been written since generation gen
+uint32_t getDBGeneration();
+int isDBDirty(uintptr_t addr, uint32_t gen);
 #endif
 
 // defined in fact in threads.c
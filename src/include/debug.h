@@ -14,6 +14,20 @@ extern int box86_dynarec_trace;
 extern int box86_dynarec_forced;
 extern int box86_dynarec_largest;
 extern int box86_dynarec_smc;
+extern int box86_dynarec_diskcache;
+extern int box86_dynarec_diskcache_mb;
+extern char* box86_dynarec_diskcache_dir;
+extern int box86_dynarec_async;
+extern int box86_dynarec_hot;
+extern int box86_dynarec_stats;
+extern int box86_dynarec_cache_mb;
+extern int box86_dynarec_ibtc;
+extern int box86_dynarec_thunks;
+extern int box86_dynarec_inline;
+extern int box86_dynarec_patch;
+extern int box86_dynarec_onepass;
+extern int box86_perfmap;
+extern int box86_dynarec_gdbjit;
 #ifdef ARM
 extern int arm_vfp;     // vfp version (3 or 4), with 32 registers is mendatory
 extern int arm_swap;
@@ -27,6 +41,8 @@ extern int allow_missing_libs;
 extern int box86_steam;
 extern int box86_nopulse;   // diabling the use of wrapped pulseaudio
 extern int box86_nogtk; // disabling the use of wrapped gtk
+extern int box86_lockelision;   // LOCK'd operations are plain ones while there is only one emulated thread
+extern int box86_fusion;        // interpreter fuses CMP/TEST/DEC+Jcc, 2 counts the hits
 extern uintptr_t   trace_start, trace_end;
 extern char* trace_func;
 extern uintptr_t fmod_smc_start, fmod_smc_end; // to handle libfmod (from Unreal) SMC (self modifying code)
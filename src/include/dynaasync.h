@@ -0,0 +1,22 @@
+#ifndef __DYNAASYNC_H_
+#define __DYNAASYNC_H_
+
+typedef struct dynablock_s dynablock_t;
+typedef struct dynablocklist_s dynablocklist_t;
+
+// state of a block handled by the compiler threads
+#define ASYNC_QUEUED    1
+#define ASYNC_COMPILING 2
+#define ASYNC_CANCELED  3
+
+// queue the block (with x86_addr set) to the compiler threads, return 0 if it cannot be done
+int AsyncFillBlock(dynablock_t* block);
+// cancel a queued or compiling block, return 1 if the compiler thread will free the block itself
+int AsyncCancelBlock(dynablock_t* block);
+// wait until no compiler thread uses the dynablocklist anymore, before it (all) or some of its blocks are freed.
+// With all, the queued blocks of the list are also taken out of the queue
+void AsyncDrainList(dynablocklist_t* list, int all);
+// stop the compiler threads
+void FiniDynaAsync();
+
+#endif //__DYNAASYNC_H_
@@ -8,6 +8,8 @@ typedef struct dynablock_s dynablock_t;
 typedef struct dynablocklist_s dynablocklist_t;
 
 uint32_t X31_hash_code(void* addr, int len);
+// compute the hashes of the x86 code of a block (whole and by cache line), gen is the SMC generation before the code was read
+void HashDynablock(dynablock_t* db, uint32_t gen);
 dynablocklist_t* NewDynablockList(uintptr_t base, uintptr_t text, int textsz, int nolinker, int direct);
 void FreeDynablockList(dynablocklist_t** dynablocks);
 void FreeDynablock(dynablock_t* db);
@@ -29,6 +31,12 @@ void MarkDirectDynablock(dynablocklist_t* dynablocks, uintptr_t addr, uintptr_t
 // Handling of Dynarec block (i.e. an exectable chunk of x86 translated code)
 dynablock_t* DBGetBlock(x86emu_t* emu, uintptr_t addr, int create, dynablock_t** current);   // return NULL if block is not found / cannot be created. Don't create if create==0
 dynablock_t* DBAlternateBlock(x86emu_t* emu, uintptr_t addr, uintptr_t filladdr);
+// Recompile a hot block at a higher tier and use it instead of block, return the new block (or block if it failed)
+dynablock_t* DBTierUp(dynablock_t* block);
+// x86 flags that may be read by the (static) block at addr, X_ALL if unknown
+uint32_t DBEntryFlags(uintptr_t addr);
+// 1 if the x86 code from addr to addr+size is in linker lists (so it's not checked for modifications)
+int DBIsStatic(uintptr_t addr, uintptr_t size);
 
 // Create and Add an new dynablock in the list, handling direct/map
 dynablock_t *AddNewDynablock(dynablocklist_t* dynablocks, uintptr_t addr, int* created);
@@ -0,0 +1,29 @@
+#ifndef __DYNACACHE_H_
+#define __DYNACACHE_H_
+#include <stdint.h>
+
+typedef struct dynablock_s dynablock_t;
+typedef struct elfheader_s elfheader_t;
+
+// Relocation of absolute value emitted in a block (as a MOVW/MOVT pair), so the block can be saved and reloaded elsewhere
+#define RELOC_TABLE     1   // address in the jump table of the block, addend is the offset in the table
+#define RELOC_BLOCK     2   // address in the block itself, addend is the offset from the start of the block
+#define RELOC_NATCALL   3   // native bridge of a call, ref is the x86 call address, extra is the expected retn (|NATCALL_DIRECT)
+#define NATCALL_DIRECT  0x10000 // the native function is called directly, without the wrapper (see getNativeCallSignature)
+
+typedef struct dynareloc_s {
+    uint32_t    offset;     // offset of the MOVW/MOVT pair in the block
+    uint32_t    type;
+    uint32_t    ref;
+    int32_t     addend;
+    int32_t     extra;
+} dynareloc_t;
+
+// try to fill the block from the persistent cache, return 1 if ok
+int DynaCacheLoad(dynablock_t* block, uintptr_t addr);
+// save a freshly built block in the persistent cache (if it can be)
+void DynaCacheSave(dynablock_t* block, int instsize_sz, dynareloc_t* relocs, int relocs_sz);
+// close the persistent cache of an elf
+void FreeDynaCache(elfheader_t* h);
+
+#endif //__DYNACACHE_H_
@@ -0,0 +1,31 @@
+#ifndef __DYNAEVICT_H_
+#define __DYNAEVICT_H_
+#include <stdint.h>
+
+typedef struct dynablock_s dynablock_t;
+typedef struct x86emu_s x86emu_t;
+
+// link a jump table entry to block, keeping track of it so it can be unlinked when block goes away
+void DynaLinkTable(void** table, void* jumpto, uintptr_t addr, dynablock_t* block);
+// reset all the links to a block (father), and forget the links from its own table. Used when the block is freed
+void DynaUnlinkBlock(dynablock_t* db);
+
+// code cache budget (BOX86_DYNAREC_CACHE_MB)
+void DynaEvictAdd(dynablock_t* db);     // a new (father) block is ready
+void DynaEvictRemove(dynablock_t* db);  // a (father) block is freed
+void DynaEvictTouch(dynablock_t* db);   // block is used
+// depth of DynaCall/DynaRun for the current thread
+int DynaGetDepth();
+void DynaSetDepth(int depth);
+// a native function is called from x86 code (ret is the native return address), the calling block stays on the native
+// stack while it runs. Returns what to give to DynaNativeLeave when it's back
+dynablock_t* DynaNativeEnter(void* ret);
+void DynaNativeLeave(dynablock_t* old);
+// called when no dynablock can be running in the current thread (DynaCall/DynaRun loop), at that depth
+void DynaQuiescent(x86emu_t* emu, int depth);
+// a second thread is created: evict the blocks with plain LOCK'd operations (emu is the creating thread, if known)
+void DynaEvictNoLock(x86emu_t* emu);
+void FiniDynaEvict();
+void PrintDynaEvictStats();
+
+#endif //__DYNAEVICT_H_
@@ -0,0 +1,14 @@
+#ifndef __DYNAPERF_H_
+#define __DYNAPERF_H_
+
+typedef struct dynablock_s dynablock_t;
+
+// tell perf about a new (father) block (BOX86_PERFMAP): a line in /tmp/perf-<pid>.map, or a record in the jitdump file
+void PerfMapBlock(dynablock_t* block);
+// GDB JIT interface (BOX86_DYNAREC_GDBJIT): the blocks are registered by batches, as in-memory ELF objects with their symbols
+void GdbJitAddBlock(dynablock_t* block);
+void GdbJitRemoveBlock(dynablock_t* block);
+void GdbJitFlush();     // register the pending batch now (best effort, can be called from a signal handler)
+void FiniDynaPerf();
+
+#endif //__DYNAPERF_H_
@@ -5,4 +5,18 @@ typedef struct x86emu_s x86emu_t;
 
 void DynaCall(x86emu_t* emu, uintptr_t addr); // try to use DynaRec... Fallback to EmuCall if no dynarec available
 
+#ifdef DYNAREC
+typedef struct dynablock_s dynablock_t;
+// Indirect Branch Target Cache (BOX86_DYNAREC_IBTC): pairs of x86 address / native address, indexed by the low bits of the x86 address
+// probed by the translated code for RET and JMP/CALL through register, before going back to the dispatcher
+#define IBTC_BITS   12
+#define IBTC_SIZE   (1<<IBTC_BITS)
+extern uintptr_t arm_ibtc[IBTC_SIZE*2];
+extern uint32_t arm_ibtc_hits;      // only counted with BOX86_DYNAREC_STATS
+extern uint32_t arm_ibtc_misses;
+void IBTCAdd(uintptr_t addr, void* native);
+void IBTCRemove(dynablock_t* db);   // remove the entries of a (father) block
+void PrintIBTCStats();
+#endif
+
 #endif // __DYNAREC_H_
\ No newline at end of file
@@ -5,5 +5,6 @@ typedef struct dynablock_s dynablock_t;
 typedef struct x86emu_s x86emu_t;
 
 void* FillBlock(dynablock_t* block, uintptr_t addr);
+void PrintFillBlockStats();    // compilation time (BOX86_DYNAREC_STATS)
 
 #endif //__DYNAREC_ARM_H_
\ No newline at end of file
@@ -0,0 +1,14 @@
+#ifndef __DYNATHUNK_H_
+#define __DYNATHUNK_H_
+#include <stdint.h>
+
+typedef struct x86emu_s x86emu_t;
+typedef void (*wrapper_t)(x86emu_t* emu, uintptr_t fnc);
+
+// get a native thunk calling fnc with the signature of wrapper w (BOX86_DYNAREC_THUNKS), or w itself if it cannot be done
+wrapper_t DynaThunk(wrapper_t w, void* fnc);
+// get the generic wrapper a thunk has been built from (or w if it's not a thunk)
+wrapper_t DynaThunkWrapper(wrapper_t w);
+void FiniDynaThunk();
+
+#endif //__DYNATHUNK_H_
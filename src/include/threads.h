@@ -17,6 +17,9 @@ emu_jmpbuf_t* GetJmpBuf();
 void init_pthread_helper();
 void fini_pthread_helper(box86context_t* context);
 
+// a new emulated thread is starting: the first one ends the single thread mode (BOX86_LOCKELISION)
+void emuthread_add(x86emu_t* creator);
+
 // prepare an "emuthread structure" in pet and return address of function pointer for a "thread creation routine"
 void* my_prepare_thread(x86emu_t *emu, void* f, void* arg, int ssize, void** pet);
 
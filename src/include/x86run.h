@@ -5,6 +5,7 @@
 typedef struct x86emu_s x86emu_t;
 int Run(x86emu_t *emu, int step); // 0 if run was successfull, 1 if error in x86 world
 int DynaRun(x86emu_t *emu);
+void PrintFusionStats();  // hit counts of the fused CMP/TEST/DEC+Jcc (BOX86_FUSION=2)
 
 uint32_t LibSyscall(x86emu_t *emu);
 void PltResolver(x86emu_t* emu);
@@ -27,6 +27,7 @@
 #ifdef DYNAREC
 #include "dynablock.h"
 #include "../dynarec/dynablock_private.h"
+#include "dynaperf.h"
 #endif
 
 
@@ -386,7 +387,7 @@ uintptr_t getX86Address(dynablock_t* db, uintptr_t arm_addr)
             x86sz+=db->instsize[i].x86;
             armsz+=db->instsize[i].nat*4;
         }
-        while(!db->instsize[++i].x86);
+        while(!db->instsize[++i].x86 && db->instsize[i].nat);   // the code of an inlined function is part of its CALL
         if(arm_addr>=armaddr && arm_addr<(armaddr+armsz))
             return x86addr;
         armaddr+=armsz;
@@ -446,6 +447,8 @@ if(sig==SIGSEGV) exit(-1);
     sigcontext->uc_mcontext.gregs[REG_ESP] = R_ESP;
     sigcontext->uc_mcontext.gregs[REG_EBX] = R_EBX;
     // flags
+    CHECK_FLAGS(emu);
+    PackFlags(emu);
     sigcontext->uc_mcontext.gregs[REG_EFL] = emu->packed_eflags.x32;
     // get segments
     sigcontext->uc_mcontext.gregs[REG_GS] = R_GS;
@@ -544,7 +547,7 @@ if(sig==SIGSEGV) exit(-1);
             if(sigcontext->uc_mcontext.gregs[REG_EIP]!=sigcontext_copy.uc_mcontext.gregs[REG_EIP]) ejb->emu->ip.dword[0]=sigcontext->uc_mcontext.gregs[REG_EIP];
             sigcontext->uc_mcontext.gregs[REG_EIP] = R_EIP;
             // flags
-            if(sigcontext->uc_mcontext.gregs[REG_EFL]!=sigcontext_copy.uc_mcontext.gregs[REG_EFL]) ejb->emu->packed_eflags.x32=sigcontext->uc_mcontext.gregs[REG_EFL];
+            if(sigcontext->uc_mcontext.gregs[REG_EFL]!=sigcontext_copy.uc_mcontext.gregs[REG_EFL]) {ejb->emu->packed_eflags.x32=sigcontext->uc_mcontext.gregs[REG_EFL]; RESET_FLAGS(ejb->emu); UnpackFlags(ejb->emu);}
             // get segments
             #define GO(S)   if(sigcontext->uc_mcontext.gregs[REG_##S]!=sigcontext_copy.uc_mcontext.gregs[REG_##S]) {ejb->emu->segs[_##S]=sigcontext->uc_mcontext.gregs[REG_##S]; ejb->emu->segs_serial[_##S] = 0;}
             GO(GS);
@@ -575,8 +578,7 @@ if(sig==SIGSEGV) exit(-1);
 #ifdef DYNAREC
 static int hasDBFromAddress(uintptr_t addr)
 {
-    int idx = (addr>>DYNAMAP_SHIFT);
-    return my_context->dynmap[idx]?1:0;
+    return getDynmap(my_context, addr>>DYNAMAP_SHIFT)?1:0;
 }
 #endif
 
@@ -613,7 +615,7 @@ void my_box86signalhandler(int32_t sig, siginfo_t* info, void * ucntx)
         }
         dynarec_log(LOG_DEBUG, "Access to protected %p from %p, unprotecting memory\n", addr, pc);
         // access error
-        unprotectDB((uintptr_t)addr, 1);    // unprotect 1 byte... But then, the whole page will be unprotected
+        faultDB((uintptr_t)addr);   // unprotect the page, and count the faults there
         // done
         return;
     }
@@ -652,6 +654,9 @@ void my_box86signalhandler(int32_t sig, siginfo_t* info, void * ucntx)
         if(elf)
             elfname = ElfName(elf);
         if(jit_gdb) {
+            #ifdef DYNAREC
+            GdbJitFlush();  // so gdb gets the symbols of the latest blocks too
+            #endif
             pid_t pid = getpid();
             int v = fork(); // is this ok in a signal handler???
             if(v) {
@@ -24,6 +24,7 @@
 #include "bridge.h"
 #ifdef DYNAREC
 #include "dynablock.h"
+#include "dynaevict.h"
 #endif
 
 void _pthread_cleanup_push_defer(void* buffer, void* routine, void* arg);	// declare hidden functions
@@ -123,6 +124,18 @@ typedef struct emuthread_s {
 	x86emu_t*	emu;
 } emuthread_t;
 
+// a new emulated thread is about to run (creator is the emu creating it, if any)
+void emuthread_add(x86emu_t* creator)
+{
+	if(__sync_bool_compare_and_swap(&my_context->singlethread, 1, 0)) {
+		printf_log(LOG_INFO, "Second thread started, LOCK'd operations are now atomic\n");
+		#ifdef DYNAREC
+		// the blocks built with plain LOCK'd operations must go
+		DynaEvictNoLock(creator);
+		#endif
+	}
+}
+
 static void emuthread_destroy(void* p)
 {
 	emuthread_t *et = (emuthread_t*)p;
@@ -161,6 +174,8 @@ x86emu_t* thread_get_emu()
 	if(!et) {
 		int stacksize = 2*1024*1024;
 		void* stack = calloc(1, stacksize);
+		// a native thread calling some x86 code
+		emuthread_add(NULL);
 		x86emu_t *emu = NewX86Emu(my_context, 0, (uintptr_t)stack, stacksize, 1);
 		SetupX86Emu(emu);
 		thread_set_emu(emu);
@@ -255,6 +270,7 @@ EXPORT int my_pthread_create(x86emu_t *emu, void* t, void* attr, void* start_rou
 	et->emu = emuthread;
 	et->fnc = (uintptr_t)start_routine;
 	et->arg = arg;
+	emuthread_add(emu);
 	#ifdef DYNAREC
 	// pre-creation of the JIT code for the entry point of the thread
 	dynablock_t *current = NULL;
@@ -276,6 +292,7 @@ void* my_prepare_thread(x86emu_t *emu, void* f, void* arg, int ssize, void** pet
 	et->emu = emuthread;
 	et->fnc = (uintptr_t)f;
 	et->arg = arg;
+	emuthread_add(emu);
 	#ifdef DYNAREC
 	// pre-creation of the JIT code for the entry point of the thread
 	dynablock_t *current = NULL;
@@ -53,6 +53,20 @@ int box86_dynarec_linker = 1;
 int box86_dynarec_forced = 0;
 int box86_dynarec_largest = 0;
 int box86_dynarec_smc = 0;
+int box86_dynarec_diskcache = 0;
+int box86_dynarec_diskcache_mb = 64;
+char* box86_dynarec_diskcache_dir = NULL;
+int box86_dynarec_async = 0;
+int box86_dynarec_hot = 0;
+int box86_dynarec_stats = 0;
+int box86_dynarec_cache_mb = 0;
+int box86_dynarec_ibtc = 0;
+int box86_dynarec_thunks = 0;
+int box86_dynarec_inline = 0;
+int box86_dynarec_patch = 0;
+int box86_dynarec_onepass = 0;
+int box86_perfmap = 0;
+int box86_dynarec_gdbjit = 0;
 #ifdef ARM
 int arm_vfp = 0;     // vfp version (3 or 4), with 32 registers is mendatory
 int arm_swap = 0;
@@ -83,6 +97,8 @@ int fix_64bit_inodes = 0;
 int box86_steam = 0;
 int box86_nopulse = 0;
 int box86_nogtk = 0;
+int box86_lockelision = 0;
+int box86_fusion = 0;
 char* libGL = NULL;
 uintptr_t   trace_start = 0, trace_end = 0;
 char* trace_func = NULL;
@@ -280,6 +296,129 @@ void LoadLogEnv()
         if(box86_dynarec_smc)
         printf_log(LOG_INFO, "Dynarec is trying to detect SMC in same dynablock\n");
     }
+    p = getenv("BOX86_DYNAREC_DISKCACHE");
+    if(p) {
+        if(strlen(p)==1) {
+            if(p[0]>='0' && p[0]<='0'+1)
+                box86_dynarec_diskcache = p[0]-'0';
+        }
+        if(box86_dynarec_diskcache)
+            printf_log(LOG_INFO, "Dynarec will use a persistent cache of translated blocks\n");
+    }
+    p = getenv("BOX86_DYNAREC_DISKCACHE_DIR");
+    if(p) {
+        box86_dynarec_diskcache_dir = strdup(p);
+        printf_log(LOG_INFO, "Dynarec persistent cache is in \"%s\"\n", box86_dynarec_diskcache_dir);
+    }
+    p = getenv("BOX86_DYNAREC_DISKCACHE_MB");
+    if(p) {
+        char* p2;
+        int mb = strtol(p, &p2, 10);
+        if(mb>0 && !*p2)
+            box86_dynarec_diskcache_mb = mb;
+        printf_log(LOG_INFO, "Dynarec persistent cache is limited to %dMB per binary\n", box86_dynarec_diskcache_mb);
+    }
+    p = getenv("BOX86_DYNAREC_ASYNC");
+    if(p) {
+        char* p2;
+        int n = strtol(p, &p2, 10);
+        if(n>=0 && n<=16 && !*p2)
+            box86_dynarec_async = n;
+        if(box86_dynarec_async)
+            printf_log(LOG_INFO, "Dynarec will compile blocks in %d background thread(s)\n", box86_dynarec_async);
+    }
+    p = getenv("BOX86_DYNAREC_HOT");
+    if(p) {
+        char* p2;
+        int n = strtol(p, &p2, 10);
+        if(n>=0 && !*p2)
+            box86_dynarec_hot = n;
+        if(box86_dynarec_hot)
+            printf_log(LOG_INFO, "Dynarec will recompile blocks run more than %d times\n", box86_dynarec_hot);
+    }
+    p = getenv("BOX86_DYNAREC_STATS");
+    if(p) {
+        if(strlen(p)==1) {
+            if(p[0]>='0' && p[0]<='0'+1)
+                box86_dynarec_stats = p[0]-'0';
+        }
+        if(box86_dynarec_stats)
+            printf_log(LOG_INFO, "Dynarec will print statistics at exit\n");
+    }
+    p = getenv("BOX86_DYNAREC_CACHE_MB");
+    if(p) {
+        char* p2;
+        int mb = strtol(p, &p2, 10);
+        if(mb>=0 && mb<2048 && !*p2)
+            box86_dynarec_cache_mb = mb;
+        if(box86_dynarec_cache_mb)
+            printf_log(LOG_INFO, "Dynarec code cache is limited to %dMB\n", box86_dynarec_cache_mb);
+    }
+    p = getenv("BOX86_DYNAREC_IBTC");
+    if(p) {
+        if(strlen(p)==1) {
+            if(p[0]>='0' && p[0]<='0'+1)
+                box86_dynarec_ibtc = p[0]-'0';
+        }
+        if(box86_dynarec_ibtc)
+            printf_log(LOG_INFO, "Dynarec will use a cache for indirect jumps\n");
+    }
+    p = getenv("BOX86_DYNAREC_THUNKS");
+    if(p) {
+        if(strlen(p)==1) {
+            if(p[0]>='0' && p[0]<='0'+1)
+                box86_dynarec_thunks = p[0]-'0';
+        }
+        if(box86_dynarec_thunks)
+            printf_log(LOG_INFO, "Dynarec will build native thunks for simple wrapped functions\n");
+    }
+    p = getenv("BOX86_DYNAREC_INLINE");
+    if(p) {
+        char* p2;
+        int sz = strtol(p, &p2, 10);
+        if(sz>=0 && sz<=1024 && !*p2)
+            box86_dynarec_inline = sz;
+        if(box86_dynarec_inline)
+            printf_log(LOG_INFO, "Dynarec will inline leaf functions of up to %d bytes\n", box86_dynarec_inline);
+    }
+    p = getenv("BOX86_DYNAREC_PATCH");
+    if(p) {
+        if(strlen(p)==1) {
+            if(p[0]>='0' && p[0]<='0'+1)
+                box86_dynarec_patch = p[0]-'0';
+        }
+        if(box86_dynarec_patch)
+            printf_log(LOG_INFO, "Dynarec will patch direct branches between linked blocks\n");
+    }
+    p = getenv("BOX86_DYNAREC_ONEPASS");
+    if(p) {
+        if(strlen(p)==1) {
+            if(p[0]>='0' && p[0]<='0'+1)
+                box86_dynarec_onepass = p[0]-'0';
+        }
+        if(box86_dynarec_onepass)
+            printf_log(LOG_INFO, "Dynarec will emit the blocks in one pass\n");
+    }
+    p = getenv("BOX86_PERFMAP");
+    if(p) {
+        if(strlen(p)==1) {
+            if(p[0]>='0' && p[0]<='0'+2)
+                box86_perfmap = p[0]-'0';
+        }
+        if(box86_perfmap==1)
+            printf_log(LOG_INFO, "Dynarec will write the blocks in the perf map\n");
+        else if(box86_perfmap==2)
+            printf_log(LOG_INFO, "Dynarec will write the blocks in a perf jitdump\n");
+    }
+    p = getenv("BOX86_DYNAREC_GDBJIT");
+    if(p) {
+        if(strlen(p)==1) {
+            if(p[0]>='0' && p[0]<='0'+2)
+                box86_dynarec_gdbjit = p[0]-'0';
+        }
+        if(box86_dynarec_gdbjit)
+            printf_log(LOG_INFO, "Dynarec will register the blocks with the GDB JIT interface%s\n", (box86_dynarec_gdbjit==2)?" (one by one)":"");
+    }
 #endif
 #ifdef HAVE_TRACE
     p = getenv("BOX86_TRACE_XMM");
@@ -383,6 +522,24 @@ void LoadLogEnv()
         if(box86_nopulse)
             printf_log(LOG_INFO, "Disable the use of pulseaudio libs\n");
     }
+    p = getenv("BOX86_LOCKELISION");
+    if(p) {
+        if(strlen(p)==1) {
+            if(p[0]>='0' && p[0]<='0'+1)
+                box86_lockelision = p[0]-'0';
+        }
+        if(box86_lockelision)
+            printf_log(LOG_INFO, "LOCK'd operations will be plain ones while there is only one thread\n");
+    }
+    p = getenv("BOX86_FUSION");
+    if(p) {
+        if(strlen(p)==1) {
+            if(p[0]>='0' && p[0]<='0'+2)
+                box86_fusion = p[0]-'0';
+        }
+        if(box86_fusion)
+            printf_log(LOG_INFO, "Interpreter will fuse CMP/TEST/DEC with the following Jcc%s\n", (box86_fusion>1)?" (with hit counts)":"");
+    }
     p = getenv("BOX86_NOGTK");
         if(p) {
         if(strlen(p)==1) {
@@ -517,6 +674,20 @@ void PrintHelp() {
     printf(" BOX86_DYNAREC_LOG with 0/1/2/3 or NONE/INFO/DEBUG/DUMP to set the printed dynarec info\n");
     printf(" BOX86_DYNAREC with 0/1 to disable or enable Dynarec (On by default)\n");
     printf(" BOX86_DYNAREC_LINKER with 0/1 to disable or enable Dynarec Linker (On by default, use 0 only for easier debug)\n");
+    printf(" BOX86_DYNAREC_DISKCACHE with 0/1 to disable or enable the persistent cache of translated blocks (Off by default)\n");
+    printf(" BOX86_DYNAREC_DISKCACHE_DIR with a folder for the persistent cache (default is ~/.cache/box86)\n");
+    printf(" BOX86_DYNAREC_DISKCACHE_MB with the maximum size in MB of the persistent cache of each binary (default is 64)\n");
+    printf(" BOX86_DYNAREC_ASYNC with 0..16 the number of threads compiling blocks in background (0, synchronous, by default)\n");
+    printf(" BOX86_DYNAREC_STATS with 0/1 to disable or enable printing dynarec statistics at exit (Off by default)\n");
+    printf(" BOX86_DYNAREC_HOT with the number of runs before a block is recompiled with more optimisations (0, never, by default)\n");
+    printf(" BOX86_DYNAREC_IBTC with 0/1 to disable or enable the cache of indirect jumps targets (Off by default)\n");
+    printf(" BOX86_DYNAREC_CACHE_MB with the size in MB of translated code to keep before evicting the least recently used (0, unlimited, by default)\n");
+    printf(" BOX86_DYNAREC_THUNKS with 0/1 to disable or enable native thunks for simple wrapped functions (Off by default)\n");
+    printf(" BOX86_DYNAREC_INLINE with the maximum size in bytes of the small leaf functions to inline in the caller block (0, no inlining, by default)\n");
+    printf(" BOX86_DYNAREC_PATCH with 0/1 to disable or enable direct branches between linked blocks, instead of the jump table (Off by default)\n");
+    printf(" BOX86_DYNAREC_ONEPASS with 0/1 to disable or enable emitting the blocks in one pass, without the sizing pass (Off by default)\n");
+    printf(" BOX86_PERFMAP with 0/1/2 to write nothing, the perf map /tmp/perf-<pid>.map, or a perf jitdump /tmp/jit-<pid>.dump of the translated blocks (Off by default)\n");
+    printf(" BOX86_DYNAREC_GDBJIT with 0/1/2 to disable, enable by batches, or enable block by block the registration of the translated blocks with the GDB JIT interface (Off by default)\n");
 #endif
 #ifdef HAVE_TRACE
     printf(" BOX86_TRACE with 1 to enable x86 execution trace\n");
@@ -543,6 +714,8 @@ void PrintHelp() {
     printf(" BOX86_ALLOWMISSINGLIBS with 1 to allow to continue even if a lib is missing (unadvised, will probably  crash later)\n");
     printf(" BOX86_NOPULSE=1 to disable the loading of pulseaudio libs\n");
     printf(" BOX86_NOGTK=1 to disable the loading of wrapped gtk libs\n");
+    printf(" BOX86_LOCKELISION with 0/1 to disable or enable plain (non atomic) LOCK'd operations while there is only one thread (Off by default)\n");
+    printf(" BOX86_FUSION with 0/1/2 to disable or enable the fusion of CMP/TEST/DEC with a following Jcc in the interpreter, 2 to also print the hit counts at exit (Off by default)\n");
     printf(" BOX86_JITGDB with 1 to launch \"gdb\" when a segfault is trapped, attached to the offending process\n");
 }
 
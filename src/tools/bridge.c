@@ -13,6 +13,7 @@
 #ifdef DYNAREC
 #include "dynablock.h"
 #include "box86context.h"
+#include "dynathunk.h"
 #endif
 
 KHASH_MAP_INIT_INT(bridgemap, uintptr_t)
@@ -64,6 +65,10 @@ uintptr_t AddBridge(bridge_t* bridge, box86context_t* context, wrapper_t w, void
     }
     b->b[b->sz].CC = 0xCC;
     b->b[b->sz].S = 'S'; b->b[b->sz].C='C';
+    #ifdef DYNAREC
+    if(box86_dynarec)
+        w = DynaThunk(w, fnc);
+    #endif
     b->b[b->sz].w = w;
     b->b[b->sz].f = (uintptr_t)fnc;
     b->b[b->sz].C3 = N?0xC2:0xC3;
@@ -1,9 +1,10 @@
 /*****************************************************************
- * File automatically generated by rebuild_wrappers.py (v1.2.0.09)
+ * File automatically generated by rebuild_wrappers.py (v1.2.0.10)
  *****************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <pthread.h>
 
 #include "wrapper.h"
 #include "emu/x86emu_private.h"
@@ -3786,3 +3787,1900 @@ void iFEpvvpVV(x86emu_t *emu, uintptr_t fcn) { iFEppVV_t fn = (iFEppVV_t)fcn; R_
 void pFpVvvvvV(x86emu_t *emu, uintptr_t fcn) { pFpVV_t fn = (pFpVV_t)fcn; R_EAX=(uintptr_t)fn(*(void**)(R_ESP + 4), (void*)(R_ESP + 8), (void*)(R_ESP + 24)); }
 void iFEpuvvppp(x86emu_t *emu, uintptr_t fcn) { iFEpuppp_t fn = (iFEpuppp_t)fcn; R_EAX=fn(emu, *(void**)(R_ESP + 4), *(uint32_t*)(R_ESP + 8), *(void**)(R_ESP + 20), *(void**)(R_ESP + 24), *(void**)(R_ESP + 28)); }
 void iFEpuvvpVV(x86emu_t *emu, uintptr_t fcn) { iFEpupVV_t fn = (iFEpupVV_t)fcn; R_EAX=fn(emu, *(void**)(R_ESP + 4), *(uint32_t*)(R_ESP + 8), *(void**)(R_ESP + 20), (void*)(R_ESP + 24), (void*)(R_ESP + 24)); }
+
+typedef struct wrappersig_s {
+	wrapper_t	w;
+	const char*	sig;
+} wrappersig_t;
+
+static wrappersig_t wrappersigs[] = {
+	{iF, "iF"},
+	{vFE, "vFE"},
+	{vFv, "vFv"},
+	{vFi, "vFi"},
+	{vFu, "vFu"},
+	{vFf, "vFf"},
+	{vFd, "vFd"},
+	{vFl, "vFl"},
+	{vFL, "vFL"},
+	{vFp, "vFp"},
+	{vFS, "vFS"},
+	{vFG, "vFG"},
+	{cFv, "cFv"},
+	{cFi, "cFi"},
+	{cFu, "cFu"},
+	{cFf, "cFf"},
+	{cFp, "cFp"},
+	{cFG, "cFG"},
+	{wFp, "wFp"},
+	{iFE, "iFE"},
+	{iFv, "iFv"},
+	{iFw, "iFw"},
+	{iFi, "iFi"},
+	{iFI, "iFI"},
+	{iFC, "iFC"},
+	{iFW, "iFW"},
+	{iFu, "iFu"},
+	{iFf, "iFf"},
+	{iFd, "iFd"},
+	{iFL, "iFL"},
+	{iFp, "iFp"},
+	{iFS, "iFS"},
+	{iFG, "iFG"},
+	{IFv, "IFv"},
+	{IFi, "IFi"},
+	{IFf, "IFf"},
+	{IFd, "IFd"},
+	{IFp, "IFp"},
+	{IFG, "IFG"},
+	{CFC, "CFC"},
+	{CFp, "CFp"},
+	{CFG, "CFG"},
+	{WFi, "WFi"},
+	{WFp, "WFp"},
+	{uFE, "uFE"},
+	{uFv, "uFv"},
+	{uFi, "uFi"},
+	{uFu, "uFu"},
+	{uFU, "uFU"},
+	{uFd, "uFd"},
+	{uFp, "uFp"},
+	{uFG, "uFG"},
+	{UFv, "UFv"},
+	{UFp, "UFp"},
+	{UFV, "UFV"},
+	{UFG, "UFG"},
+	{fFi, "fFi"},
+	{fFf, "fFf"},
+	{fFp, "fFp"},
+	{fFG, "fFG"},
+	{dFv, "dFv"},
+	{dFi, "dFi"},
+	{dFu, "dFu"},
+	{dFd, "dFd"},
+	{dFp, "dFp"},
+	{dFG, "dFG"},
+	{lFv, "lFv"},
+	{lFi, "lFi"},
+	{lFl, "lFl"},
+	{lFp, "lFp"},
+	{lFG, "lFG"},
+	{LFv, "LFv"},
+	{LFu, "LFu"},
+	{LFp, "LFp"},
+	{LFG, "LFG"},
+	{pFE, "pFE"},
+	{pFv, "pFv"},
+	{pFw, "pFw"},
+	{pFi, "pFi"},
+	{pFI, "pFI"},
+	{pFC, "pFC"},
+	{pFW, "pFW"},
+	{pFu, "pFu"},
+	{pFU, "pFU"},
+	{pFd, "pFd"},
+	{pFl, "pFl"},
+	{pFL, "pFL"},
+	{pFp, "pFp"},
+	{pFV, "pFV"},
+	{pFG, "pFG"},
+	{vFEp, "vFEp"},
+	{vFii, "vFii"},
+	{vFiI, "vFiI"},
+	{vFiu, "vFiu"},
+	{vFif, "vFif"},
+	{vFid, "vFid"},
+	{vFip, "vFip"},
+	{vFiV, "vFiV"},
+	{vFWW, "vFWW"},
+	{vFWp, "vFWp"},
+	{vFui, "vFui"},
+	{vFuu, "vFuu"},
+	{vFuf, "vFuf"},
+	{vFud, "vFud"},
+	{vFup, "vFup"},
+	{vFfi, "vFfi"},
+	{vFff, "vFff"},
+	{vFfp, "vFfp"},
+	{vFdd, "vFdd"},
+	{vFLp, "vFLp"},
+	{vFpi, "vFpi"},
+	{vFpI, "vFpI"},
+	{vFpC, "vFpC"},
+	{vFpW, "vFpW"},
+	{vFpu, "vFpu"},
+	{vFpU, "vFpU"},
+	{vFpf, "vFpf"},
+	{vFpd, "vFpd"},
+	{vFpl, "vFpl"},
+	{vFpL, "vFpL"},
+	{vFpp, "vFpp"},
+	{vFpS, "vFpS"},
+	{vFpP, "vFpP"},
+	{vFpG, "vFpG"},
+	{vFSi, "vFSi"},
+	{vFGc, "vFGc"},
+	{vFGi, "vFGi"},
+	{vFGI, "vFGI"},
+	{vFGC, "vFGC"},
+	{vFGu, "vFGu"},
+	{vFGU, "vFGU"},
+	{vFGf, "vFGf"},
+	{vFGd, "vFGd"},
+	{vFGl, "vFGl"},
+	{vFGL, "vFGL"},
+	{vFGp, "vFGp"},
+	{vFGG, "vFGG"},
+	{cFpp, "cFpp"},
+	{iFEL, "iFEL"},
+	{iFEp, "iFEp"},
+	{iFEV, "iFEV"},
+	{iFwp, "iFwp"},
+	{iFii, "iFii"},
+	{iFiI, "iFiI"},
+	{iFiu, "iFiu"},
+	{iFiU, "iFiU"},
+	{iFip, "iFip"},
+	{iFIi, "iFIi"},
+	{iFui, "iFui"},
+	{iFuu, "iFuu"},
+	{iFup, "iFup"},
+	{iFLi, "iFLi"},
+	{iFLp, "iFLp"},
+	{iFpw, "iFpw"},
+	{iFpi, "iFpi"},
+	{iFpI, "iFpI"},
+	{iFpC, "iFpC"},
+	{iFpu, "iFpu"},
+	{iFpU, "iFpU"},
+	{iFpf, "iFpf"},
+	{iFpd, "iFpd"},
+	{iFpl, "iFpl"},
+	{iFpL, "iFpL"},
+	{iFpp, "iFpp"},
+	{iFpO, "iFpO"},
+	{iFpP, "iFpP"},
+	{iFpG, "iFpG"},
+	{iFSi, "iFSi"},
+	{iFGG, "iFGG"},
+	{IFEp, "IFEp"},
+	{IFII, "IFII"},
+	{IFpu, "IFpu"},
+	{IFpd, "IFpd"},
+	{CFip, "CFip"},
+	{CFui, "CFui"},
+	{CFpi, "CFpi"},
+	{CFpu, "CFpu"},
+	{CFpp, "CFpp"},
+	{uFEu, "uFEu"},
+	{uFEp, "uFEp"},
+	{uFiu, "uFiu"},
+	{uFui, "uFui"},
+	{uFuu, "uFuu"},
+	{uFup, "uFup"},
+	{uFUp, "uFUp"},
+	{uFpi, "uFpi"},
+	{uFpu, "uFpu"},
+	{uFpL, "uFpL"},
+	{uFpp, "uFpp"},
+	{uFp2, "uFp2"},
+	{UFEp, "UFEp"},
+	{UFii, "UFii"},
+	{UFUU, "UFUU"},
+	{UFUp, "UFUp"},
+	{UFpp, "UFpp"},
+	{UFVV, "UFVV"},
+	{fFEp, "fFEp"},
+	{fFif, "fFif"},
+	{fFfi, "fFfi"},
+	{fFff, "fFff"},
+	{fFfp, "fFfp"},
+	{fFpp, "fFpp"},
+	{dFid, "dFid"},
+	{dFuu, "dFuu"},
+	{dFdi, "dFdi"},
+	{dFdd, "dFdd"},
+	{dFdp, "dFdp"},
+	{dFpp, "dFpp"},
+	{DFpp, "DFpp"},
+	{lFll, "lFll"},
+	{lFpi, "lFpi"},
+	{lFpp, "lFpp"},
+	{LFii, "LFii"},
+	{LFLi, "LFLi"},
+	{LFLp, "LFLp"},
+	{LFpL, "LFpL"},
+	{LFpp, "LFpp"},
+	{pFEi, "pFEi"},
+	{pFEp, "pFEp"},
+	{pFEV, "pFEV"},
+	{pFii, "pFii"},
+	{pFiu, "pFiu"},
+	{pFiL, "pFiL"},
+	{pFip, "pFip"},
+	{pFiV, "pFiV"},
+	{pFui, "pFui"},
+	{pFuC, "pFuC"},
+	{pFuu, "pFuu"},
+	{pFup, "pFup"},
+	{pFuV, "pFuV"},
+	{pFUi, "pFUi"},
+	{pFdd, "pFdd"},
+	{pFlp, "pFlp"},
+	{pFLL, "pFLL"},
+	{pFLp, "pFLp"},
+	{pFpi, "pFpi"},
+	{pFpC, "pFpC"},
+	{pFpu, "pFpu"},
+	{pFpU, "pFpU"},
+	{pFpl, "pFpl"},
+	{pFpL, "pFpL"},
+	{pFpp, "pFpp"},
+	{pFpV, "pFpV"},
+	{pFpG, "pFpG"},
+	{pFSi, "pFSi"},
+	{vFEpi, "vFEpi"},
+	{vFEpu, "vFEpu"},
+	{vFEpp, "vFEpp"},
+	{vFEpV, "vFEpV"},
+	{vFiii, "vFiii"},
+	{vFiip, "vFiip"},
+	{vFiui, "vFiui"},
+	{vFiuu, "vFiuu"},
+	{vFiup, "vFiup"},
+	{vFiff, "vFiff"},
+	{vFidd, "vFidd"},
+	{vFipi, "vFipi"},
+	{vFipu, "vFipu"},
+	{vFipp, "vFipp"},
+	{vFuii, "vFuii"},
+	{vFuiI, "vFuiI"},
+	{vFuiu, "vFuiu"},
+	{vFuif, "vFuif"},
+	{vFuid, "vFuid"},
+	{vFuip, "vFuip"},
+	{vFuui, "vFuui"},
+	{vFuuu, "vFuuu"},
+	{vFuuf, "vFuuf"},
+	{vFuud, "vFuud"},
+	{vFuup, "vFuup"},
+	{vFuff, "vFuff"},
+	{vFudd, "vFudd"},
+	{vFupi, "vFupi"},
+	{vFupu, "vFupu"},
+	{vFupp, "vFupp"},
+	{vFfff, "vFfff"},
+	{vFfpp, "vFfpp"},
+	{vFddd, "vFddd"},
+	{vFdpp, "vFdpp"},
+	{vFLpL, "vFLpL"},
+	{vFpii, "vFpii"},
+	{vFpiC, "vFpiC"},
+	{vFpiu, "vFpiu"},
+	{vFpif, "vFpif"},
+	{vFpid, "vFpid"},
+	{vFpip, "vFpip"},
+	{vFpiP, "vFpiP"},
+	{vFpui, "vFpui"},
+	{vFpuI, "vFpuI"},
+	{vFpuu, "vFpuu"},
+	{vFpup, "vFpup"},
+	{vFpUi, "vFpUi"},
+	{vFpUu, "vFpUu"},
+	{vFpUU, "vFpUU"},
+	{vFpUp, "vFpUp"},
+	{vFpff, "vFpff"},
+	{vFpdd, "vFpdd"},
+	{vFpll, "vFpll"},
+	{vFpLi, "vFpLi"},
+	{vFpLL, "vFpLL"},
+	{vFpLp, "vFpLp"},
+	{vFppi, "vFppi"},
+	{vFppu, "vFppu"},
+	{vFppU, "vFppU"},
+	{vFppd, "vFppd"},
+	{vFppL, "vFppL"},
+	{vFppp, "vFppp"},
+	{vFppV, "vFppV"},
+	{vFppG, "vFppG"},
+	{vFpPp, "vFpPp"},
+	{vFpPP, "vFpPP"},
+	{iFEiw, "iFEiw"},
+	{iFEip, "iFEip"},
+	{iFEWW, "iFEWW"},
+	{iFEup, "iFEup"},
+	{iFEpi, "iFEpi"},
+	{iFEpL, "iFEpL"},
+	{iFEpp, "iFEpp"},
+	{iFEpV, "iFEpV"},
+	{iFESp, "iFESp"},
+	{iFwww, "iFwww"},
+	{iFwpp, "iFwpp"},
+	{iFiwC, "iFiwC"},
+	{iFiii, "iFiii"},
+	{iFiiI, "iFiiI"},
+	{iFiiu, "iFiiu"},
+	{iFiiL, "iFiiL"},
+	{iFiip, "iFiip"},
+	{iFiiO, "iFiiO"},
+	{iFiII, "iFiII"},
+	{iFiuu, "iFiuu"},
+	{iFiup, "iFiup"},
+	{iFipi, "iFipi"},
+	{iFipu, "iFipu"},
+	{iFipp, "iFipp"},
+	{iFCiW, "iFCiW"},
+	{iFuii, "iFuii"},
+	{iFuip, "iFuip"},
+	{iFuui, "iFuui"},
+	{iFuuu, "iFuuu"},
+	{iFuup, "iFuup"},
+	{iFuff, "iFuff"},
+	{iFupp, "iFupp"},
+	{iFfff, "iFfff"},
+	{iFLwp, "iFLwp"},
+	{iFpwp, "iFpwp"},
+	{iFpii, "iFpii"},
+	{iFpiu, "iFpiu"},
+	{iFpiL, "iFpiL"},
+	{iFpip, "iFpip"},
+	{iFpiV, "iFpiV"},
+	{iFpIi, "iFpIi"},
+	{iFpCp, "iFpCp"},
+	{iFpui, "iFpui"},
+	{iFpuu, "iFpuu"},
+	{iFpuL, "iFpuL"},
+	{iFpup, "iFpup"},
+	{iFpu2, "iFpu2"},
+	{iFpuP, "iFpuP"},
+	{iFpUi, "iFpUi"},
+	{iFpUU, "iFpUU"},
+	{iFpUp, "iFpUp"},
+	{iFpUP, "iFpUP"},
+	{iFpfu, "iFpfu"},
+	{iFpff, "iFpff"},
+	{iFpdd, "iFpdd"},
+	{iFpli, "iFpli"},
+	{iFpll, "iFpll"},
+	{iFplp, "iFplp"},
+	{iFpLi, "iFpLi"},
+	{iFpLL, "iFpLL"},
+	{iFpLp, "iFpLp"},
+	{iFppi, "iFppi"},
+	{iFppI, "iFppI"},
+	{iFppC, "iFppC"},
+	{iFppu, "iFppu"},
+	{iFppd, "iFppd"},
+	{iFppl, "iFppl"},
+	{iFppL, "iFppL"},
+	{iFppp, "iFppp"},
+	{iFppV, "iFppV"},
+	{iFppG, "iFppG"},
+	{iFpPp, "iFpPp"},
+	{iFpPP, "iFpPP"},
+	{iFpGG, "iFpGG"},
+	{iFSpi, "iFSpi"},
+	{iFSpu, "iFSpu"},
+	{IFiIi, "IFiIi"},
+	{IFpIi, "IFpIi"},
+	{IFppi, "IFppi"},
+	{IFppI, "IFppI"},
+	{IFppu, "IFppu"},
+	{IFSIi, "IFSIi"},
+	{uFEpW, "uFEpW"},
+	{uFEpu, "uFEpu"},
+	{uFEpU, "uFEpU"},
+	{uFEpp, "uFEpp"},
+	{uFipu, "uFipu"},
+	{uFuip, "uFuip"},
+	{uFuui, "uFuui"},
+	{uFuuI, "uFuuI"},
+	{uFuuu, "uFuuu"},
+	{uFuup, "uFuup"},
+	{uFupi, "uFupi"},
+	{uFupu, "uFupu"},
+	{uFupp, "uFupp"},
+	{uFpii, "uFpii"},
+	{uFpiu, "uFpiu"},
+	{uFpip, "uFpip"},
+	{uFpui, "uFpui"},
+	{uFpuu, "uFpuu"},
+	{uFpup, "uFpup"},
+	{uFpLp, "uFpLp"},
+	{uFppi, "uFppi"},
+	{uFppu, "uFppu"},
+	{uFppp, "uFppp"},
+	{uFSpu, "uFSpu"},
+	{UFppi, "UFppi"},
+	{UFppu, "UFppu"},
+	{fFuii, "fFuii"},
+	{fFfff, "fFfff"},
+	{fFffp, "fFffp"},
+	{fFppu, "fFppu"},
+	{fFppp, "fFppp"},
+	{dFddd, "dFddd"},
+	{dFddp, "dFddp"},
+	{dFpdd, "dFpdd"},
+	{dFppi, "dFppi"},
+	{dFppu, "dFppu"},
+	{dFppp, "dFppp"},
+	{lFipi, "lFipi"},
+	{lFipL, "lFipL"},
+	{lFlll, "lFlll"},
+	{lFpLp, "lFpLp"},
+	{lFppi, "lFppi"},
+	{lFppL, "lFppL"},
+	{LFpii, "LFpii"},
+	{LFpLi, "LFpLi"},
+	{LFpLp, "LFpLp"},
+	{LFppi, "LFppi"},
+	{LFppp, "LFppp"},
+	{pFEip, "pFEip"},
+	{pFEup, "pFEup"},
+	{pFEpi, "pFEpi"},
+	{pFEpu, "pFEpu"},
+	{pFEpp, "pFEpp"},
+	{pFEpV, "pFEpV"},
+	{pFiii, "pFiii"},
+	{pFiiu, "pFiiu"},
+	{pFiip, "pFiip"},
+	{pFiIp, "pFiIp"},
+	{pFiup, "pFiup"},
+	{pFipi, "pFipi"},
+	{pFipu, "pFipu"},
+	{pFipp, "pFipp"},
+	{pFIpi, "pFIpi"},
+	{pFCiW, "pFCiW"},
+	{pFWWW, "pFWWW"},
+	{pFuii, "pFuii"},
+	{pFuui, "pFuui"},
+	{pFuuu, "pFuuu"},
+	{pFupi, "pFupi"},
+	{pFupu, "pFupu"},
+	{pFUpi, "pFUpi"},
+	{pFddd, "pFddd"},
+	{pFpii, "pFpii"},
+	{pFpiu, "pFpiu"},
+	{pFpiU, "pFpiU"},
+	{pFpid, "pFpid"},
+	{pFpil, "pFpil"},
+	{pFpiL, "pFpiL"},
+	{pFpip, "pFpip"},
+	{pFpCu, "pFpCu"},
+	{pFpWW, "pFpWW"},
+	{pFpui, "pFpui"},
+	{pFpuu, "pFpuu"},
+	{pFpup, "pFpup"},
+	{pFpuG, "pFpuG"},
+	{pFpUp, "pFpUp"},
+	{pFpdu, "pFpdu"},
+	{pFplC, "pFplC"},
+	{pFplu, "pFplu"},
+	{pFpll, "pFpll"},
+	{pFplp, "pFplp"},
+	{pFpLL, "pFpLL"},
+	{pFpLp, "pFpLp"},
+	{pFppi, "pFppi"},
+	{pFppC, "pFppC"},
+	{pFppu, "pFppu"},
+	{pFppf, "pFppf"},
+	{pFppl, "pFppl"},
+	{pFppL, "pFppL"},
+	{pFppp, "pFppp"},
+	{pFpVV, "pFpVV"},
+	{pFSpi, "pFSpi"},
+	{pFSpp, "pFSpp"},
+	{vFEiip, "vFEiip"},
+	{vFEipV, "vFEipV"},
+	{vFEpiL, "vFEpiL"},
+	{vFEpip, "vFEpip"},
+	{vFEpuu, "vFEpuu"},
+	{vFEpup, "vFEpup"},
+	{vFEpUp, "vFEpUp"},
+	{vFEppp, "vFEppp"},
+	{vFEppV, "vFEppV"},
+	{vFiiii, "vFiiii"},
+	{vFiiip, "vFiiip"},
+	{vFiipp, "vFiipp"},
+	{vFiipV, "vFiipV"},
+	{vFiuip, "vFiuip"},
+	{vFiuuu, "vFiuuu"},
+	{vFiupu, "vFiupu"},
+	{vFiupV, "vFiupV"},
+	{vFifff, "vFifff"},
+	{vFiddd, "vFiddd"},
+	{vFipii, "vFipii"},
+	{vFipup, "vFipup"},
+	{vFippp, "vFippp"},
+	{vFuiii, "vFuiii"},
+	{vFuiip, "vFuiip"},
+	{vFuiui, "vFuiui"},
+	{vFuiuu, "vFuiuu"},
+	{vFuiup, "vFuiup"},
+	{vFuifi, "vFuifi"},
+	{vFuiff, "vFuiff"},
+	{vFuidd, "vFuidd"},
+	{vFuipi, "vFuipi"},
+	{vFuipu, "vFuipu"},
+	{vFuipp, "vFuipp"},
+	{vFuuii, "vFuuii"},
+	{vFuuiu, "vFuuiu"},
+	{vFuuip, "vFuuip"},
+	{vFuuui, "vFuuui"},
+	{vFuuuu, "vFuuuu"},
+	{vFuuuf, "vFuuuf"},
+	{vFuuud, "vFuuud"},
+	{vFuuup, "vFuuup"},
+	{vFuupi, "vFuupi"},
+	{vFuupp, "vFuupp"},
+	{vFufff, "vFufff"},
+	{vFuddd, "vFuddd"},
+	{vFupii, "vFupii"},
+	{vFuppi, "vFuppi"},
+	{vFffff, "vFffff"},
+	{vFdddd, "vFdddd"},
+	{vFpiii, "vFpiii"},
+	{vFpiiu, "vFpiiu"},
+	{vFpiip, "vFpiip"},
+	{vFpiuu, "vFpiuu"},
+	{vFpiuL, "vFpiuL"},
+	{vFpiup, "vFpiup"},
+	{vFpiUu, "vFpiUu"},
+	{vFpifi, "vFpifi"},
+	{vFpipi, "vFpipi"},
+	{vFpipu, "vFpipu"},
+	{vFpipp, "vFpipp"},
+	{vFpipG, "vFpipG"},
+	{vFpCiW, "vFpCiW"},
+	{vFpuip, "vFpuip"},
+	{vFpuui, "vFpuui"},
+	{vFpuuu, "vFpuuu"},
+	{vFpuup, "vFpuup"},
+	{vFpuuV, "vFpuuV"},
+	{vFpudd, "vFpudd"},
+	{vFpupp, "vFpupp"},
+	{vFpUui, "vFpUui"},
+	{vFpUuu, "vFpUuu"},
+	{vFpUup, "vFpUup"},
+	{vFpUUi, "vFpUUi"},
+	{vFpUUp, "vFpUUp"},
+	{vFpUpp, "vFpUpp"},
+	{vFpfff, "vFpfff"},
+	{vFpdii, "vFpdii"},
+	{vFpddd, "vFpddd"},
+	{vFpLLL, "vFpLLL"},
+	{vFppii, "vFppii"},
+	{vFppiu, "vFppiu"},
+	{vFppid, "vFppid"},
+	{vFppil, "vFppil"},
+	{vFppiL, "vFppiL"},
+	{vFppip, "vFppip"},
+	{vFppiG, "vFppiG"},
+	{vFppui, "vFppui"},
+	{vFppuu, "vFppuu"},
+	{vFppup, "vFppup"},
+	{vFppfi, "vFppfi"},
+	{vFppdu, "vFppdu"},
+	{vFppdd, "vFppdd"},
+	{vFppdp, "vFppdp"},
+	{vFpplp, "vFpplp"},
+	{vFpppi, "vFpppi"},
+	{vFpppI, "vFpppI"},
+	{vFpppu, "vFpppu"},
+	{vFpppU, "vFpppU"},
+	{vFpppd, "vFpppd"},
+	{vFpppL, "vFpppL"},
+	{vFpppp, "vFpppp"},
+	{vFpppV, "vFpppV"},
+	{vFpppG, "vFpppG"},
+	{vFpPpp, "vFpPpp"},
+	{vFSppi, "vFSppi"},
+	{cFpiii, "cFpiii"},
+	{iFEiip, "iFEiip"},
+	{iFEipp, "iFEipp"},
+	{iFEupp, "iFEupp"},
+	{iFELup, "iFELup"},
+	{iFEpii, "iFEpii"},
+	{iFEpip, "iFEpip"},
+	{iFEpuu, "iFEpuu"},
+	{iFEpup, "iFEpup"},
+	{iFEpUp, "iFEpUp"},
+	{iFEpLi, "iFEpLi"},
+	{iFEppi, "iFEppi"},
+	{iFEppu, "iFEppu"},
+	{iFEppL, "iFEppL"},
+	{iFEppp, "iFEppp"},
+	{iFEppV, "iFEppV"},
+	{iFEpVV, "iFEpVV"},
+	{iFEpOu, "iFEpOu"},
+	{iFEpOV, "iFEpOV"},
+	{iFEPpp, "iFEPpp"},
+	{iFwwww, "iFwwww"},
+	{iFwppp, "iFwppp"},
+	{iFiiii, "iFiiii"},
+	{iFiiiu, "iFiiiu"},
+	{iFiiip, "iFiiip"},
+	{iFiiII, "iFiiII"},
+	{iFiiLi, "iFiiLi"},
+	{iFiipi, "iFiipi"},
+	{iFiipu, "iFiipu"},
+	{iFiipp, "iFiipp"},
+	{iFiuii, "iFiuii"},
+	{iFiuui, "iFiuui"},
+	{iFiupp, "iFiupp"},
+	{iFiLwp, "iFiLwp"},
+	{iFipii, "iFipii"},
+	{iFipip, "iFipip"},
+	{iFipui, "iFipui"},
+	{iFipup, "iFipup"},
+	{iFipLi, "iFipLi"},
+	{iFippi, "iFippi"},
+	{iFippu, "iFippu"},
+	{iFippp, "iFippp"},
+	{iFipOu, "iFipOu"},
+	{iFuipu, "iFuipu"},
+	{iFuipp, "iFuipp"},
+	{iFuuff, "iFuuff"},
+	{iFupup, "iFupup"},
+	{iFuppi, "iFuppi"},
+	{iFuppp, "iFuppp"},
+	{iFpiii, "iFpiii"},
+	{iFpiiu, "iFpiiu"},
+	{iFpiid, "iFpiid"},
+	{iFpiiL, "iFpiiL"},
+	{iFpiip, "iFpiip"},
+	{iFpiuu, "iFpiuu"},
+	{iFpiuL, "iFpiuL"},
+	{iFpiup, "iFpiup"},
+	{iFpild, "iFpild"},
+	{iFpipi, "iFpipi"},
+	{iFpipC, "iFpipC"},
+	{iFpipp, "iFpipp"},
+	{iFpipV, "iFpipV"},
+	{iFpIip, "iFpIip"},
+	{iFpCCC, "iFpCCC"},
+	{iFpCpi, "iFpCpi"},
+	{iFpWWu, "iFpWWu"},
+	{iFpuii, "iFpuii"},
+	{iFpuiu, "iFpuiu"},
+	{iFpuiL, "iFpuiL"},
+	{iFpuip, "iFpuip"},
+	{iFpuui, "iFpuui"},
+	{iFpuuu, "iFpuuu"},
+	{iFpuup, "iFpuup"},
+	{iFpuUp, "iFpuUp"},
+	{iFpuLL, "iFpuLL"},
+	{iFpuLp, "iFpuLp"},
+	{iFpupi, "iFpupi"},
+	{iFpupu, "iFpupu"},
+	{iFpupp, "iFpupp"},
+	{iFpupV, "iFpupV"},
+	{iFpuPU, "iFpuPU"},
+	{iFpUup, "iFpUup"},
+	{iFpUUU, "iFpUUU"},
+	{iFpUpp, "iFpUpp"},
+	{iFplii, "iFplii"},
+	{iFplip, "iFplip"},
+	{iFpLwp, "iFpLwp"},
+	{iFpLpi, "iFpLpi"},
+	{iFppii, "iFppii"},
+	{iFppiu, "iFppiu"},
+	{iFppip, "iFppip"},
+	{iFppIL, "iFppIL"},
+	{iFppCC, "iFppCC"},
+	{iFppuw, "iFppuw"},
+	{iFppui, "iFppui"},
+	{iFppuu, "iFppuu"},
+	{iFppup, "iFppup"},
+	{iFppdp, "iFppdp"},
+	{iFppll, "iFppll"},
+	{iFpplp, "iFpplp"},
+	{iFppLi, "iFppLi"},
+	{iFppLL, "iFppLL"},
+	{iFppLp, "iFppLp"},
+	{iFpppi, "iFpppi"},
+	{iFpppC, "iFpppC"},
+	{iFpppu, "iFpppu"},
+	{iFpppL, "iFpppL"},
+	{iFpppp, "iFpppp"},
+	{iFpPpp, "iFpPpp"},
+	{iFpGGi, "iFpGGi"},
+	{IFEpIi, "IFEpIi"},
+	{IFpIip, "IFpIip"},
+	{IFppii, "IFppii"},
+	{IFppip, "IFppip"},
+	{IFpppp, "IFpppp"},
+	{IFSIii, "IFSIii"},
+	{uFEipp, "uFEipp"},
+	{uFEupp, "uFEupp"},
+	{uFEpup, "uFEpup"},
+	{uFEppu, "uFEppu"},
+	{uFEppp, "uFEppp"},
+	{uFifff, "uFifff"},
+	{uFippu, "uFippu"},
+	{uFuuuu, "uFuuuu"},
+	{uFpipu, "uFpipu"},
+	{uFpipp, "uFpipp"},
+	{uFpCCC, "uFpCCC"},
+	{uFpuip, "uFpuip"},
+	{uFpuuu, "uFpuuu"},
+	{uFpuup, "uFpuup"},
+	{uFpupp, "uFpupp"},
+	{uFppiu, "uFppiu"},
+	{uFppip, "uFppip"},
+	{uFppup, "uFppup"},
+	{uFppLp, "uFppLp"},
+	{uFpppi, "uFpppi"},
+	{uFpppp, "uFpppp"},
+	{UFppii, "UFppii"},
+	{UFppip, "UFppip"},
+	{UFpppp, "UFpppp"},
+	{UFSUii, "UFSUii"},
+	{dFpppp, "dFpppp"},
+	{lFEpip, "lFEpip"},
+	{lFipLi, "lFipLi"},
+	{lFipLI, "lFipLI"},
+	{lFipLl, "lFipLl"},
+	{lFipLL, "lFipLL"},
+	{lFpili, "lFpili"},
+	{lFpilp, "lFpilp"},
+	{lFpupp, "lFpupp"},
+	{LFippp, "LFippp"},
+	{LFpLLp, "LFpLLp"},
+	{LFpLpp, "LFpLpp"},
+	{LFppii, "LFppii"},
+	{LFppip, "LFppip"},
+	{LFpppi, "LFpppi"},
+	{LFpppp, "LFpppp"},
+	{pFEipi, "pFEipi"},
+	{pFEipp, "pFEipp"},
+	{pFEipV, "pFEipV"},
+	{pFEupp, "pFEupp"},
+	{pFEpii, "pFEpii"},
+	{pFEpip, "pFEpip"},
+	{pFEppi, "pFEppi"},
+	{pFEppC, "pFEppC"},
+	{pFEppu, "pFEppu"},
+	{pFEppp, "pFEppp"},
+	{pFEppV, "pFEppV"},
+	{pFiiii, "pFiiii"},
+	{pFiiiu, "pFiiiu"},
+	{pFiiuu, "pFiiuu"},
+	{pFiiup, "pFiiup"},
+	{pFiipi, "pFiipi"},
+	{pFipii, "pFipii"},
+	{pFipip, "pFipip"},
+	{pFippi, "pFippi"},
+	{pFippu, "pFippu"},
+	{pFuiii, "pFuiii"},
+	{pFffff, "pFffff"},
+	{pFdipp, "pFdipp"},
+	{pFdddd, "pFdddd"},
+	{pFpiii, "pFpiii"},
+	{pFpiip, "pFpiip"},
+	{pFpiuu, "pFpiuu"},
+	{pFpipd, "pFpipd"},
+	{pFpipp, "pFpipp"},
+	{pFpipV, "pFpipV"},
+	{pFpuii, "pFpuii"},
+	{pFpuip, "pFpuip"},
+	{pFpuuu, "pFpuuu"},
+	{pFpupi, "pFpupi"},
+	{pFpupu, "pFpupu"},
+	{pFplpl, "pFplpl"},
+	{pFpLip, "pFpLip"},
+	{pFppii, "pFppii"},
+	{pFppiu, "pFppiu"},
+	{pFppiL, "pFppiL"},
+	{pFppip, "pFppip"},
+	{pFppuu, "pFppuu"},
+	{pFppup, "pFppup"},
+	{pFppLp, "pFppLp"},
+	{pFpppi, "pFpppi"},
+	{pFpppu, "pFpppu"},
+	{pFpppL, "pFpppL"},
+	{pFpppp, "pFpppp"},
+	{pFpppV, "pFpppV"},
+	{pFSppi, "pFSppi"},
+	{vFEippp, "vFEippp"},
+	{vFEpuup, "vFEpuup"},
+	{vFEpupp, "vFEpupp"},
+	{vFEpLLp, "vFEpLLp"},
+	{vFEppip, "vFEppip"},
+	{vFEppup, "vFEppup"},
+	{vFEpppp, "vFEpppp"},
+	{vFiiiii, "vFiiiii"},
+	{vFiiiiu, "vFiiiiu"},
+	{vFiiuup, "vFiiuup"},
+	{vFiipii, "vFiipii"},
+	{vFiuiip, "vFiuiip"},
+	{vFiuipi, "vFiuipi"},
+	{vFiuuuu, "vFiuuuu"},
+	{vFiffff, "vFiffff"},
+	{vFidddd, "vFidddd"},
+	{vFilill, "vFilill"},
+	{vFipipu, "vFipipu"},
+	{vFipipp, "vFipipp"},
+	{vFipupi, "vFipupi"},
+	{vFuiiii, "vFuiiii"},
+	{vFuiiiu, "vFuiiiu"},
+	{vFuiiip, "vFuiiip"},
+	{vFuiiup, "vFuiiup"},
+	{vFuiIII, "vFuiIII"},
+	{vFuiuii, "vFuiuii"},
+	{vFuiuiu, "vFuiuiu"},
+	{vFuiuip, "vFuiuip"},
+	{vFuiuuu, "vFuiuuu"},
+	{vFuiuup, "vFuiuup"},
+	{vFuiupi, "vFuiupi"},
+	{vFuiupu, "vFuiupu"},
+	{vFuifff, "vFuifff"},
+	{vFuiddd, "vFuiddd"},
+	{vFuipii, "vFuipii"},
+	{vFuipip, "vFuipip"},
+	{vFuipup, "vFuipup"},
+	{vFuippp, "vFuippp"},
+	{vFuuiii, "vFuuiii"},
+	{vFuuiui, "vFuuiui"},
+	{vFuuiuu, "vFuuiuu"},
+	{vFuuiup, "vFuuiup"},
+	{vFuuipi, "vFuuipi"},
+	{vFuuipu, "vFuuipu"},
+	{vFuuipp, "vFuuipp"},
+	{vFuuuii, "vFuuuii"},
+	{vFuuuiu, "vFuuuiu"},
+	{vFuuuip, "vFuuuip"},
+	{vFuuuui, "vFuuuui"},
+	{vFuuuuu, "vFuuuuu"},
+	{vFuuuup, "vFuuuup"},
+	{vFuupii, "vFuupii"},
+	{vFuffff, "vFuffff"},
+	{vFudddd, "vFudddd"},
+	{vFupupi, "vFupupi"},
+	{vFuppip, "vFuppip"},
+	{vFupppp, "vFupppp"},
+	{vFfffff, "vFfffff"},
+	{vFddddp, "vFddddp"},
+	{vFpiiii, "vFpiiii"},
+	{vFpiiiu, "vFpiiiu"},
+	{vFpiiff, "vFpiiff"},
+	{vFpiipp, "vFpiipp"},
+	{vFpipii, "vFpipii"},
+	{vFpipiu, "vFpipiu"},
+	{vFpuiip, "vFpuiip"},
+	{vFpuipp, "vFpuipp"},
+	{vFpuipV, "vFpuipV"},
+	{vFpuuuu, "vFpuuuu"},
+	{vFpuuup, "vFpuuup"},
+	{vFpuupp, "vFpuupp"},
+	{vFpuddd, "vFpuddd"},
+	{vFpupup, "vFpupup"},
+	{vFpUuiu, "vFpUuiu"},
+	{vFpUUuu, "vFpUUuu"},
+	{vFpUUup, "vFpUUup"},
+	{vFpUUUu, "vFpUUUu"},
+	{vFpUUUp, "vFpUUUp"},
+	{vFpffff, "vFpffff"},
+	{vFpddii, "vFpddii"},
+	{vFpdddd, "vFpdddd"},
+	{vFpddpp, "vFpddpp"},
+	{vFpliil, "vFpliil"},
+	{vFppiii, "vFppiii"},
+	{vFppiiu, "vFppiiu"},
+	{vFppiip, "vFppiip"},
+	{vFppiup, "vFppiup"},
+	{vFppiff, "vFppiff"},
+	{vFppipi, "vFppipi"},
+	{vFppipp, "vFppipp"},
+	{vFppWui, "vFppWui"},
+	{vFppuui, "vFppuui"},
+	{vFppupi, "vFppupi"},
+	{vFppupp, "vFppupp"},
+	{vFpppii, "vFpppii"},
+	{vFpppip, "vFpppip"},
+	{vFpppuu, "vFpppuu"},
+	{vFppppi, "vFppppi"},
+	{vFppppu, "vFppppu"},
+	{vFppppL, "vFppppL"},
+	{vFppppp, "vFppppp"},
+	{iFEiipp, "iFEiipp"},
+	{iFEipuu, "iFEipuu"},
+	{iFEippi, "iFEippi"},
+	{iFEippp, "iFEippp"},
+	{iFEipVV, "iFEipVV"},
+	{iFEpiii, "iFEpiii"},
+	{iFEpiup, "iFEpiup"},
+	{iFEpipi, "iFEpipi"},
+	{iFEpipp, "iFEpipp"},
+	{iFEpupV, "iFEpupV"},
+	{iFEpUup, "iFEpUup"},
+	{iFEpLpp, "iFEpLpp"},
+	{iFEpLpV, "iFEpLpV"},
+	{iFEppii, "iFEppii"},
+	{iFEppip, "iFEppip"},
+	{iFEppiV, "iFEppiV"},
+	{iFEpplp, "iFEpplp"},
+	{iFEpppp, "iFEpppp"},
+	{iFEpppV, "iFEpppV"},
+	{iFEppVV, "iFEppVV"},
+	{iFEpPpp, "iFEpPpp"},
+	{iFiiipu, "iFiiipu"},
+	{iFiiipp, "iFiiipp"},
+	{iFiiupp, "iFiiupp"},
+	{iFiipip, "iFiipip"},
+	{iFiuuuu, "iFiuuuu"},
+	{iFipiii, "iFipiii"},
+	{iFipipi, "iFipipi"},
+	{iFipipu, "iFipipu"},
+	{iFipuii, "iFipuii"},
+	{iFipuui, "iFipuui"},
+	{iFippui, "iFippui"},
+	{iFippup, "iFippup"},
+	{iFipppi, "iFipppi"},
+	{iFipppp, "iFipppp"},
+	{iFuppup, "iFuppup"},
+	{iFpiiii, "iFpiiii"},
+	{iFpiiiu, "iFpiiiu"},
+	{iFpiiiL, "iFpiiiL"},
+	{iFpiiip, "iFpiiip"},
+	{iFpiiuu, "iFpiiuu"},
+	{iFpiiLi, "iFpiiLi"},
+	{iFpiipi, "iFpiipi"},
+	{iFpiipp, "iFpiipp"},
+	{iFpiupu, "iFpiupu"},
+	{iFpiLwp, "iFpiLwp"},
+	{iFpipii, "iFpipii"},
+	{iFpipiL, "iFpipiL"},
+	{iFpipip, "iFpipip"},
+	{iFpippi, "iFpippi"},
+	{iFpippp, "iFpippp"},
+	{iFpipGp, "iFpipGp"},
+	{iFpCCCC, "iFpCCCC"},
+	{iFpuiii, "iFpuiii"},
+	{iFpuiup, "iFpuiup"},
+	{iFpuuip, "iFpuuip"},
+	{iFpuuui, "iFpuuui"},
+	{iFpuuup, "iFpuuup"},
+	{iFpuuLL, "iFpuuLL"},
+	{iFpuupu, "iFpuupu"},
+	{iFpuupp, "iFpuupp"},
+	{iFpupiU, "iFpupiU"},
+	{iFpupuu, "iFpupuu"},
+	{iFpupup, "iFpupup"},
+	{iFpuppu, "iFpuppu"},
+	{iFpuppp, "iFpuppp"},
+	{iFplluu, "iFplluu"},
+	{iFpLlpp, "iFpLlpp"},
+	{iFpLLpp, "iFpLLpp"},
+	{iFppiiu, "iFppiiu"},
+	{iFppiip, "iFppiip"},
+	{iFppiup, "iFppiup"},
+	{iFppipi, "iFppipi"},
+	{iFppipp, "iFppipp"},
+	{iFppupi, "iFppupi"},
+	{iFppupp, "iFppupp"},
+	{iFppllp, "iFppllp"},
+	{iFpplpp, "iFpplpp"},
+	{iFppLwp, "iFppLwp"},
+	{iFppLip, "iFppLip"},
+	{iFppLpL, "iFppLpL"},
+	{iFpppii, "iFpppii"},
+	{iFpppiu, "iFpppiu"},
+	{iFpppip, "iFpppip"},
+	{iFpppui, "iFpppui"},
+	{iFpppuu, "iFpppuu"},
+	{iFpppup, "iFpppup"},
+	{iFppppi, "iFppppi"},
+	{iFppppu, "iFppppu"},
+	{iFppppL, "iFppppL"},
+	{iFppppp, "iFppppp"},
+	{iFpppGp, "iFpppGp"},
+	{IFppIII, "IFppIII"},
+	{uFEippp, "uFEippp"},
+	{uFEpipp, "uFEpipp"},
+	{uFEppuu, "uFEppuu"},
+	{uFEpppp, "uFEpppp"},
+	{uFiuuuu, "uFiuuuu"},
+	{uFipipp, "uFipipp"},
+	{uFuiiiu, "uFuiiiu"},
+	{uFupppp, "uFupppp"},
+	{uFpCCCC, "uFpCCCC"},
+	{uFpuuuu, "uFpuuuu"},
+	{uFpuuup, "uFpuuup"},
+	{uFppiip, "uFppiip"},
+	{uFppipp, "uFppipp"},
+	{uFppuup, "uFppuup"},
+	{uFpplip, "uFpplip"},
+	{uFppLpp, "uFppLpp"},
+	{uFppppp, "uFppppp"},
+	{lFEipiI, "lFEipiI"},
+	{lFipLli, "lFipLli"},
+	{lFppiip, "lFppiip"},
+	{LFEpppp, "LFEpppp"},
+	{LFpuppi, "LFpuppi"},
+	{LFpLppp, "LFpLppp"},
+	{LFpppii, "LFpppii"},
+	{LFppppp, "LFppppp"},
+	{pFEpiii, "pFEpiii"},
+	{pFEpipi, "pFEpipi"},
+	{pFEpipL, "pFEpipL"},
+	{pFEpipp, "pFEpipp"},
+	{pFEpupp, "pFEpupp"},
+	{pFEppii, "pFEppii"},
+	{pFEppip, "pFEppip"},
+	{pFEppCC, "pFEppCC"},
+	{pFEppuu, "pFEppuu"},
+	{pFEppup, "pFEppup"},
+	{pFEpppi, "pFEpppi"},
+	{pFEpppp, "pFEpppp"},
+	{pFiiiii, "pFiiiii"},
+	{pFipipu, "pFipipu"},
+	{pFipppu, "pFipppu"},
+	{pFipppp, "pFipppp"},
+	{pFuiiiu, "pFuiiiu"},
+	{pFuiipp, "pFuiipp"},
+	{pFpiiii, "pFpiiii"},
+	{pFpiiip, "pFpiiip"},
+	{pFpiiuu, "pFpiiuu"},
+	{pFpiipi, "pFpiipi"},
+	{pFpiipp, "pFpiipp"},
+	{pFpiCCC, "pFpiCCC"},
+	{pFpiuuu, "pFpiuuu"},
+	{pFpippi, "pFpippi"},
+	{pFpippp, "pFpippp"},
+	{pFpuiii, "pFpuiii"},
+	{pFpuuip, "pFpuuip"},
+	{pFpuppp, "pFpuppp"},
+	{pFpdddd, "pFpdddd"},
+	{pFplppp, "pFplppp"},
+	{pFppiii, "pFppiii"},
+	{pFppiip, "pFppiip"},
+	{pFppiup, "pFppiup"},
+	{pFppipi, "pFppipi"},
+	{pFppipp, "pFppipp"},
+	{pFppuui, "pFppuui"},
+	{pFppuuu, "pFppuuu"},
+	{pFppuup, "pFppuup"},
+	{pFpppii, "pFpppii"},
+	{pFpppip, "pFpppip"},
+	{pFpppui, "pFpppui"},
+	{pFpppuu, "pFpppuu"},
+	{pFpppup, "pFpppup"},
+	{pFppppi, "pFppppi"},
+	{pFppppp, "pFppppp"},
+	{vFEiiipp, "vFEiiipp"},
+	{vFEpiLpp, "vFEpiLpp"},
+	{vFEpippp, "vFEpippp"},
+	{vFEpuipp, "vFEpuipp"},
+	{vFEpupup, "vFEpupup"},
+	{vFEpLLpp, "vFEpLLpp"},
+	{vFEppupp, "vFEppupp"},
+	{vFEppppp, "vFEppppp"},
+	{vFiiiiii, "vFiiiiii"},
+	{vFiiiuil, "vFiiiuil"},
+	{vFiuippp, "vFiuippp"},
+	{vFiffiff, "vFiffiff"},
+	{vFiddidd, "vFiddidd"},
+	{vFuiiiii, "vFuiiiii"},
+	{vFuiiiip, "vFuiiiip"},
+	{vFuiiuii, "vFuiiuii"},
+	{vFuiiuup, "vFuiiuup"},
+	{vFuiuiii, "vFuiuiii"},
+	{vFuiuiip, "vFuiuiip"},
+	{vFuiuiuu, "vFuiuiuu"},
+	{vFuiuuip, "vFuiuuip"},
+	{vFuiuuuu, "vFuiuuuu"},
+	{vFuiupii, "vFuiupii"},
+	{vFuiupiu, "vFuiupiu"},
+	{vFuiffff, "vFuiffff"},
+	{vFuidddd, "vFuidddd"},
+	{vFuipiup, "vFuipiup"},
+	{vFuuiiii, "vFuuiiii"},
+	{vFuuiuii, "vFuuiuii"},
+	{vFuuiuiu, "vFuuiuiu"},
+	{vFuuiuup, "vFuuiuup"},
+	{vFuuippp, "vFuuippp"},
+	{vFuuuiup, "vFuuuiup"},
+	{vFuuuipi, "vFuuuipi"},
+	{vFuuuipp, "vFuuuipp"},
+	{vFuuuuii, "vFuuuuii"},
+	{vFuuuuip, "vFuuuuip"},
+	{vFuuuuuu, "vFuuuuuu"},
+	{vFuuuuff, "vFuuuuff"},
+	{vFuuuppi, "vFuuuppi"},
+	{vFuuuppp, "vFuuuppp"},
+	{vFuuffff, "vFuuffff"},
+	{vFuudddd, "vFuudddd"},
+	{vFuffiip, "vFuffiip"},
+	{vFufffff, "vFufffff"},
+	{vFuddiip, "vFuddiip"},
+	{vFupupip, "vFupupip"},
+	{vFuppppp, "vFuppppp"},
+	{vFffffff, "vFffffff"},
+	{vFdddddd, "vFdddddd"},
+	{vFpiiiii, "vFpiiiii"},
+	{vFpiiipp, "vFpiiipp"},
+	{vFpiiuuu, "vFpiiuuu"},
+	{vFpiippp, "vFpiippp"},
+	{vFpipiiu, "vFpipiiu"},
+	{vFpipipV, "vFpipipV"},
+	{vFpipppi, "vFpipppi"},
+	{vFpipppp, "vFpipppp"},
+	{vFpuiiiu, "vFpuiiiu"},
+	{vFpuiipp, "vFpuiipp"},
+	{vFpuuuiu, "vFpuuuiu"},
+	{vFpuuppp, "vFpuuppp"},
+	{vFpudddd, "vFpudddd"},
+	{vFpUiuup, "vFpUiuup"},
+	{vFpUiUup, "vFpUiUup"},
+	{vFpUipup, "vFpUipup"},
+	{vFpUUiup, "vFpUUiup"},
+	{vFpdddii, "vFpdddii"},
+	{vFpddddd, "vFpddddd"},
+	{vFppiiii, "vFppiiii"},
+	{vFppiiip, "vFppiiip"},
+	{vFppiiui, "vFppiiui"},
+	{vFppiipi, "vFppiipi"},
+	{vFppiipp, "vFppiipp"},
+	{vFppilpp, "vFppilpp"},
+	{vFppippi, "vFppippi"},
+	{vFppippp, "vFppippp"},
+	{vFppuuuu, "vFppuuuu"},
+	{vFppupii, "vFppupii"},
+	{vFppuppp, "vFppuppp"},
+	{vFppdidd, "vFppdidd"},
+	{vFpplppi, "vFpplppi"},
+	{vFpplppp, "vFpplppp"},
+	{vFppLppi, "vFppLppi"},
+	{vFppLppp, "vFppLppp"},
+	{vFpppiii, "vFpppiii"},
+	{vFpppiip, "vFpppiip"},
+	{vFpppiff, "vFpppiff"},
+	{vFpppipu, "vFpppipu"},
+	{vFpppuii, "vFpppuii"},
+	{vFppppii, "vFppppii"},
+	{vFpppppi, "vFpppppi"},
+	{vFpppppu, "vFpppppu"},
+	{vFpppppL, "vFpppppL"},
+	{vFpppppp, "vFpppppp"},
+	{cFppLppi, "cFppLppi"},
+	{iFEiippi, "iFEiippi"},
+	{iFEiippp, "iFEiippp"},
+	{iFEipuup, "iFEipuup"},
+	{iFEipppi, "iFEipppi"},
+	{iFElpppp, "iFElpppp"},
+	{iFEpiipp, "iFEpiipp"},
+	{iFEpiipV, "iFEpiipV"},
+	{iFEpippi, "iFEpippi"},
+	{iFEpippp, "iFEpippp"},
+	{iFEpipVV, "iFEpipVV"},
+	{iFEpuuip, "iFEpuuip"},
+	{iFEpuppp, "iFEpuppp"},
+	{iFEpupVV, "iFEpupVV"},
+	{iFEpUPpp, "iFEpUPpp"},
+	{iFEpLppp, "iFEpLppp"},
+	{iFEppppp, "iFEppppp"},
+	{iFiiiiii, "iFiiiiii"},
+	{iFiiiiip, "iFiiiiip"},
+	{iFiiiLwp, "iFiiiLwp"},
+	{iFiuiipi, "iFiuiipi"},
+	{iFipipuu, "iFipipuu"},
+	{iFipuipu, "iFipuipu"},
+	{iFipuipp, "iFipuipp"},
+	{iFipupup, "iFipupup"},
+	{iFipuppp, "iFipuppp"},
+	{iFipppup, "iFipppup"},
+	{iFippppp, "iFippppp"},
+	{iFuppipp, "iFuppipp"},
+	{iFuppppp, "iFuppppp"},
+	{iFdipppL, "iFdipppL"},
+	{iFpiiiii, "iFpiiiii"},
+	{iFpiiiip, "iFpiiiip"},
+	{iFpiiipp, "iFpiiipp"},
+	{iFpiiuii, "iFpiiuii"},
+	{iFpiippu, "iFpiippu"},
+	{iFpiippp, "iFpiippp"},
+	{iFpiuuup, "iFpiuuup"},
+	{iFpiuupp, "iFpiuupp"},
+	{iFpiuppu, "iFpiuppu"},
+	{iFpipipi, "iFpipipi"},
+	{iFpippip, "iFpippip"},
+	{iFpipppp, "iFpipppp"},
+	{iFpCpipu, "iFpCpipu"},
+	{iFpuiiii, "iFpuiiii"},
+	{iFpupipi, "iFpupipi"},
+	{iFpupuui, "iFpupuui"},
+	{iFpUUUip, "iFpUUUip"},
+	{iFpUUUUp, "iFpUUUUp"},
+	{iFppiiip, "iFppiiip"},
+	{iFppiiuu, "iFppiiuu"},
+	{iFppiipi, "iFppiipi"},
+	{iFppiipp, "iFppiipp"},
+	{iFppipii, "iFppipii"},
+	{iFppipiL, "iFppipiL"},
+	{iFppipip, "iFppipip"},
+	{iFppIipp, "iFppIipp"},
+	{iFppIppp, "iFppIppp"},
+	{iFppuiii, "iFppuiii"},
+	{iFppuiiu, "iFppuiiu"},
+	{iFppuipp, "iFppuipp"},
+	{iFppuIII, "iFppuIII"},
+	{iFppuupp, "iFppuupp"},
+	{iFppupip, "iFppupip"},
+	{iFppuppp, "iFppuppp"},
+	{iFppUipp, "iFppUipp"},
+	{iFppUupp, "iFppUupp"},
+	{iFppdidd, "iFppdidd"},
+	{iFpplppi, "iFpplppi"},
+	{iFppLupp, "iFppLupp"},
+	{iFppLpLp, "iFppLpLp"},
+	{iFpppiuu, "iFpppiuu"},
+	{iFpppipp, "iFpppipp"},
+	{iFpppuii, "iFpppuii"},
+	{iFpppupu, "iFpppupu"},
+	{iFpppupp, "iFpppupp"},
+	{iFppppii, "iFppppii"},
+	{iFppppip, "iFppppip"},
+	{iFppppup, "iFppppup"},
+	{iFpppppi, "iFpppppi"},
+	{iFpppppu, "iFpppppu"},
+	{iFpppppp, "iFpppppp"},
+	{uFEiippp, "uFEiippp"},
+	{uFEiuppp, "uFEiuppp"},
+	{uFpippup, "uFpippup"},
+	{uFppippp, "uFppippp"},
+	{uFpppppp, "uFpppppp"},
+	{uFSpuiip, "uFSpuiip"},
+	{LFEupppp, "LFEupppp"},
+	{LFpipipi, "LFpipipi"},
+	{LFpLippp, "LFpLippp"},
+	{pFEpippp, "pFEpippp"},
+	{pFEpuipp, "pFEpuipp"},
+	{pFEpuupp, "pFEpuupp"},
+	{pFEpuppp, "pFEpuppp"},
+	{pFEppCWp, "pFEppCWp"},
+	{pFEppCuW, "pFEppCuW"},
+	{pFEppCuu, "pFEppCuu"},
+	{pFEppuWp, "pFEppuWp"},
+	{pFEppuuu, "pFEppuuu"},
+	{pFEppuup, "pFEppuup"},
+	{pFEpppup, "pFEpppup"},
+	{pFEppppi, "pFEppppi"},
+	{pFEppppp, "pFEppppp"},
+	{pFiiiiii, "pFiiiiii"},
+	{pFiCiiCi, "pFiCiiCi"},
+	{pFdddddd, "pFdddddd"},
+	{pFpiiiiu, "pFpiiiiu"},
+	{pFpiiCCC, "pFpiiCCC"},
+	{pFpiiuuu, "pFpiiuuu"},
+	{pFpippip, "pFpippip"},
+	{pFpuuuuu, "pFpuuuuu"},
+	{pFplpppp, "pFplpppp"},
+	{pFppiiii, "pFppiiii"},
+	{pFppiipp, "pFppiipp"},
+	{pFppiCCC, "pFppiCCC"},
+	{pFppippi, "pFppippi"},
+	{pFppippp, "pFppippp"},
+	{pFpppiii, "pFpppiii"},
+	{pFpppiui, "pFpppiui"},
+	{pFppppii, "pFppppii"},
+	{pFpppppi, "pFpppppi"},
+	{pFpppppu, "pFpppppu"},
+	{pFpppppp, "pFpppppp"},
+	{pFSpiiii, "pFSpiiii"},
+	{vFEpipppp, "vFEpipppp"},
+	{vFEpuipuV, "vFEpuipuV"},
+	{vFEpppppp, "vFEpppppp"},
+	{vFiiiiiip, "vFiiiiiip"},
+	{vFiiiiuup, "vFiiiiuup"},
+	{vFiiupuip, "vFiiupuip"},
+	{vFiiffffp, "vFiiffffp"},
+	{vFiupuuup, "vFiupuuup"},
+	{vFuiiiiii, "vFuiiiiii"},
+	{vFuiiiuip, "vFuiiiuip"},
+	{vFuiiiuup, "vFuiiiuup"},
+	{vFuiuiiii, "vFuiuiiii"},
+	{vFuiuiiip, "vFuiuiiip"},
+	{vFuiuiiuu, "vFuiuiiuu"},
+	{vFuiupiiu, "vFuiupiiu"},
+	{vFuipiiii, "vFuipiiii"},
+	{vFuipffff, "vFuipffff"},
+	{vFuipdddd, "vFuipdddd"},
+	{vFuuiiiii, "vFuuiiiii"},
+	{vFuuiiiip, "vFuuiiiip"},
+	{vFuuiiiui, "vFuuiiiui"},
+	{vFuuiiiuu, "vFuuiiiuu"},
+	{vFuuiiuup, "vFuuiiuup"},
+	{vFuuiuiii, "vFuuiuiii"},
+	{vFuuipppp, "vFuuipppp"},
+	{vFuuuiiii, "vFuuuiiii"},
+	{vFuuuiiip, "vFuuuiiip"},
+	{vFuuuiuii, "vFuuuiuii"},
+	{vFuuuiupi, "vFuuuiupi"},
+	{vFuuuuiip, "vFuuuuiip"},
+	{vFuuuuuuu, "vFuuuuuuu"},
+	{vFuuuufff, "vFuuuufff"},
+	{vFuuuffff, "vFuuuffff"},
+	{vFuuudddd, "vFuuudddd"},
+	{vFuuffiip, "vFuuffiip"},
+	{vFuuddiip, "vFuuddiip"},
+	{vFuffffff, "vFuffffff"},
+	{vFudddddd, "vFudddddd"},
+	{vFpiiiipp, "vFpiiiipp"},
+	{vFpiiliip, "vFpiiliip"},
+	{vFpiipCpp, "vFpiipCpp"},
+	{vFpipipii, "vFpipipii"},
+	{vFpipppii, "vFpipppii"},
+	{vFpuuuuuu, "vFpuuuuuu"},
+	{vFpuuUUuu, "vFpuuUUuu"},
+	{vFpUiUiup, "vFpUiUiup"},
+	{vFpddiidd, "vFpddiidd"},
+	{vFpdddddd, "vFpdddddd"},
+	{vFppiiiii, "vFppiiiii"},
+	{vFppiiiip, "vFppiiiip"},
+	{vFppiiipi, "vFppiiipi"},
+	{vFppiipii, "vFppiipii"},
+	{vFppiipuu, "vFppiipuu"},
+	{vFppiippp, "vFppiippp"},
+	{vFppilppi, "vFppilppi"},
+	{vFppipiip, "vFppipiip"},
+	{vFppipipp, "vFppipipp"},
+	{vFppipppp, "vFppipppp"},
+	{vFppLpppi, "vFppLpppi"},
+	{vFppLpppp, "vFppLpppp"},
+	{vFpppiiii, "vFpppiiii"},
+	{vFpppiipi, "vFpppiipi"},
+	{vFpppiipp, "vFpppiipp"},
+	{vFpppippi, "vFpppippi"},
+	{vFpppuuuu, "vFpppuuuu"},
+	{vFppppiii, "vFppppiii"},
+	{vFppppiip, "vFppppiip"},
+	{vFppppipi, "vFppppipi"},
+	{vFpppppip, "vFpppppip"},
+	{vFppppppi, "vFppppppi"},
+	{vFppppppp, "vFppppppp"},
+	{iFEpuiupV, "iFEpuiupV"},
+	{iFEpupppp, "iFEpupppp"},
+	{iFEpUuppp, "iFEpUuppp"},
+	{iFEppiuui, "iFEppiuui"},
+	{iFEppupIi, "iFEppupIi"},
+	{iFEppuppp, "iFEppuppp"},
+	{iFEpppiiu, "iFEpppiiu"},
+	{iFEpppppp, "iFEpppppp"},
+	{iFiiiiiip, "iFiiiiiip"},
+	{iFiuppppp, "iFiuppppp"},
+	{iFpiiiiii, "iFpiiiiii"},
+	{iFpiiiiip, "iFpiiiiip"},
+	{iFpiiiLwp, "iFpiiiLwp"},
+	{iFpiiuuiu, "iFpiiuuiu"},
+	{iFpiiuuuu, "iFpiiuuuu"},
+	{iFpiipppp, "iFpiipppp"},
+	{iFpiuiipp, "iFpiuiipp"},
+	{iFpiupiii, "iFpiupiii"},
+	{iFpippupp, "iFpippupp"},
+	{iFpippppp, "iFpippppp"},
+	{iFpIIpppp, "iFpIIpppp"},
+	{iFpuiiiip, "iFpuiiiip"},
+	{iFpuiiuii, "iFpuiiuii"},
+	{iFpuipupp, "iFpuipupp"},
+	{iFpuuiuui, "iFpuuiuui"},
+	{iFpuuuppu, "iFpuuuppu"},
+	{iFpuupppp, "iFpuupppp"},
+	{iFpupuuui, "iFpupuuui"},
+	{iFpupuufu, "iFpupuufu"},
+	{iFpupupui, "iFpupupui"},
+	{iFpuppppp, "iFpuppppp"},
+	{iFpLipipi, "iFpLipipi"},
+	{iFppiiuui, "iFppiiuui"},
+	{iFppiipii, "iFppiipii"},
+	{iFppiipiL, "iFppiipiL"},
+	{iFppipiip, "iFppipiip"},
+	{iFppipipi, "iFppipipi"},
+	{iFppipipp, "iFppipipp"},
+	{iFppippip, "iFppippip"},
+	{iFppipppi, "iFppipppi"},
+	{iFppipppp, "iFppipppp"},
+	{iFppuipiL, "iFppuipiL"},
+	{iFppLiipp, "iFppLiipp"},
+	{iFpppiiii, "iFpppiiii"},
+	{iFpppiiuu, "iFpppiiuu"},
+	{iFpppiiup, "iFpppiiup"},
+	{iFpppiipi, "iFpppiipi"},
+	{iFpppiuwu, "iFpppiuwu"},
+	{iFpppippi, "iFpppippi"},
+	{iFpppippp, "iFpppippp"},
+	{iFpppuiii, "iFpppuiii"},
+	{iFpppuppp, "iFpppuppp"},
+	{iFppppiii, "iFppppiii"},
+	{iFppppipp, "iFppppipp"},
+	{iFppppdpi, "iFppppdpi"},
+	{iFpppppip, "iFpppppip"},
+	{iFpppppup, "iFpppppup"},
+	{iFppppppi, "iFppppppi"},
+	{iFppppppp, "iFppppppp"},
+	{uFEpiippp, "uFEpiippp"},
+	{uFuippppp, "uFuippppp"},
+	{LFEpppppu, "LFEpppppu"},
+	{pFEpLiiii, "pFEpLiiii"},
+	{pFEpLiiiI, "pFEpLiiiI"},
+	{pFEppCuup, "pFEppCuup"},
+	{pFEppCppp, "pFEppCppp"},
+	{pFEppuipp, "pFEppuipp"},
+	{pFEppuWWW, "pFEppuWWW"},
+	{pFEppuuWW, "pFEppuuWW"},
+	{pFEppuuup, "pFEppuuup"},
+	{pFEppppip, "pFEppppip"},
+	{pFEpppppp, "pFEpppppp"},
+	{pFifffppp, "pFifffppp"},
+	{pFuupupup, "pFuupupup"},
+	{pFplppppp, "pFplppppp"},
+	{pFppiiipp, "pFppiiipp"},
+	{pFppiiCCC, "pFppiiCCC"},
+	{pFppiippp, "pFppiippp"},
+	{pFppipipp, "pFppipipp"},
+	{pFppuuuuu, "pFppuuuuu"},
+	{pFppuuppp, "pFppuuppp"},
+	{pFppLiiip, "pFppLiiip"},
+	{pFppLipip, "pFppLipip"},
+	{pFpppccci, "pFpppccci"},
+	{pFpppiiii, "pFpppiiii"},
+	{pFpppiipp, "pFpppiipp"},
+	{pFpppIIIi, "pFpppIIIi"},
+	{pFpppCCCi, "pFpppCCCi"},
+	{pFpppuuui, "pFpppuuui"},
+	{pFpppuupp, "pFpppuupp"},
+	{pFpppUUUi, "pFpppUUUi"},
+	{pFpppfffi, "pFpppfffi"},
+	{pFpppdddi, "pFpppdddi"},
+	{pFpppllli, "pFpppllli"},
+	{pFpppLLLi, "pFpppLLLi"},
+	{pFppppuuu, "pFppppuuu"},
+	{pFpppppuu, "pFpppppuu"},
+	{pFppppppi, "pFppppppi"},
+	{pFppppppp, "pFppppppp"},
+	{vFEiippppV, "vFEiippppV"},
+	{vFEiupippp, "vFEiupippp"},
+	{vFEippippp, "vFEippippp"},
+	{vFEuuuuppp, "vFEuuuuppp"},
+	{vFEppipppp, "vFEppipppp"},
+	{vFEpppuipV, "vFEpppuipV"},
+	{vFEpppppuu, "vFEpppppuu"},
+	{vFiiiiuuip, "vFiiiiuuip"},
+	{vFiupuiuup, "vFiupuiuup"},
+	{vFiupuuuup, "vFiupuuuup"},
+	{vFuiiiiiii, "vFuiiiiiii"},
+	{vFuiiiiuup, "vFuiiiiuup"},
+	{vFuiiipiup, "vFuiiipiup"},
+	{vFuiuiiiii, "vFuiuiiiii"},
+	{vFuiuiiiip, "vFuiuiiiip"},
+	{vFuuiiiiii, "vFuuiiiiii"},
+	{vFuuiiiuip, "vFuuiiiuip"},
+	{vFuuiiiuup, "vFuuiiiuup"},
+	{vFuuiiuupp, "vFuuiiuupp"},
+	{vFuuiuiiii, "vFuuiuiiii"},
+	{vFuuiuiiip, "vFuuiuiiip"},
+	{vFuuuiiiii, "vFuuuiiiii"},
+	{vFuuuiuiii, "vFuuuiuiii"},
+	{vFuuuipipp, "vFuuuipipp"},
+	{vFuuuuuuuu, "vFuuuuuuuu"},
+	{vFuuuuufff, "vFuuuuufff"},
+	{vFffffffff, "vFffffffff"},
+	{vFpiiiiiii, "vFpiiiiiii"},
+	{vFpiiiipii, "vFpiiiipii"},
+	{vFpiiULipp, "vFpiiULipp"},
+	{vFpiUuupup, "vFpiUuupup"},
+	{vFpippiiuu, "vFpippiiuu"},
+	{vFpippiipi, "vFpippiipi"},
+	{vFpUiUiupi, "vFpUiUiupi"},
+	{vFpUuuUUUi, "vFpUuuUUUi"},
+	{vFppiiiiii, "vFppiiiiii"},
+	{vFppiiipii, "vFppiiipii"},
+	{vFppipipii, "vFppipipii"},
+	{vFppipppui, "vFppipppui"},
+	{vFppippppi, "vFppippppi"},
+	{vFppippppp, "vFppippppp"},
+	{vFpplppppi, "vFpplppppi"},
+	{vFpplppppp, "vFpplppppp"},
+	{vFppppiipi, "vFppppiipi"},
+	{iFEipupupi, "iFEipupupi"},
+	{iFEpippppp, "iFEpippppp"},
+	{iFEpuuiipp, "iFEpuuiipp"},
+	{iFEpuuuipp, "iFEpuuuipp"},
+	{iFEpuuLppp, "iFEpuuLppp"},
+	{iFEppppipp, "iFEppppipp"},
+	{iFiiiiiiip, "iFiiiiiiip"},
+	{iFiiippppp, "iFiiippppp"},
+	{iFiiupiupi, "iFiiupiupi"},
+	{iFipOuuuuu, "iFipOuuuuu"},
+	{iFuiifpppp, "iFuiifpppp"},
+	{iFLLLLLLLL, "iFLLLLLLLL"},
+	{iFpiiiiipi, "iFpiiiiipi"},
+	{iFpCCWWpWu, "iFpCCWWpWu"},
+	{iFpuiipppp, "iFpuiipppp"},
+	{iFpuipuppp, "iFpuipuppp"},
+	{iFpuippupp, "iFpuippupp"},
+	{iFpuuiiiii, "iFpuuiiiii"},
+	{iFpupppppp, "iFpupppppp"},
+	{iFpUuuLpUi, "iFpUuuLpUi"},
+	{iFppiiiiiu, "iFppiiiiiu"},
+	{iFppIIIppp, "iFppIIIppp"},
+	{iFpppiippp, "iFpppiippp"},
+	{iFpppipipi, "iFpppipipi"},
+	{iFpppipppp, "iFpppipppp"},
+	{iFppppiipi, "iFppppiipi"},
+	{iFppppippp, "iFppppippp"},
+	{iFppppppii, "iFppppppii"},
+	{iFpppppppi, "iFpppppppi"},
+	{iFpppppppp, "iFpppppppp"},
+	{uFEipipppp, "uFEipipppp"},
+	{uFEpiupppp, "uFEpiupppp"},
+	{uFEppipppp, "uFEppipppp"},
+	{uFEppppppp, "uFEppppppp"},
+	{uFuipppppp, "uFuipppppp"},
+	{LFEpiupppp, "LFEpiupppp"},
+	{pFEppCuuCC, "pFEppCuuCC"},
+	{pFEppCuuWW, "pFEppCuuWW"},
+	{pFEppCuuup, "pFEppCuuup"},
+	{pFEppuuuuu, "pFEppuuuuu"},
+	{pFEppuuUUU, "pFEppuuUUU"},
+	{pFEppLiiip, "pFEppLiiip"},
+	{pFEpppuipV, "pFEpppuipV"},
+	{pFEpppppiV, "pFEpppppiV"},
+	{pFEppppppi, "pFEppppppi"},
+	{pFEppppppp, "pFEppppppp"},
+	{pFiipppppp, "pFiipppppp"},
+	{pFuiiiuuuu, "pFuiiiuuuu"},
+	{pFuupupipp, "pFuupupipp"},
+	{pFpiiiiiuu, "pFpiiiiiuu"},
+	{pFpipppppp, "pFpipppppp"},
+	{pFpWWiCpup, "pFpWWiCpup"},
+	{pFpuuuupup, "pFpuuuupup"},
+	{pFpupupuuu, "pFpupupuuu"},
+	{pFpdwwWWui, "pFpdwwWWui"},
+	{pFplpppppp, "pFplpppppp"},
+	{pFppiiiiii, "pFppiiiiii"},
+	{pFpppuuuuu, "pFpppuuuuu"},
+	{pFpppppupp, "pFpppppupp"},
+	{vFEpiiiiipp, "vFEpiiiiipp"},
+	{vFEppiipppp, "vFEppiipppp"},
+	{vFEpppiippp, "vFEpppiippp"},
+	{vFuiiiiiiii, "vFuiiiiiiii"},
+	{vFuiiiiiuip, "vFuiiiiiuip"},
+	{vFuiiiiiuup, "vFuiiiiiuup"},
+	{vFuiuiiiiip, "vFuiuiiiiip"},
+	{vFuiupuffup, "vFuiupuffup"},
+	{vFuuiiiiiii, "vFuuiiiiiii"},
+	{vFuuiuiiiii, "vFuuiuiiiii"},
+	{vFuuiuiiiip, "vFuuiuiiiip"},
+	{vFuuiuiiuup, "vFuuiuiiuup"},
+	{vFuuuiiiiip, "vFuuuiiiiip"},
+	{vFuuuuuuuuu, "vFuuuuuuuuu"},
+	{vFuupiuiuuf, "vFuupiuiuuf"},
+	{vFuffffffff, "vFuffffffff"},
+	{vFffuuuufff, "vFffuuuufff"},
+	{vFddddddddd, "vFddddddddd"},
+	{vFpipiuiipp, "vFpipiuiipp"},
+	{vFpipppiipi, "vFpipppiipi"},
+	{vFppiiiiiii, "vFppiiiiiii"},
+	{vFppiiiiipi, "vFppiiiiipi"},
+	{vFppiiipiii, "vFppiiipiii"},
+	{vFppiipiiii, "vFppiipiiii"},
+	{vFppipppiii, "vFppipppiii"},
+	{vFppipppiip, "vFppipppiip"},
+	{vFppuuiiiii, "vFppuuiiiii"},
+	{vFpplpppppi, "vFpplpppppi"},
+	{vFpppiiiiii, "vFpppiiiiii"},
+	{vFppppipiip, "vFppppipiip"},
+	{vFpppppippp, "vFpppppippp"},
+	{vFppppppppp, "vFppppppppp"},
+	{iFEiiuuuuuu, "iFEiiuuuuuu"},
+	{iFEpiiiiipi, "iFEpiiiiipi"},
+	{iFEpuuiippu, "iFEpuuiippu"},
+	{iFEpuuuiipp, "iFEpuuuiipp"},
+	{iFEpppipppp, "iFEpppipppp"},
+	{iFEpppppupp, "iFEpppppupp"},
+	{iFiiiiiiiip, "iFiiiiiiiip"},
+	{iFiiiipiiip, "iFiiiipiiip"},
+	{iFipiipippi, "iFipiipippi"},
+	{iFdddpppppp, "iFdddpppppp"},
+	{iFpiuuupipu, "iFpiuuupipu"},
+	{iFpipLpiiip, "iFpipLpiiip"},
+	{iFpuiuuipip, "iFpuiuuipip"},
+	{iFpupuupWWu, "iFpupuupWWu"},
+	{iFpLLLLLLLL, "iFpLLLLLLLL"},
+	{iFppiiiiiii, "iFppiiiiiii"},
+	{iFppiuiippu, "iFppiuiippu"},
+	{iFppipiiipi, "iFppipiiipi"},
+	{iFppLpiippp, "iFppLpiippp"},
+	{iFpppiiuuii, "iFpppiiuuii"},
+	{iFpppiipiiu, "iFpppiipiiu"},
+	{iFppppupiii, "iFppppupiii"},
+	{iFppppppppu, "iFppppppppu"},
+	{iFppppppppp, "iFppppppppp"},
+	{uFEipippppp, "uFEipippppp"},
+	{uFppppppppp, "uFppppppppp"},
+	{LFEppppppii, "LFEppppppii"},
+	{pFEppiiuuui, "pFEppiiuuui"},
+	{pFEppCuwwWW, "pFEppCuwwWW"},
+	{pFEppCuuwwp, "pFEppCuuwwp"},
+	{pFEppCuuuuu, "pFEppCuuuuu"},
+	{pFEppuippuu, "pFEppuippuu"},
+	{pFEppuupwwC, "pFEppuupwwC"},
+	{pFEpppppiiV, "pFEpppppiiV"},
+	{pFEpppppppi, "pFEpppppppi"},
+	{pFpiiiiuuuu, "pFpiiiiuuuu"},
+	{pFpiuuuuuuu, "pFpiuuuuuuu"},
+	{pFpupuuuuup, "pFpupuuuuup"},
+	{pFppiiiiiip, "pFppiiiiiip"},
+	{pFppiiuuuuu, "pFppiiuuuuu"},
+	{pFppipppppp, "pFppipppppp"},
+	{pFpppiiiiii, "pFpppiiiiii"},
+	{pFpppiipppp, "pFpppiipppp"},
+	{pFpppppiipp, "pFpppppiipp"},
+	{vFEiippppppp, "vFEiippppppp"},
+	{vFEpippppppp, "vFEpippppppp"},
+	{vFEpppiipppp, "vFEpppiipppp"},
+	{vFiiiiiiiiiu, "vFiiiiiiiiiu"},
+	{vFippppppppp, "vFippppppppp"},
+	{vFuiiiiiiiii, "vFuiiiiiiiii"},
+	{vFuiiiiiiuup, "vFuiiiiiiuup"},
+	{vFuiuiiiiuup, "vFuiuiiiiuup"},
+	{vFuuiiiiiiii, "vFuuiiiiiiii"},
+	{vFuuiiiiiuip, "vFuuiiiiiuip"},
+	{vFuuiiiiiuup, "vFuuiiiiiuup"},
+	{vFuuiuiiiiip, "vFuuiuiiiiip"},
+	{vFuuiuiiiuup, "vFuuiuiiiuup"},
+	{vFuuuuuuuiii, "vFuuuuuuuiii"},
+	{vFuuuuuuuuuu, "vFuuuuuuuuuu"},
+	{vFuupiiupuuf, "vFuupiiupuuf"},
+	{vFuffiiffiip, "vFuffiiffiip"},
+	{vFuddiiddiip, "vFuddiiddiip"},
+	{vFffffffffff, "vFffffffffff"},
+	{vFpipppppppp, "vFpipppppppp"},
+	{vFppiiiiiiii, "vFppiiiiiiii"},
+	{vFppiiiiipip, "vFppiiiiipip"},
+	{vFppiipppiip, "vFppiipppiip"},
+	{vFppiippppii, "vFppiippppii"},
+	{vFppipppiiii, "vFppipppiiii"},
+	{vFppuuuuiiuu, "vFppuuuuiiuu"},
+	{vFppdddddddd, "vFppdddddddd"},
+	{vFpppppppppp, "vFpppppppppp"},
+	{iFEpiiiiippp, "iFEpiiiiippp"},
+	{iFEpuipupppp, "iFEpuipupppp"},
+	{iFEpuuiiuipp, "iFEpuuiiuipp"},
+	{iFEpuuuuiipp, "iFEpuuuuiipp"},
+	{iFiiiiiiiiip, "iFiiiiiiiiip"},
+	{iFpuipuppppp, "iFpuipuppppp"},
+	{iFpuupiuiipp, "iFpuupiuiipp"},
+	{iFppuuiiiiii, "iFppuuiiiiii"},
+	{iFppuuiiuupi, "iFppuuiiuupi"},
+	{iFpppLLipppp, "iFpppLLipppp"},
+	{iFppppiiuuii, "iFppppiiuuii"},
+	{uFpppppppppp, "uFpppppppppp"},
+	{pFEiippppppp, "pFEiippppppp"},
+	{pFEpiiiiiipp, "pFEpiiiiiipp"},
+	{pFEpippppppp, "pFEpippppppp"},
+	{pFEppCuwwWWu, "pFEppCuwwWWu"},
+	{pFEppCuuuCup, "pFEppCuuuCup"},
+	{pFplllllllll, "pFplllllllll"},
+	{pFppuiipuuii, "pFppuiipuuii"},
+	{vFEpiiiupupup, "vFEpiiiupupup"},
+	{vFiippppppppp, "vFiippppppppp"},
+	{vFuiiiiiiiiip, "vFuiiiiiiiiip"},
+	{vFuiiiiiiiuip, "vFuiiiiiiiuip"},
+	{vFuiiiiiiiuup, "vFuiiiiiiiuup"},
+	{vFuiuiiiiiuup, "vFuiuiiiiiuup"},
+	{vFuuiuiiiiuup, "vFuuiuiiiiuup"},
+	{vFuuuuuuuuuuu, "vFuuuuuuuuuuu"},
+	{vFuuffiiffiip, "vFuuffiiffiip"},
+	{vFuufffffffff, "vFuufffffffff"},
+	{vFuuddiiddiip, "vFuuddiiddiip"},
+	{vFuffffffffff, "vFuffffffffff"},
+	{vFpipipiipiii, "vFpipipiipiii"},
+	{vFpipppiiiipi, "vFpipppiiiipi"},
+	{vFpupiiuPuPuP, "vFpupiiuPuPuP"},
+	{vFppiiiiiiiii, "vFppiiiiiiiii"},
+	{vFppiiiiipiii, "vFppiiiiipiii"},
+	{vFppiiiiddddi, "vFppiiiiddddi"},
+	{vFppiipppiiii, "vFppiipppiiii"},
+	{vFppipppiiiii, "vFppipppiiiii"},
+	{vFppipppuiiii, "vFppipppuiiii"},
+	{vFppipppppppp, "vFppipppppppp"},
+	{vFppppppppppp, "vFppppppppppp"},
+	{iFEpuuiiuippu, "iFEpuuiiuippu"},
+	{iFEpuuuuuiipp, "iFEpuuuuuiipp"},
+	{iFEpppipppppp, "iFEpppipppppp"},
+	{iFEppppiiiiuu, "iFEppppiiiiuu"},
+	{iFiiiiiiiiiip, "iFiiiiiiiiiip"},
+	{iFpipllippppp, "iFpipllippppp"},
+	{iFppippipppip, "iFppippipppip"},
+	{iFppppiiuuiiu, "iFppppiiuuiiu"},
+	{uFEpiiupppiuV, "uFEpiiupppiuV"},
+	{uFEpiippppiup, "uFEpiippppiup"},
+	{uFEppppppippp, "uFEppppppippp"},
+	{pFEpipppppppi, "pFEpipppppppi"},
+	{pFEppiiLpppip, "pFEppiiLpppip"},
+	{pFEppCuWCCuuu, "pFEppCuWCCuuu"},
+	{pFEppuiipuuii, "pFEppuiipuuii"},
+	{pFEppuuwwWWww, "pFEppuuwwWWww"},
+	{pFpppppppiipp, "pFpppppppiipp"},
+	{pFppppppppppp, "pFppppppppppp"},
+	{vFuuiiiiiiiuip, "vFuuiiiiiiiuip"},
+	{vFuuiiiiiiiuup, "vFuuiiiiiiiuup"},
+	{vFuuuuuuuuuuuu, "vFuuuuuuuuuuuu"},
+	{vFffffffffffff, "vFffffffffffff"},
+	{vFpipppiiiipii, "vFpipppiiiipii"},
+	{vFpippppiiiipi, "vFpippppiiiipi"},
+	{vFppiiiiddddii, "vFppiiiiddddii"},
+	{vFppiiuuuiupup, "vFppiiuuuiupup"},
+	{vFppiipppiiiii, "vFppiipppiiiii"},
+	{vFpppiiiiiiiii, "vFpppiiiiiiiii"},
+	{vFpppppppppppp, "vFpppppppppppp"},
+	{iFEpppippppppp, "iFEpppippppppp"},
+	{iFEppppiiiiuui, "iFEppppiiiiuui"},
+	{iFpipppppppppp, "iFpipppppppppp"},
+	{iFpppiiipppppp, "iFpppiiipppppp"},
+	{iFpppllipppppp, "iFpppllipppppp"},
+	{iFpppppppppppp, "iFpppppppppppp"},
+	{lFpLpppppppppp, "lFpLpppppppppp"},
+	{pFEppiiuuuipii, "pFEppiiuuuipii"},
+	{pFEppuuuwwwwWW, "pFEppuuuwwwwWW"},
+	{pFEppuuuWWWCCi, "pFEppuuuWWWCCi"},
+	{pFWWiCCCCiipup, "pFWWiCCCCiipup"},
+	{pFppiiuuuiupup, "pFppiiuuuiupup"},
+	{pFpppppppppppp, "pFpppppppppppp"},
+	{vFEpppppppiippp, "vFEpppppppiippp"},
+	{vFuiiiiiiiiiuup, "vFuiiiiiiiiiuup"},
+	{vFuuuuuuuuuuuuu, "vFuuuuuuuuuuuuu"},
+	{vFuffffffffffff, "vFuffffffffffff"},
+	{vFpippppppppppp, "vFpippppppppppp"},
+	{vFpuppppppppppp, "vFpuppppppppppp"},
+	{vFppiiiiiiiiiii, "vFppiiiiiiiiiii"},
+	{vFppiipppiiiiii, "vFppiipppiiiiii"},
+	{vFppipppppppppp, "vFppipppppppppp"},
+	{vFppppppppppppp, "vFppppppppppppp"},
+	{iFddddpppddpppp, "iFddddpppddpppp"},
+	{iFpippuuuiipppp, "iFpippuuuiipppp"},
+	{iFpippppppppppp, "iFpippppppppppp"},
+	{iFpupiiiipppppp, "iFpupiiiipppppp"},
+	{iFpuppppppppppp, "iFpuppppppppppp"},
+	{iFppppppppppppp, "iFppppppppppppp"},
+	{pFppppppppppppp, "pFppppppppppppp"},
+	{vFuffiiffiiffiip, "vFuffiiffiiffiip"},
+	{vFuddiiddiiddiip, "vFuddiiddiiddiip"},
+	{vFppiipppiiiiiii, "vFppiipppiiiiiii"},
+	{vFpppppppppppppp, "vFpppppppppppppp"},
+	{iFpipppppppppppp, "iFpipppppppppppp"},
+	{iFpupppppppppppp, "iFpupppppppppppp"},
+	{iFpppppppppppppp, "iFpppppppppppppp"},
+	{pFEppCuuWWwwCCup, "pFEppCuuWWwwCCup"},
+	{pFEppuuuWWWWWWWW, "pFEppuuuWWWWWWWW"},
+	{pFpuupuupwwwwWWC, "pFpuupuupwwwwWWC"},
+	{vFuuiiiiuuiiiiiii, "vFuuiiiiuuiiiiiii"},
+	{vFfffffffffffffff, "vFfffffffffffffff"},
+	{vFppipppppppppppp, "vFppipppppppppppp"},
+	{vFpppippppppppppp, "vFpppippppppppppp"},
+	{vFppppppppppppppp, "vFppppppppppppppp"},
+	{pFEppCuuwwWWWWuup, "pFEppCuuwwWWWWuup"},
+	{pFpuiippppppppppp, "pFpuiippppppppppp"},
+	{pFppipppppppppppp, "pFppipppppppppppp"},
+	{pFppppppppppppppp, "pFppppppppppppppp"},
+	{vFpppppppppppppppp, "vFpppppppppppppppp"},
+	{iFpppppppppppppppp, "iFpppppppppppppppp"},
+	{uFpppppppppppppppp, "uFpppppppppppppppp"},
+	{pFippppppppppppppp, "pFippppppppppppppp"},
+	{pFppipipipipipipip, "pFppipipipipipipip"},
+	{vFppiiiiddddiiiiiuu, "vFppiiiiddddiiiiiuu"},
+	{iFppipipppppppppppp, "iFppipipppppppppppp"},
+	{iFpppippppppppppppp, "iFpppippppppppppppp"},
+	{pFppippipipipipipip, "pFppippipipipipipip"},
+	{vFppuiiiiipuiiiiiiii, "vFppuiiiiipuiiiiiiii"},
+	{vFpppipppppppppppppp, "vFpppipppppppppppppp"},
+	{LFpppppppppppppppppp, "LFpppppppppppppppppp"},
+	{pFippppppppppppppppp, "pFippppppppppppppppp"},
+	{vFpiiiiiiiiiiiiiiiiii, "vFpiiiiiiiiiiiiiiiiii"},
+	{iFpppippppppppppppppp, "iFpppippppppppppppppp"},
+	{pFEppuuuuuwwuuuuUUUup, "pFEppuuuuuwwuuuuUUUup"},
+	{pFiiiippppppppppppppp, "pFiiiippppppppppppppp"},
+	{pFipppppppppppppppppppppp, "pFipppppppppppppppppppppp"},
+	{iFpppppppppppppppppppppppppppppppppp, "iFpppppppppppppppppppppppppppppppppp"},
+#if defined(NOALIGN)
+	{IFpi, "IFpi"},
+	{dFpi, "dFpi"},
+	{iFppiiiip, "iFppiiiip"},
+#endif
+#if !defined(NOALIGN)
+	{iFEi, "iFEi"},
+	{dFEp, "dFEp"},
+	{iFEpI, "iFEpI"},
+	{iFEpd, "iFEpd"},
+	{IFEpi, "IFEpi"},
+	{dFEpi, "dFEpi"},
+	{iFEiiip, "iFEiiip"},
+	{iFEipii, "iFEipii"},
+	{iFEpppi, "iFEpppi"},
+	{iFEppiiiip, "iFEppiiiip"},
+#endif
+#if defined(HAVE_LD80BITS)
+	{DFD, "DFD"},
+	{DFDD, "DFDD"},
+	{DFDp, "DFDp"},
+	{DFppi, "DFppi"},
+	{DFppu, "DFppu"},
+	{DFppip, "DFppip"},
+	{iFDipppL, "iFDipppL"},
+	{vFppippDDC, "vFppippDDC"},
+#endif
+#if !defined(HAVE_LD80BITS)
+	{KFK, "KFK"},
+	{KFKK, "KFKK"},
+	{KFKp, "KFKp"},
+	{KFppi, "KFppi"},
+	{KFppu, "KFppu"},
+	{KFppip, "KFppip"},
+	{iFKipppL, "iFKipppL"},
+	{vFppippKKC, "vFppippKKC"},
+#endif
+	{iFEv, "iFEv"},
+	{pFEv, "pFEv"},
+	{iFEvpp, "iFEvpp"},
+	{UFVvvV, "UFVvvV"},
+	{iFEvppp, "iFEvppp"},
+	{iFEvpVV, "iFEvpVV"},
+	{iFEpvpp, "iFEpvpp"},
+	{iFEpvpVV, "iFEpvpVV"},
+	{iFEpvvppp, "iFEpvvppp"},
+	{iFEpvvpVV, "iFEpvvpVV"},
+	{pFpVvvvvV, "pFpVvvvvV"},
+	{iFEpuvvppp, "iFEpuvvppp"},
+	{iFEpuvvpVV, "iFEpuvvpVV"},
+	{NULL, NULL}
+};
+
+static int wrappersigs_sz = 0;
+static pthread_once_t wrappersigs_once = PTHREAD_ONCE_INIT;
+
+static int cmpWrapperSig(const void* a, const void* b)
+{
+	uintptr_t wa = (uintptr_t)((const wrappersig_t*)a)->w;
+	uintptr_t wb = (uintptr_t)((const wrappersig_t*)b)->w;
+	return (wa<wb)?-1:((wa>wb)?1:0);
+}
+
+// the addresses of the wrappers are only known at runtime, so the table is sorted on first use
+static void sortWrapperSigs()
+{
+	int n = 0;
+	while(wrappersigs[n].w)
+		++n;
+	qsort(wrappersigs, n, sizeof(wrappersig_t), cmpWrapperSig);
+	wrappersigs_sz = n;
+}
+
+const char* GetWrapperSignature(wrapper_t w)
+{
+	pthread_once(&wrappersigs_once, sortWrapperSigs);
+	wrappersig_t key = {w, NULL};
+	const wrappersig_t* r = (const wrappersig_t*)bsearch(&key, wrappersigs, wrappersigs_sz, sizeof(wrappersig_t), cmpWrapperSig);
+	return r?r->sig:NULL;
+}
@@ -1,5 +1,5 @@
 /*****************************************************************
- * File automatically generated by rebuild_wrappers.py (v1.2.0.09)
+ * File automatically generated by rebuild_wrappers.py (v1.2.0.10)
  *****************************************************************/
 #ifndef __WRAPPER_H_
 #define __WRAPPER_H_
@@ -1894,4 +1894,7 @@ void pFpVvvvvV(x86emu_t *emu, uintptr_t fnc);
 void iFEpuvvppp(x86emu_t *emu, uintptr_t fnc);
 void iFEpuvvpVV(x86emu_t *emu, uintptr_t fnc);
 
+// get the signature of a wrapper (like "iFpi"), NULL if not found
+const char* GetWrapperSignature(wrapper_t w);
+
 #endif //__WRAPPER_H_
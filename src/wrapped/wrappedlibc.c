@@ -1499,8 +1499,7 @@ EXPORT int32_t my___open(x86emu_t* emu, void* pathname, int32_t flags, uint32_t
 #ifdef DYNAREC
 static int hasDBFromAddress(uintptr_t addr)
 {
-    int idx = (addr>>DYNAMAP_SHIFT);
-    return my_context->dynmap[idx]?1:0;
+    return getDynmap(my_context, addr>>DYNAMAP_SHIFT)?1:0;
 }
 #endif
 
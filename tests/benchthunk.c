@@ -0,0 +1,56 @@
+/*
+** Call overhead of wrapped native functions with simple signatures.
+**
+** Run it with BOX86_DYNAREC_THUNKS=0 and then 1 to compare the generic
+** wrappers and the native thunks.
+**
+** To compile:  gcc -m32 -O2 -o benchthunk benchthunk.c
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define N   10000000
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec*1e9+ts.tv_nsec;
+}
+
+// called through volatile pointers, so the compiler doesn't use its builtins
+static int (*volatile p_abs)(int) = abs;
+static size_t (*volatile p_strlen)(const char*) = strlen;
+static void* (*volatile p_memchr)(const void*, int, size_t) = memchr;
+
+int main(int argc, const char** argv)
+{
+    const char* s = "box86";
+    int n = (argc>1)?atoi(argv[1]):N;
+    unsigned int r = 0;
+    double t0, t1;
+
+    t0 = now();
+    for(int i=0; i<n; ++i)
+        r += p_abs(-i);
+    t1 = now();
+    printf("abs     (iFi) : %.2fns per call\n", (t1-t0)/n);
+
+    t0 = now();
+    for(int i=0; i<n; ++i)
+        r += p_strlen(s);
+    t1 = now();
+    printf("strlen  (LFp) : %.2fns per call\n", (t1-t0)/n);
+
+    t0 = now();
+    for(int i=0; i<n; ++i)
+        r += (p_memchr(s, 'x', 5)!=NULL);
+    t1 = now();
+    printf("memchr (pFpiu): %.2fns per call\n", (t1-t0)/n);
+
+    printf("(%u)\n", r);
+    return 0;
+}
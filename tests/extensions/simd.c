@@ -0,0 +1,367 @@
+// Packed MMX / SSE integer and float operations, on a generated corpus: edge values then pseudo-random ones.
+// Each operation is run on all the pairs of inputs, and a hash of the results is printed, so any bit that
+// differs from a real x86 CPU shows. NaN are only used with MIN/MAX (the arithmetic ops can have a
+// different NaN payload on the host). The end checks a few cases explicitly: MIN/MAX of +0/-0, PSRAW/PSRAD
+// with big counts, and the MMX PAVGW.
+// Build with: gcc -m32 -O2 -mssse3 simd.c -o simd
+#include<stdint.h>
+#include<stdio.h>
+#include<string.h>
+#include<immintrin.h>
+
+typedef uint8_t u8;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
+#define NVEC 48
+
+static __m128i vi[NVEC];
+static __m128  vf[NVEC];
+static __m128d vd[NVEC];
+
+static u32 seed = 0x12345678;
+static u32 lcg()
+{
+	seed = seed*1664525 + 1013904223;
+	return seed;
+}
+
+static u32 hash(u32 h, const void* p, int n)
+{
+	for(int i=0; i<n; ++i)
+		h = (h ^ ((const u8*)p)[i]) * 16777619;
+	return h;
+}
+
+static void make_corpus()
+{
+	static const u32 edges[] = {0, 0xFFFFFFFF, 0x80808080, 0x7F7F7F7F, 0x80008000, 0x7FFF7FFF, 0x80000000, 0x7FFFFFFF,
+		0x00FF00FF, 0xFF00FF00, 0x01010101, 0xFEFEFEFE, 0x00010001, 0xFFFEFFFE, 0x55AA55AA, 0x12345678};
+	static const float fedges[] = {0.0f, -0.0f, 1.0f, -1.0f, 1.5f, -2.25f, 3.0e38f, -3.0e38f, 1.0e-37f, 0.1f, 1.0f/3.0f, 65536.0f};
+	static const double dedges[] = {0.0, -0.0, 1.0, -1.0, 1.5, -2.25, 1.0e308, -1.0e308, 1.0e-307, 0.1, 1.0/3.0, 4294967296.0};
+	for(int i=0; i<NVEC; ++i) {
+		u32 v[4];
+		float f[4];
+		double d[2];
+		for(int j=0; j<4; ++j) {
+			if(i<(int)ARRAY_SIZE(edges))
+				v[j] = (j&1)?edges[(i+j)%ARRAY_SIZE(edges)]:edges[i];
+			else
+				v[j] = lcg();
+			if(i<(int)ARRAY_SIZE(fedges))
+				f[j] = fedges[(i+j)%ARRAY_SIZE(fedges)];
+			else {
+				// built from the bits, so the FPU is not involved: 2^-31..2^32, no NaN or Inf
+				u32 r = lcg();
+				r = (r&0x807FFFFF) | ((0x60+((r>>23)&0x3F))<<23);
+				memcpy(&f[j], &r, 4);
+			}
+		}
+		for(int j=0; j<2; ++j) {
+			if(i<(int)ARRAY_SIZE(dedges))
+				d[j] = dedges[(i+j)%ARRAY_SIZE(dedges)];
+			else {
+				u64 r = lcg();
+				r = (r<<32) | lcg();
+				r = (r&0x800FFFFFFFFFFFFFULL) | ((u64)(0x3E0+((r>>52)&0x3F))<<52);
+				memcpy(&d[j], &r, 8);
+			}
+		}
+		memcpy(&vi[i], v, 16);
+		memcpy(&vf[i], f, 16);
+		memcpy(&vd[i], d, 16);
+	}
+}
+
+// SSE integer ops
+#define GO(N, E) static __m128i x_##N(__m128i a, __m128i b) { return E; }
+GO(paddb, _mm_add_epi8(a, b))
+GO(paddw, _mm_add_epi16(a, b))
+GO(paddd, _mm_add_epi32(a, b))
+GO(paddq, _mm_add_epi64(a, b))
+GO(paddsb, _mm_adds_epi8(a, b))
+GO(paddsw, _mm_adds_epi16(a, b))
+GO(paddusb, _mm_adds_epu8(a, b))
+GO(paddusw, _mm_adds_epu16(a, b))
+GO(psubb, _mm_sub_epi8(a, b))
+GO(psubw, _mm_sub_epi16(a, b))
+GO(psubd, _mm_sub_epi32(a, b))
+GO(psubq, _mm_sub_epi64(a, b))
+GO(psubsb, _mm_subs_epi8(a, b))
+GO(psubsw, _mm_subs_epi16(a, b))
+GO(psubusb, _mm_subs_epu8(a, b))
+GO(psubusw, _mm_subs_epu16(a, b))
+GO(pmullw, _mm_mullo_epi16(a, b))
+GO(pmulhw, _mm_mulhi_epi16(a, b))
+GO(pmulhuw, _mm_mulhi_epu16(a, b))
+GO(pmaddwd, _mm_madd_epi16(a, b))
+GO(pmuludq, _mm_mul_epu32(a, b))
+GO(pcmpeqb, _mm_cmpeq_epi8(a, b))
+GO(pcmpeqw, _mm_cmpeq_epi16(a, b))
+GO(pcmpeqd, _mm_cmpeq_epi32(a, b))
+GO(pcmpgtb, _mm_cmpgt_epi8(a, b))
+GO(pcmpgtw, _mm_cmpgt_epi16(a, b))
+GO(pcmpgtd, _mm_cmpgt_epi32(a, b))
+GO(pminub, _mm_min_epu8(a, b))
+GO(pmaxub, _mm_max_epu8(a, b))
+GO(pminsw, _mm_min_epi16(a, b))
+GO(pmaxsw, _mm_max_epi16(a, b))
+GO(pavgb, _mm_avg_epu8(a, b))
+GO(pavgw, _mm_avg_epu16(a, b))
+GO(pand, _mm_and_si128(a, b))
+GO(pandn, _mm_andnot_si128(a, b))
+GO(por, _mm_or_si128(a, b))
+GO(pxor, _mm_xor_si128(a, b))
+GO(psllw, _mm_sll_epi16(a, _mm_srli_epi64(b, 58)))
+GO(pslld, _mm_sll_epi32(a, _mm_srli_epi64(b, 58)))
+GO(psllq, _mm_sll_epi64(a, _mm_srli_epi64(b, 57)))
+GO(psrlw, _mm_srl_epi16(a, _mm_srli_epi64(b, 58)))
+GO(psrld, _mm_srl_epi32(a, _mm_srli_epi64(b, 58)))
+GO(psrlq, _mm_srl_epi64(a, _mm_srli_epi64(b, 57)))
+GO(psraw, _mm_sra_epi16(a, _mm_srli_epi64(b, 58)))
+GO(psrad, _mm_sra_epi32(a, _mm_srli_epi64(b, 58)))
+GO(psllw_i, _mm_xor_si128(_mm_slli_epi16(a, 3), _mm_slli_epi16(b, 15)))
+GO(pslld_i, _mm_xor_si128(_mm_slli_epi32(a, 7), _mm_slli_epi32(b, 31)))
+GO(psllq_i, _mm_xor_si128(_mm_slli_epi64(a, 13), _mm_slli_epi64(b, 63)))
+GO(psrlw_i, _mm_xor_si128(_mm_srli_epi16(a, 3), _mm_srli_epi16(b, 16)))
+GO(psrld_i, _mm_xor_si128(_mm_srli_epi32(a, 7), _mm_srli_epi32(b, 31)))
+GO(psrlq_i, _mm_xor_si128(_mm_srli_epi64(a, 13), _mm_srli_epi64(b, 64)))
+GO(psraw_i, _mm_xor_si128(_mm_srai_epi16(a, 3), _mm_srai_epi16(b, 15)))
+GO(psrad_i, _mm_xor_si128(_mm_srai_epi32(a, 7), _mm_srai_epi32(b, 31)))
+GO(pslldq, _mm_xor_si128(_mm_slli_si128(a, 3), _mm_slli_si128(b, 15)))
+GO(psrldq, _mm_xor_si128(_mm_srli_si128(a, 5), _mm_srli_si128(b, 16)))
+GO(punpcklbw, _mm_unpacklo_epi8(a, b))
+GO(punpcklwd, _mm_unpacklo_epi16(a, b))
+GO(punpckldq, _mm_unpacklo_epi32(a, b))
+GO(punpcklqdq, _mm_unpacklo_epi64(a, b))
+GO(punpckhbw, _mm_unpackhi_epi8(a, b))
+GO(punpckhwd, _mm_unpackhi_epi16(a, b))
+GO(punpckhdq, _mm_unpackhi_epi32(a, b))
+GO(punpckhqdq, _mm_unpackhi_epi64(a, b))
+GO(packsswb, _mm_packs_epi16(a, b))
+GO(packssdw, _mm_packs_epi32(a, b))
+GO(packuswb, _mm_packus_epi16(a, b))
+GO(pshufb, _mm_shuffle_epi8(a, b))
+GO(pshufd, _mm_xor_si128(_mm_shuffle_epi32(a, 0x1B), _mm_shuffle_epi32(b, 0x4E)))
+GO(pshuflw, _mm_xor_si128(_mm_shufflelo_epi16(a, 0x1B), _mm_shufflelo_epi16(b, 0x39)))
+GO(pshufhw, _mm_xor_si128(_mm_shufflehi_epi16(a, 0x1B), _mm_shufflehi_epi16(b, 0x39)))
+#undef GO
+typedef struct { const char* name; __m128i (*f)(__m128i, __m128i); } xtest_t;
+#define GO(N) {#N, x_##N},
+static const xtest_t xtests[] = {
+	GO(paddb) GO(paddw) GO(paddd) GO(paddq) GO(paddsb) GO(paddsw) GO(paddusb) GO(paddusw)
+	GO(psubb) GO(psubw) GO(psubd) GO(psubq) GO(psubsb) GO(psubsw) GO(psubusb) GO(psubusw)
+	GO(pmullw) GO(pmulhw) GO(pmulhuw) GO(pmaddwd) GO(pmuludq)
+	GO(pcmpeqb) GO(pcmpeqw) GO(pcmpeqd) GO(pcmpgtb) GO(pcmpgtw) GO(pcmpgtd)
+	GO(pminub) GO(pmaxub) GO(pminsw) GO(pmaxsw) GO(pavgb) GO(pavgw)
+	GO(pand) GO(pandn) GO(por) GO(pxor)
+	GO(psllw) GO(pslld) GO(psllq) GO(psrlw) GO(psrld) GO(psrlq) GO(psraw) GO(psrad)
+	GO(psllw_i) GO(pslld_i) GO(psllq_i) GO(psrlw_i) GO(psrld_i) GO(psrlq_i) GO(psraw_i) GO(psrad_i) GO(pslldq) GO(psrldq)
+	GO(punpcklbw) GO(punpcklwd) GO(punpckldq) GO(punpcklqdq) GO(punpckhbw) GO(punpckhwd) GO(punpckhdq) GO(punpckhqdq)
+	GO(packsswb) GO(packssdw) GO(packuswb) GO(pshufb) GO(pshufd) GO(pshuflw) GO(pshufhw)
+};
+#undef GO
+
+// MMX ops
+#define GO(N, E) static __m64 m_##N(__m64 a, __m64 b) { return E; }
+GO(paddb, _mm_add_pi8(a, b))
+GO(paddw, _mm_add_pi16(a, b))
+GO(paddd, _mm_add_pi32(a, b))
+GO(paddsb, _mm_adds_pi8(a, b))
+GO(paddsw, _mm_adds_pi16(a, b))
+GO(paddusb, _mm_adds_pu8(a, b))
+GO(paddusw, _mm_adds_pu16(a, b))
+GO(psubb, _mm_sub_pi8(a, b))
+GO(psubw, _mm_sub_pi16(a, b))
+GO(psubd, _mm_sub_pi32(a, b))
+GO(psubsb, _mm_subs_pi8(a, b))
+GO(psubsw, _mm_subs_pi16(a, b))
+GO(psubusb, _mm_subs_pu8(a, b))
+GO(psubusw, _mm_subs_pu16(a, b))
+GO(pmullw, _mm_mullo_pi16(a, b))
+GO(pmulhw, _mm_mulhi_pi16(a, b))
+GO(pmulhuw, _mm_mulhi_pu16(a, b))
+GO(pmaddwd, _mm_madd_pi16(a, b))
+GO(pcmpeqb, _mm_cmpeq_pi8(a, b))
+GO(pcmpeqw, _mm_cmpeq_pi16(a, b))
+GO(pcmpeqd, _mm_cmpeq_pi32(a, b))
+GO(pcmpgtb, _mm_cmpgt_pi8(a, b))
+GO(pcmpgtw, _mm_cmpgt_pi16(a, b))
+GO(pcmpgtd, _mm_cmpgt_pi32(a, b))
+GO(pminub, _mm_min_pu8(a, b))
+GO(pmaxub, _mm_max_pu8(a, b))
+GO(pminsw, _mm_min_pi16(a, b))
+GO(pmaxsw, _mm_max_pi16(a, b))
+GO(pavgb, _mm_avg_pu8(a, b))
+GO(pavgw, _mm_avg_pu16(a, b))
+GO(psraw, _mm_sra_pi16(a, _mm_srli_si64(b, 58)))
+GO(psrad, _mm_sra_pi32(a, _mm_srli_si64(b, 58)))
+GO(psrlq, _mm_srl_si64(a, _mm_srli_si64(b, 57)))
+GO(psllq, _mm_sll_si64(a, _mm_srli_si64(b, 57)))
+GO(punpcklbw, _mm_unpacklo_pi8(a, b))
+GO(punpckhwd, _mm_unpackhi_pi16(a, b))
+GO(packsswb, _mm_packs_pi16(a, b))
+GO(packssdw, _mm_packs_pi32(a, b))
+GO(packuswb, _mm_packs_pu16(a, b))
+GO(pshufw, _mm_xor_si64(_mm_shuffle_pi16(a, 0x1B), _mm_shuffle_pi16(b, 0x39)))
+#undef GO
+typedef struct { const char* name; __m64 (*f)(__m64, __m64); } mtest_t;
+#define GO(N) {#N, m_##N},
+static const mtest_t mtests[] = {
+	GO(paddb) GO(paddw) GO(paddd) GO(paddsb) GO(paddsw) GO(paddusb) GO(paddusw)
+	GO(psubb) GO(psubw) GO(psubd) GO(psubsb) GO(psubsw) GO(psubusb) GO(psubusw)
+	GO(pmullw) GO(pmulhw) GO(pmulhuw) GO(pmaddwd)
+	GO(pcmpeqb) GO(pcmpeqw) GO(pcmpeqd) GO(pcmpgtb) GO(pcmpgtw) GO(pcmpgtd)
+	GO(pminub) GO(pmaxub) GO(pminsw) GO(pmaxsw) GO(pavgb) GO(pavgw)
+	GO(psraw) GO(psrad) GO(psrlq) GO(psllq)
+	GO(punpcklbw) GO(punpckhwd) GO(packsswb) GO(packssdw) GO(packuswb) GO(pshufw)
+};
+#undef GO
+
+// float ops
+#define GO(N, E) static __m128 f_##N(__m128 a, __m128 b) { return E; }
+GO(addps, _mm_add_ps(a, b))
+GO(subps, _mm_sub_ps(a, b))
+GO(mulps, _mm_mul_ps(a, b))
+GO(divps, _mm_div_ps(a, b))
+GO(minps, _mm_min_ps(a, b))
+GO(maxps, _mm_max_ps(a, b))
+GO(shufps, _mm_shuffle_ps(a, b, 0x4E))
+GO(unpcklps, _mm_unpacklo_ps(a, b))
+GO(unpckhps, _mm_unpackhi_ps(a, b))
+#undef GO
+typedef struct { const char* name; __m128 (*f)(__m128, __m128); } ftest_t;
+#define GO(N) {#N, f_##N},
+static const ftest_t ftests[] = {
+	GO(addps) GO(subps) GO(mulps) GO(divps) GO(minps) GO(maxps) GO(shufps) GO(unpcklps) GO(unpckhps)
+};
+#undef GO
+#define GO(N, E) static __m128d d_##N(__m128d a, __m128d b) { return E; }
+GO(addpd, _mm_add_pd(a, b))
+GO(subpd, _mm_sub_pd(a, b))
+GO(mulpd, _mm_mul_pd(a, b))
+GO(divpd, _mm_div_pd(a, b))
+GO(minpd, _mm_min_pd(a, b))
+GO(maxpd, _mm_max_pd(a, b))
+#undef GO
+typedef struct { const char* name; __m128d (*f)(__m128d, __m128d); } dtest_t;
+#define GO(N) {#N, d_##N},
+static const dtest_t dtests[] = {
+	GO(addpd) GO(subpd) GO(mulpd) GO(divpd) GO(minpd) GO(maxpd)
+};
+#undef GO
+
+// hide the constants from the compiler, so the instructions are really run
+static __m128 opaque_ps(__m128 v) { __asm__ __volatile__("" : "+x"(v)); return v; }
+static __m128d opaque_pd(__m128d v) { __asm__ __volatile__("" : "+x"(v)); return v; }
+static __m128i opaque_epi(__m128i v) { __asm__ __volatile__("" : "+x"(v)); return v; }
+static __m64 opaque_pi(__m64 v) { __asm__ __volatile__("" : "+y"(v)); return v; }
+
+static void print_ps(const char* name, __m128 r)
+{
+	u32 v[4];
+	memcpy(v, &r, 16);
+	printf("%s: %08x %08x %08x %08x\n", name, v[0], v[1], v[2], v[3]);
+}
+
+static void print_pd(const char* name, __m128d r)
+{
+	u64 v[2];
+	memcpy(v, &r, 16);
+	printf("%s: %016llx %016llx\n", name, (unsigned long long)v[0], (unsigned long long)v[1]);
+}
+
+static void print_epi(const char* name, __m128i r)
+{
+	u32 v[4];
+	memcpy(v, &r, 16);
+	printf("%s: %08x %08x %08x %08x\n", name, v[0], v[1], v[2], v[3]);
+}
+
+int main()
+{
+	make_corpus();
+	for(size_t t=0; t<ARRAY_SIZE(xtests); ++t) {
+		u32 h = 2166136261u;
+		for(int i=0; i<NVEC; ++i)
+			for(int j=0; j<NVEC; ++j) {
+				__m128i r = xtests[t].f(vi[i], vi[j]);
+				h = hash(h, &r, 16);
+			}
+		printf("sse %s: %08x\n", xtests[t].name, h);
+	}
+	for(size_t t=0; t<ARRAY_SIZE(mtests); ++t) {
+		u32 h = 2166136261u;
+		for(int i=0; i<NVEC; ++i)
+			for(int j=0; j<NVEC; ++j) {
+				__m64 a, b, r;
+				memcpy(&a, &vi[i], 8);
+				memcpy(&b, ((u8*)&vi[j])+8, 8);
+				r = mtests[t].f(a, b);
+				h = hash(h, &r, 8);
+			}
+		_mm_empty();
+		printf("mmx %s: %08x\n", mtests[t].name, h);
+	}
+	for(size_t t=0; t<ARRAY_SIZE(ftests); ++t) {
+		u32 h = 2166136261u;
+		for(int i=0; i<NVEC; ++i)
+			for(int j=0; j<NVEC; ++j) {
+				__m128 r = ftests[t].f(vf[i], vf[j]);
+				h = hash(h, &r, 16);
+			}
+		printf("sse %s: %08x\n", ftests[t].name, h);
+	}
+	for(size_t t=0; t<ARRAY_SIZE(dtests); ++t) {
+		u32 h = 2166136261u;
+		for(int i=0; i<NVEC; ++i)
+			for(int j=0; j<NVEC; ++j) {
+				__m128d r = dtests[t].f(vd[i], vd[j]);
+				h = hash(h, &r, 16);
+			}
+		printf("sse %s: %08x\n", dtests[t].name, h);
+	}
+
+	// MIN/MAX: the 2nd operand when equal (+0/-0) or when one is a NaN
+	__m128 fa = opaque_ps(_mm_set_ps(__builtin_nanf(""), 1.0f, -0.0f, 0.0f));
+	__m128 fb = opaque_ps(_mm_set_ps(2.0f, __builtin_nanf(""), 0.0f, -0.0f));
+	print_ps("minps", f_minps(fa, fb));
+	print_ps("maxps", f_maxps(fa, fb));
+	print_ps("minps rev", f_minps(fb, fa));
+	print_ps("maxps rev", f_maxps(fb, fa));
+	__m128d da = opaque_pd(_mm_set_pd(-0.0, 0.0));
+	__m128d db = opaque_pd(_mm_set_pd(0.0, -0.0));
+	print_pd("minpd", d_minpd(da, db));
+	print_pd("maxpd", d_maxpd(da, db));
+	da = opaque_pd(_mm_set_pd(__builtin_nan(""), 1.0));
+	db = opaque_pd(_mm_set_pd(1.0, __builtin_nan("")));
+	print_pd("minpd nan", d_minpd(da, db));
+	print_pd("maxpd nan", d_maxpd(da, db));
+
+	// PSRAW/PSRAD: counts over 15/31 fill with the sign bit
+	__m128i s = opaque_epi(_mm_set_epi32(0x80000000, 0x7FFFFFFF, 0x80004000, 0x40008000));
+	static const int counts[] = {15, 16, 17, 31, 32, 33, 255, 256};
+	for(size_t i=0; i<ARRAY_SIZE(counts); ++i) {
+		char name[32];
+		__m128i c = opaque_epi(_mm_cvtsi32_si128(counts[i]));
+		sprintf(name, "psraw %d", counts[i]);
+		print_epi(name, _mm_sra_epi16(s, c));
+		sprintf(name, "psrad %d", counts[i]);
+		print_epi(name, _mm_sra_epi32(s, c));
+		__m64 m = _mm_sra_pi16(opaque_pi(_mm_set_pi32(0x80004000, 0x40008000)), opaque_pi(_mm_cvtsi32_si64(counts[i])));
+		__m64 m2 = _mm_sra_pi32(opaque_pi(_mm_set_pi32(0x80000000, 0x7FFFFFFF)), opaque_pi(_mm_cvtsi32_si64(counts[i])));
+		printf("mmx psraw/psrad %d: %08x %08x / %08x %08x\n", counts[i], _mm_cvtsi64_si32(m), _mm_cvtsi64_si32(_mm_srli_si64(m, 32)),
+			_mm_cvtsi64_si32(m2), _mm_cvtsi64_si32(_mm_srli_si64(m2, 32)));
+		_mm_empty();
+	}
+
+	// MMX PAVGW (0F E3)
+	__m64 pa = opaque_pi(_mm_set_pi16(0xFFFF, 0x0000, 0x8000, 0x0001));
+	__m64 pb = opaque_pi(_mm_set_pi16(0xFFFF, 0x0001, 0x7FFF, 0x0002));
+	__m64 pr = _mm_avg_pu16(pa, pb);
+	printf("mmx pavgw: %08x %08x\n", _mm_cvtsi64_si32(pr), _mm_cvtsi64_si32(_mm_srli_si64(pr, 32)));
+	_mm_empty();
+
+	return 0;
+}
@@ -0,0 +1,73 @@
+// LOCK'd operations from several threads, on aligned counters and on counters crossing a cache line
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define NUMTHREADS  4
+#define LOOPS       5000
+
+typedef struct {
+    const char* name;
+    volatile uint32_t* d;   // 32bits counter
+    volatile uint8_t*  b;   // 8bits counter
+} counters_t;
+
+static uint8_t mem[256] __attribute__((aligned(64)));
+static counters_t counters[2];
+static volatile uint32_t spin = 0;
+static uint32_t plain = 0;
+
+static void* thread_run(void* arg)
+{
+    counters_t* c = (counters_t*)arg;
+    for(int i=0; i<LOOPS; ++i) {
+        uint32_t v, old;
+        // LOCK ADD / LOCK INC
+        __asm__ __volatile__("lock addl %1, %0" : "+m"(*c->d) : "ir"(2) : "memory", "cc");
+        __asm__ __volatile__("lock incb %0" : "+m"(*c->b) : : "memory", "cc");
+        // LOCK XADD
+        v = 1;
+        __asm__ __volatile__("lock xaddl %0, %1" : "+r"(v), "+m"(*c->d) : : "memory", "cc");
+        // LOCK CMPXCHG loop
+        do {
+            old = *c->d;
+            v = old;
+            __asm__ __volatile__("lock cmpxchgl %2, %1" : "+a"(v), "+m"(*c->d) : "r"(old+3) : "memory", "cc");
+        } while(v!=old);
+        // LOCK SUB
+        __asm__ __volatile__("lock subl %1, %0" : "+m"(*c->d) : "ir"(1) : "memory", "cc");
+        // LOCK ADC / LOCK SBB with the carry set (a retry must use that carry)
+        __asm__ __volatile__("stc\n\tlock adcl %1, %0" : "+m"(*c->d) : "ir"(1) : "memory", "cc");
+        __asm__ __volatile__("stc\n\tlock sbbl %1, %0" : "+m"(*c->d) : "ir"(0) : "memory", "cc");
+        // XCHG spinlock around a plain counter (XCHG with memory is always locked)
+        do {
+            v = 1;
+            __asm__ __volatile__("xchgl %0, %1" : "+r"(v), "+m"(spin) : : "memory");
+        } while(v);
+        ++plain;
+        __asm__ __volatile__("movl $0, %0" : "=m"(spin) : : "memory");
+    }
+    return NULL;
+}
+
+int main()
+{
+    pthread_t threads[NUMTHREADS];
+    counters[0].name = "aligned";
+    counters[0].d = (volatile uint32_t*)(mem+64);
+    counters[0].b = mem+72;
+    counters[1].name = "cache line crossing";
+    counters[1].d = (volatile uint32_t*)(mem+126);   // 2 bytes on each side of the 128 boundary
+    counters[1].b = mem+192;
+    for(int c=0; c<2; ++c) {
+        *counters[c].d = 0;
+        *counters[c].b = 0;
+        plain = 0;
+        for(int i=0; i<NUMTHREADS; ++i)
+            pthread_create(&threads[i], NULL, thread_run, &counters[c]);
+        for(int i=0; i<NUMTHREADS; ++i)
+            pthread_join(threads[i], NULL);
+        printf("%s: dword=%u byte=%u xchg=%u\n", counters[c].name, *counters[c].d, *counters[c].b, plain);
+    }
+    return 0;
+}